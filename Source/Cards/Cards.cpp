@@ -1,12 +1,10 @@
 #include "Cards.h"
 #include <iostream>
 #include <string>
-#include <chrono>
-#include <ctime>
-#include <random>
 
 #include "Order/Orders.h"
 #include "Common/CommonTypes.h"
+#include "Common/GameRandom.h"
 
 using namespace std; 
 
@@ -123,9 +121,11 @@ Deck::Deck(const Deck& aDeck)
 
 	deckSize = deck.size();
 	currentCard = 0;
+	_random = aDeck._random;
 }
 
-Deck::Deck(int someCards)
+Deck::Deck(int someCards, RandomStream* inRandom)
+	: _random(inRandom)
 {	
 	/* Deck must be multiple of 5 or not empty due to the nature of the card types */
 	while (someCards == 0 || someCards % 5 != 0 ) {
@@ -178,10 +178,8 @@ Deck::Deck(int someCards)
 
 /* Shuffle method */
 void Deck::ShuffleDeck() {
-	auto randomClock = std::chrono::high_resolution_clock::now();
-	auto seed = randomClock.time_since_epoch().count();
-	auto randomizer = std::default_random_engine(seed);
-	std::shuffle(deck.begin(), deck.end(), randomizer);
+	RandomStream& random = (_random != nullptr) ? *_random : GameRandom::getFallback().getStream(ERandomStream::Deck);
+	random.shuffle(deck.begin(), deck.end());
 }
 
 /* Draw method */
@@ -216,6 +214,16 @@ void Deck::showDeck() {
 	}
 }
 
+const std::vector<Card*>& Deck::getCards() const
+{
+	return deck;
+}
+
+void Deck::setRandomStream(RandomStream* inRandom)
+{
+	_random = inRandom;
+}
+
 Deck::~Deck()
 {
 	for (auto& i : deck) {
@@ -11,6 +11,7 @@
 
 enum class EOrderType;
 enum class ECardTypes;
+class RandomStream;
 
 class Card {
 
@@ -52,7 +53,8 @@ public:
 
 	/* ctors */
 	Deck();
-	Deck(int);
+	// inRandom shuffles the deck, a stream of its own is used when it is null
+	Deck(int, RandomStream* inRandom = nullptr);
 	Deck(const Deck& aDeck);
 	~Deck();
 
@@ -74,10 +76,17 @@ public:
 	/* Show the deck method */
 	void showDeck(); 
 
+	/* Cards left, the next one drawn is the last */
+	const std::vector<Card*>& getCards() const;
+
+	/* Stream shuffling the deck, nullptr uses a stream of its own */
+	void setRandomStream(RandomStream* inRandom);
+
 private:
 	std::vector<Card*> deck;
 	int currentCard; /* not sure if i need this later */
 	int deckSize;	 
+	RandomStream* _random = nullptr;
 };
 
 /* Hand Class */
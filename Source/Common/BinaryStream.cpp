@@ -0,0 +1,229 @@
+#include "BinaryStream.h"
+
+#include <cstring>
+
+namespace
+{
+	// a var int of 64 bits takes at most 10 bytes
+	constexpr std::size_t MaxVarIntBytes = 10;
+	// a zigzagged 32 bit value takes at most 5
+	constexpr std::size_t MaxVarInt32Bytes = 5;
+
+	uint64 zigzag(int64 inValue)
+	{
+		return (static_cast<uint64>(inValue) << 1) ^ static_cast<uint64>(inValue >> 63);
+	}
+
+	int64 unzigzag(uint64 inValue)
+	{
+		return static_cast<int64>(inValue >> 1) ^ -static_cast<int64>(inValue & 1);
+	}
+
+	// writes inValue at outBytes and returns the number of bytes used
+	std::size_t encodeVarUInt(uint64 inValue, char* outBytes)
+	{
+		std::size_t count = 0;
+		while (inValue >= 0x80)
+		{
+			outBytes[count++] = static_cast<char>((inValue & 0x7F) | 0x80);
+			inValue >>= 7;
+		}
+		outBytes[count++] = static_cast<char>(inValue);
+		return count;
+	}
+}
+
+BinaryWriter::BinaryWriter(std::vector<char>& outBuffer)
+	: _buffer(outBuffer)
+{
+}
+
+void BinaryWriter::writeUInt8(uint8 inValue)
+{
+	_buffer.push_back(static_cast<char>(inValue));
+}
+
+void BinaryWriter::writeUInt32(uint32 inValue)
+{
+	writeBytes(&inValue, sizeof(inValue));
+}
+
+void BinaryWriter::writeUInt64(uint64 inValue)
+{
+	writeBytes(&inValue, sizeof(inValue));
+}
+
+void BinaryWriter::writeVarUInt(uint64 inValue)
+{
+	char bytes[MaxVarIntBytes];
+	const std::size_t count = encodeVarUInt(inValue, bytes);
+	_buffer.insert(_buffer.end(), bytes, bytes + count);
+}
+
+void BinaryWriter::writeVarInt(int64 inValue)
+{
+	writeVarUInt(zigzag(inValue));
+}
+
+void BinaryWriter::writeString(std::string_view inValue)
+{
+	writeVarUInt(inValue.size());
+	writeBytes(inValue.data(), inValue.size());
+}
+
+void BinaryWriter::writeBytes(const void* inData, std::size_t inSize)
+{
+	const char* bytes = static_cast<const char*>(inData);
+	_buffer.insert(_buffer.end(), bytes, bytes + inSize);
+}
+
+void BinaryWriter::writeVarIntArray(const int32* inValues, std::size_t inCount, bool bInDelta)
+{
+	// encoded straight into the buffer, it is grown once for the worst case and cut back after
+	const std::size_t start = _buffer.size();
+	_buffer.resize(start + inCount * MaxVarInt32Bytes);
+	char* out = _buffer.data() + start;
+
+	int64 previous = 0;
+	for (std::size_t i = 0; i < inCount; i++)
+	{
+		const int64 value = inValues[i];
+		out += encodeVarUInt(zigzag(bInDelta ? value - previous : value), out);
+		previous = value;
+	}
+	_buffer.resize(out - _buffer.data());
+}
+
+std::size_t BinaryWriter::getSize() const
+{
+	return _buffer.size();
+}
+
+BinaryReader::BinaryReader(const char* inData, std::size_t inSize)
+	: _data(inData)
+	, _size(inSize)
+{
+}
+
+bool BinaryReader::fail()
+{
+	bIsValid = false;
+	_position = _size;
+	return false;
+}
+
+uint8 BinaryReader::readUInt8()
+{
+	if (_position >= _size)
+	{
+		fail();
+		return 0;
+	}
+	return static_cast<uint8>(_data[_position++]);
+}
+
+uint32 BinaryReader::readUInt32()
+{
+	uint32 value = 0;
+	readBytes(&value, sizeof(value));
+	return value;
+}
+
+uint64 BinaryReader::readUInt64()
+{
+	uint64 value = 0;
+	readBytes(&value, sizeof(value));
+	return value;
+}
+
+uint64 BinaryReader::readVarUInt()
+{
+	uint64 value = 0;
+	for (uint32 shift = 0; shift < 64; shift += 7)
+	{
+		if (_position >= _size)
+		{
+			fail();
+			return 0;
+		}
+		const uint8 byte = static_cast<uint8>(_data[_position++]);
+		value |= static_cast<uint64>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			return value;
+		}
+	}
+	// more than 10 bytes is not a var int a writer makes
+	fail();
+	return 0;
+}
+
+int64 BinaryReader::readVarInt()
+{
+	return unzigzag(readVarUInt());
+}
+
+std::string BinaryReader::readString()
+{
+	const std::size_t length = readCount(getRemaining());
+	std::string value(length, '\0');
+	readBytes(value.data(), length);
+	return value;
+}
+
+bool BinaryReader::readBytes(void* outData, std::size_t inSize)
+{
+	if (inSize > getRemaining())
+	{
+		return fail();
+	}
+	if (inSize > 0)
+	{
+		std::memcpy(outData, _data + _position, inSize);
+	}
+	_position += inSize;
+	return true;
+}
+
+bool BinaryReader::readVarIntArray(int32* outValues, std::size_t inCount, bool bInDelta)
+{
+	int64 previous = 0;
+	for (std::size_t i = 0; i < inCount; i++)
+	{
+		const int64 value = bInDelta ? previous + readVarInt() : readVarInt();
+		outValues[i] = static_cast<int32>(value);
+		previous = value;
+	}
+	return bIsValid;
+}
+
+std::size_t BinaryReader::readCount(std::size_t inMax)
+{
+	const uint64 count = readVarUInt();
+	if (count > inMax)
+	{
+		fail();
+		return 0;
+	}
+	return static_cast<std::size_t>(count);
+}
+
+bool BinaryReader::isValid() const
+{
+	return bIsValid;
+}
+
+bool BinaryReader::isAtEnd() const
+{
+	return _position >= _size;
+}
+
+std::size_t BinaryReader::getPosition() const
+{
+	return _position;
+}
+
+std::size_t BinaryReader::getRemaining() const
+{
+	return _size - _position;
+}
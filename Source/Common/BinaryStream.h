@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CommonTypes.h"
+
+// written to the header of the binary files in the byte order of the machine that made them,
+// a loader that reads SwappedByteOrderMark back is on a machine of the other byte order
+constexpr uint16 ByteOrderMark = 0xFEFF;
+constexpr uint16 SwappedByteOrderMark = 0xFFFE;
+
+/*
+	Summary: Appends values to a byte buffer in a compact binary form.
+	Fixed size values are stored in the byte order of the machine, like the .wzmap tables,
+	the files made of them carry ByteOrderMark in their header. Var ints take 7 bits per byte,
+	signed ones are zigzagged first so small negative values stay small.
+*/
+class BinaryWriter {
+public:
+	// values are appended to outBuffer, which has to outlive the writer
+	explicit BinaryWriter(std::vector<char>& outBuffer);
+
+	void writeUInt8(uint8 inValue);
+	void writeUInt32(uint32 inValue);
+	void writeUInt64(uint64 inValue);
+	void writeVarUInt(uint64 inValue);
+	void writeVarInt(int64 inValue);
+	// length then bytes
+	void writeString(std::string_view inValue);
+	void writeBytes(const void* inData, std::size_t inSize);
+	// inCount signed var ints in one go. With bInDelta each value is stored as its difference
+	// with the one before, which keeps rising sequences to a byte or two per value.
+	void writeVarIntArray(const int32* inValues, std::size_t inCount, bool bInDelta = false);
+
+	std::size_t getSize() const;
+
+private:
+	std::vector<char>& _buffer;
+};
+
+/*
+	Summary: Reads back what a BinaryWriter wrote.
+	A read past the end or a malformed var int marks the reader as failed and returns 0,
+	so a whole block can be read before checking isValid once.
+*/
+class BinaryReader {
+public:
+	// inData has to stay valid while the reader is used
+	BinaryReader(const char* inData, std::size_t inSize);
+
+	uint8 readUInt8();
+	uint32 readUInt32();
+	uint64 readUInt64();
+	uint64 readVarUInt();
+	int64 readVarInt();
+	std::string readString();
+	bool readBytes(void* outData, std::size_t inSize);
+	// inCount values written by writeVarIntArray with the same bInDelta
+	bool readVarIntArray(int32* outValues, std::size_t inCount, bool bInDelta = false);
+	// a count read from the data, failed when it is above inMax, which keeps corrupt counts from allocating
+	std::size_t readCount(std::size_t inMax);
+
+	bool isValid() const;
+	bool isAtEnd() const;
+	std::size_t getPosition() const;
+	std::size_t getRemaining() const;
+
+private:
+	bool fail();
+
+	const char* _data = nullptr;
+	std::size_t _size = 0;
+	std::size_t _position = 0;
+	bool bIsValid = true;
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "CommonTypes.h"
+
+/*
+	Summary: Fixed size set of bits packed in 64 bit words, sized at runtime.
+*/
+class BitSet {
+public:
+	BitSet() {}
+	explicit BitSet(std::size_t inSize) { resize(inSize); }
+
+	// resizes and clears every bit
+	void resize(std::size_t inSize)
+	{
+		_size = inSize;
+		_words.assign((inSize + 63) / 64, 0);
+	}
+
+	void clear() { _words.assign(_words.size(), 0); }
+
+	bool test(std::size_t inPosition) const { return (_words[inPosition >> 6] >> (inPosition & 63)) & 1ULL; }
+	void set(std::size_t inPosition) { _words[inPosition >> 6] |= 1ULL << (inPosition & 63); }
+	void reset(std::size_t inPosition) { _words[inPosition >> 6] &= ~(1ULL << (inPosition & 63)); }
+
+	std::size_t size() const { return _size; }
+
+private:
+	std::size_t _size = 0;
+	std::vector<uint64> _words;
+};
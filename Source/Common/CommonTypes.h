@@ -16,5 +16,9 @@ enum class EPlayerTurnPhase {
 	EndOfTurn
 };
 
+typedef unsigned char uint8;
+typedef unsigned short uint16;
 typedef signed int int32;
-typedef unsigned int uint32;
\ No newline at end of file
+typedef unsigned int uint32;
+typedef signed long long int64;
+typedef unsigned long long uint64;
\ No newline at end of file
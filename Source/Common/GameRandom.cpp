@@ -0,0 +1,151 @@
+#include "GameRandom.h"
+
+#include <chrono>
+#include <random>
+
+namespace
+{
+	constexpr uint64 PcgMultiplier = 6364136223846793005ull;
+
+	// SplitMix64 finaliser, spreads every bit of the input over the whole result
+	uint64 mix(uint64 inValue)
+	{
+		inValue += 0x9E3779B97F4A7C15ull;
+		inValue = (inValue ^ (inValue >> 30)) * 0xBF58476D1CE4E5B9ull;
+		inValue = (inValue ^ (inValue >> 27)) * 0x94D049BB133111EBull;
+		return inValue ^ (inValue >> 31);
+	}
+}
+
+RandomStream::RandomStream()
+{
+	seed(0, 0);
+}
+
+RandomStream::RandomStream(uint64 inSeed, uint64 inStream)
+{
+	seed(inSeed, inStream);
+}
+
+void RandomStream::seed(uint64 inSeed, uint64 inStream)
+{
+	// the increment picks the stream and has to be odd
+	_state = 0;
+	_increment = (inStream << 1) | 1;
+	(*this)();
+	_state += inSeed;
+	(*this)();
+}
+
+RandomStream::result_type RandomStream::operator()()
+{
+	const uint64 previous = _state;
+	_state = previous * PcgMultiplier + _increment;
+	// output permutation: xorshift the high bits down, then rotate by the top 5 bits
+	const uint32 shifted = static_cast<uint32>(((previous >> 18) ^ previous) >> 27);
+	const uint32 rotation = static_cast<uint32>(previous >> 59);
+	return (shifted >> rotation) | (shifted << ((0u - rotation) & 31));
+}
+
+uint32 RandomStream::nextBelow(uint32 inBound)
+{
+	if (inBound == 0)
+	{
+		return 0;
+	}
+
+	// Lemire's multiply and shift, the few values that would favour small results are drawn again
+	uint64 product = static_cast<uint64>((*this)()) * inBound;
+	uint32 low = static_cast<uint32>(product);
+	if (low < inBound)
+	{
+		const uint32 threshold = (0u - inBound) % inBound;
+		while (low < threshold)
+		{
+			product = static_cast<uint64>((*this)()) * inBound;
+			low = static_cast<uint32>(product);
+		}
+	}
+	return static_cast<uint32>(product >> 32);
+}
+
+int32 RandomStream::nextInRange(int32 inLow, int32 inHigh)
+{
+	if (inHigh <= inLow)
+	{
+		return inLow;
+	}
+	const uint32 span = static_cast<uint32>(inHigh) - static_cast<uint32>(inLow) + 1;
+	// a span of 0 is the full 32 bit range
+	const uint32 offset = span == 0 ? (*this)() : nextBelow(span);
+	return static_cast<int32>(static_cast<uint32>(inLow) + offset);
+}
+
+uint64 RandomStream::getState() const
+{
+	return _state;
+}
+
+uint64 RandomStream::getIncrement() const
+{
+	return _increment;
+}
+
+void RandomStream::setState(uint64 inState, uint64 inIncrement)
+{
+	_state = inState;
+	_increment = inIncrement | 1;
+}
+
+GameRandom::GameRandom()
+{
+	reseed(makeSeed());
+}
+
+GameRandom::GameRandom(uint64 inSeed)
+{
+	reseed(inSeed);
+}
+
+void GameRandom::reseed(uint64 inSeed)
+{
+	_seed = inSeed;
+	for (int32 i = 0; i < static_cast<int32>(ERandomStream::Count); i++)
+	{
+		_streams[i].seed(mix(inSeed + static_cast<uint64>(i)), static_cast<uint64>(i));
+	}
+}
+
+uint64 GameRandom::getSeed() const
+{
+	return _seed;
+}
+
+RandomStream& GameRandom::getStream(ERandomStream inStream)
+{
+	return _streams[static_cast<int32>(inStream)];
+}
+
+const RandomStream& GameRandom::getStream(ERandomStream inStream) const
+{
+	return _streams[static_cast<int32>(inStream)];
+}
+
+uint64 GameRandom::makeSeed()
+{
+	std::random_device device;
+	const uint64 entropy = (static_cast<uint64>(device()) << 32) | device();
+	const uint64 time = static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+	return mix(entropy ^ time);
+}
+
+uint64 GameRandom::deriveSeed(uint64 inSeed, uint64 inIndex)
+{
+	return mix(mix(inSeed) ^ inIndex);
+}
+
+GameRandom& GameRandom::getFallback()
+{
+	thread_local GameRandom fallback;
+	return fallback;
+}
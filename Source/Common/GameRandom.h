@@ -0,0 +1,91 @@
+#pragma once
+#include <iterator>
+#include <utility>
+
+#include "CommonTypes.h"
+
+/*
+	Summary: A PCG32 generator, 16 bytes of state and a handful of instructions per number.
+	Two generators built from the same seed but another stream never give the same sequence.
+	The results only depend on the seed, so unlike the standard distributions and std::shuffle
+	a game draws the same numbers with every compiler and library.
+*/
+class RandomStream {
+public:
+	typedef uint32 result_type;
+
+	RandomStream();
+	RandomStream(uint64 inSeed, uint64 inStream);
+
+	void seed(uint64 inSeed, uint64 inStream);
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return 0xFFFFFFFFu; }
+	result_type operator()();
+
+	// uniform in [0, inBound), 0 when inBound is 0
+	uint32 nextBelow(uint32 inBound);
+	// uniform in [inLow, inHigh]
+	int32 nextInRange(int32 inLow, int32 inHigh);
+
+	// Fisher-Yates shuffle drawing from this stream
+	template <typename RandomIt>
+	void shuffle(RandomIt inFirst, RandomIt inLast)
+	{
+		const auto count = std::distance(inFirst, inLast);
+		for (auto i = count - 1; i > 0; i--)
+		{
+			using std::swap;
+			swap(inFirst[i], inFirst[nextBelow(static_cast<uint32>(i + 1))]);
+		}
+	}
+
+	// the whole state, enough to carry on from the same point later
+	uint64 getState() const;
+	uint64 getIncrement() const;
+	void setState(uint64 inState, uint64 inIncrement);
+
+private:
+	uint64 _state = 0;
+	uint64 _increment = 1;
+};
+
+// what a stream of a game is used for, every subsystem draws from its own
+enum class ERandomStream
+{
+	Setup,
+	Deck,
+	Combat,
+	Strategy,
+	Count
+};
+
+/*
+	Summary: The random numbers of one game. A single seed gives one stream per subsystem,
+	so an extra draw in one of them leaves the others untouched, and a game replayed with
+	the same seed and the same choices plays out the same way.
+*/
+class GameRandom {
+public:
+	// seeded from the system, see getSeed to play the game again
+	GameRandom();
+	explicit GameRandom(uint64 inSeed);
+
+	// restarts every stream from inSeed
+	void reseed(uint64 inSeed);
+	uint64 getSeed() const;
+
+	RandomStream& getStream(ERandomStream inStream);
+	const RandomStream& getStream(ERandomStream inStream) const;
+
+	// a seed that differs on every call, the only place asking the system for randomness
+	static uint64 makeSeed();
+	// seed of game inIndex of a series started from inSeed, neighbouring indexes give unrelated seeds
+	static uint64 deriveSeed(uint64 inSeed, uint64 inIndex);
+	// streams for code running outside any game, one set per thread
+	static GameRandom& getFallback();
+
+private:
+	uint64 _seed = 0;
+	RandomStream _streams[static_cast<int32>(ERandomStream::Count)];
+};
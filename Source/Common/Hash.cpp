@@ -0,0 +1,26 @@
+#include "Hash.h"
+#include "MappedFile.h"
+
+uint64 Hash::fnv1a(const void* inData, std::size_t inSize, uint64 inSeed)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(inData);
+	uint64 hash = inSeed;
+	for (std::size_t i = 0; i < inSize; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+bool Hash::hashFile(const std::string& inPath, uint64& outHash)
+{
+	MappedFile file;
+	if (!file.open(inPath))
+	{
+		return false;
+	}
+
+	outHash = fnv1a(file.getData(), file.getSize());
+	return true;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+#include "CommonTypes.h"
+
+/*
+	Summary: 64 bit FNV-1a hashing of raw bytes.
+	Used to fingerprint map files and to checksum binary data, not for security.
+*/
+class Hash {
+public:
+	static constexpr uint64 FnvOffsetBasis = 14695981039346656037ULL;
+
+	// hashes inSize bytes, pass a previous result as inSeed to continue a hash
+	static uint64 fnv1a(const void* inData, std::size_t inSize, uint64 inSeed = FnvOffsetBasis);
+	// hashes the whole content of a file, returns false if it cannot be opened
+	static bool hashFile(const std::string& inPath, uint64& outHash);
+};
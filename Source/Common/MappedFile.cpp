@@ -0,0 +1,155 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+{
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const std::string& inPath)
+{
+	close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(inPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	_fileHandle = file;
+	_size = static_cast<std::size_t>(fileSize.QuadPart);
+
+	// an empty file cannot be mapped but is still a valid (empty) view
+	if (_size > 0)
+	{
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+		{
+			close();
+			return false;
+		}
+
+		_mappingHandle = mapping;
+		_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		if (_data == nullptr)
+		{
+			close();
+			return false;
+		}
+	}
+#else
+	_fileDescriptor = ::open(inPath.c_str(), O_RDONLY);
+	if (_fileDescriptor < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStat;
+	if (fstat(_fileDescriptor, &fileStat) != 0)
+	{
+		close();
+		return false;
+	}
+
+	_size = static_cast<std::size_t>(fileStat.st_size);
+
+	// an empty file cannot be mapped but is still a valid (empty) view
+	if (_size > 0)
+	{
+		void* mapped = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fileDescriptor, 0);
+		if (mapped == MAP_FAILED)
+		{
+			close();
+			return false;
+		}
+
+		_data = static_cast<const char*>(mapped);
+		// the parsers only walk forward through the file
+		madvise(mapped, _size, MADV_SEQUENTIAL);
+	}
+#endif
+
+	bIsOpen = true;
+	return true;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+	if (_data != nullptr)
+	{
+		UnmapViewOfFile(_data);
+	}
+	if (_mappingHandle != nullptr)
+	{
+		CloseHandle(static_cast<HANDLE>(_mappingHandle));
+	}
+	if (_fileHandle != nullptr)
+	{
+		CloseHandle(static_cast<HANDLE>(_fileHandle));
+	}
+	_mappingHandle = nullptr;
+	_fileHandle = nullptr;
+#else
+	if (_data != nullptr)
+	{
+		munmap(const_cast<char*>(_data), _size);
+	}
+	if (_fileDescriptor >= 0)
+	{
+		::close(_fileDescriptor);
+	}
+	_fileDescriptor = -1;
+#endif
+
+	_data = nullptr;
+	_size = 0;
+	bIsOpen = false;
+}
+
+bool MappedFile::isOpen() const
+{
+	return bIsOpen;
+}
+
+const char* MappedFile::getData() const
+{
+	return _data;
+}
+
+std::size_t MappedFile::getSize() const
+{
+	return _size;
+}
+
+std::string_view MappedFile::getView() const
+{
+	if (_data == nullptr)
+	{
+		return std::string_view();
+	}
+
+	return std::string_view(_data, _size);
+}
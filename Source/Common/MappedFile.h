@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/*
+	Summary: Read-only memory mapping of a whole file.
+	The contents stay valid until the object is closed or destroyed.
+*/
+class MappedFile {
+public:
+	MappedFile();
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// maps the file at inPath, returns false if it cannot be opened
+	bool open(const std::string& inPath);
+	void close();
+
+	bool isOpen() const;
+	const char* getData() const;
+	std::size_t getSize() const;
+	std::string_view getView() const;
+
+private:
+	const char* _data = nullptr;
+	std::size_t _size = 0;
+	bool bIsOpen = false;
+
+#ifdef _WIN32
+	void* _fileHandle = nullptr;
+	void* _mappingHandle = nullptr;
+#else
+	int _fileDescriptor = -1;
+#endif
+};
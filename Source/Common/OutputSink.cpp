@@ -0,0 +1,128 @@
+#include "OutputSink.h"
+
+OutputSink::OutputSink(std::streambuf* inBuffer)
+	: _stream(inBuffer)
+{
+}
+
+OutputSink::~OutputSink()
+{
+}
+
+std::ostream& OutputSink::getStream()
+{
+	return _stream;
+}
+
+bool OutputSink::isEnabled() const
+{
+	return _stream.rdbuf() != nullptr;
+}
+
+void OutputSink::flush()
+{
+}
+
+ConsoleOutputSink::ConsoleOutputSink()
+	: OutputSink(std::cout.rdbuf())
+{
+}
+
+void ConsoleOutputSink::flush()
+{
+	_stream.flush();
+}
+
+NullOutputSink::NullOutputSink()
+	: OutputSink(nullptr)
+{
+}
+
+BufferedOutputSink::BufferedOutputSink(std::ostream* inTarget, std::size_t inBlockSize)
+	: OutputSink(nullptr)
+	, _buffer(inTarget, inBlockSize)
+{
+	// the buffer only exists once the base is built, attaching it also clears the failed state
+	_stream.rdbuf(&_buffer);
+}
+
+BufferedOutputSink::~BufferedOutputSink()
+{
+	flush();
+}
+
+void BufferedOutputSink::flush()
+{
+	_buffer.flushBlock();
+}
+
+const std::string& BufferedOutputSink::getText() const
+{
+	return _buffer.text;
+}
+
+void BufferedOutputSink::clear()
+{
+	_buffer.text.clear();
+}
+
+uint64 BufferedOutputSink::getWrittenSize() const
+{
+	return _buffer.writtenSize;
+}
+
+BufferedOutputSink::BlockBuffer::BlockBuffer(std::ostream* inTarget, std::size_t inBlockSize)
+	: target(inTarget)
+{
+	block.reserve(inTarget != nullptr ? inBlockSize : 0);
+}
+
+void BufferedOutputSink::BlockBuffer::flushBlock()
+{
+	if (target != nullptr && !block.empty())
+	{
+		target->write(block.data(), static_cast<std::streamsize>(block.size()));
+		target->flush();
+		block.clear();
+	}
+}
+
+BufferedOutputSink::BlockBuffer::int_type BufferedOutputSink::BlockBuffer::overflow(int_type inCharacter)
+{
+	if (traits_type::eq_int_type(inCharacter, traits_type::eof()))
+	{
+		return traits_type::not_eof(inCharacter);
+	}
+	const char character = traits_type::to_char_type(inCharacter);
+	xsputn(&character, 1);
+	return inCharacter;
+}
+
+std::streamsize BufferedOutputSink::BlockBuffer::xsputn(const char* inData, std::streamsize inSize)
+{
+	writtenSize += static_cast<uint64>(inSize);
+	if (target == nullptr)
+	{
+		text.append(inData, static_cast<std::size_t>(inSize));
+		return inSize;
+	}
+
+	// the block is written out whole, a message never reaches the target in pieces of its own
+	if (block.size() + static_cast<std::size_t>(inSize) > block.capacity())
+	{
+		flushBlock();
+	}
+	if (static_cast<std::size_t>(inSize) > block.capacity())
+	{
+		target->write(inData, inSize);
+		return inSize;
+	}
+	block.insert(block.end(), inData, inData + inSize);
+	return inSize;
+}
+
+int BufferedOutputSink::BlockBuffer::sync()
+{
+	// a std::endl or flush from a writer is ignored, blocks only leave when full or on flush()
+	return 0;
+}
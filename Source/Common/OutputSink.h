@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "CommonTypes.h"
+
+/*
+	Summary: Where the narration of a game goes. Everything is written to getStream(),
+	the sink decides what becomes of it: the console, a memory buffer written out in large
+	blocks, or nothing at all. Writers end their lines with '\n' and never flush themselves,
+	so a quiet or buffered game makes no system call per message.
+*/
+class OutputSink {
+public:
+	virtual ~OutputSink();
+
+	OutputSink(const OutputSink&) = delete;
+	OutputSink& operator=(const OutputSink&) = delete;
+
+	std::ostream& getStream();
+	// false when everything written is dropped, callers may skip building expensive messages
+	bool isEnabled() const;
+	// pushes what is held to its destination
+	virtual void flush();
+
+protected:
+	// a null inBuffer leaves the stream in a failed state, every insertion then returns at once
+	explicit OutputSink(std::streambuf* inBuffer);
+
+	std::ostream _stream;
+};
+
+// writes straight to std::cout, as the game always did
+class ConsoleOutputSink : public OutputSink {
+public:
+	ConsoleOutputSink();
+	void flush() override;
+};
+
+// drops everything, nothing is even formatted
+class NullOutputSink : public OutputSink {
+public:
+	NullOutputSink();
+};
+
+/*
+	Summary: Keeps the narration in memory. With a target the text is written to it
+	a block at a time, without one everything is kept and can be read with getText.
+*/
+class BufferedOutputSink : public OutputSink {
+public:
+	static constexpr std::size_t DefaultBlockSize = 64 * 1024;
+
+	explicit BufferedOutputSink(std::ostream* inTarget = nullptr, std::size_t inBlockSize = DefaultBlockSize);
+	~BufferedOutputSink() override;
+
+	void flush() override;
+	// text written since the last clear, only kept when there is no target
+	const std::string& getText() const;
+	void clear();
+	// bytes written since the sink was created
+	uint64 getWrittenSize() const;
+
+private:
+	class BlockBuffer : public std::streambuf {
+	public:
+		BlockBuffer(std::ostream* inTarget, std::size_t inBlockSize);
+		void flushBlock();
+
+		std::ostream* target;
+		std::vector<char> block;
+		std::string text;
+		uint64 writtenSize = 0;
+
+	protected:
+		int_type overflow(int_type inCharacter) override;
+		std::streamsize xsputn(const char* inData, std::streamsize inSize) override;
+		int sync() override;
+	};
+
+	BlockBuffer _buffer;
+};
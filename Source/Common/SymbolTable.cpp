@@ -0,0 +1,75 @@
+#include "SymbolTable.h"
+
+SymbolTable::SymbolTable()
+{
+}
+
+SymbolTable::SymbolTable(const SymbolTable& inOther)
+{
+	*this = inOther;
+}
+
+SymbolTable& SymbolTable::operator=(const SymbolTable& inOther)
+{
+	if (this == &inOther)
+	{
+		return *this;
+	}
+
+	_names.clear();
+	_ids.clear();
+	_ids.reserve(inOther._names.size());
+	for (const std::string& name : inOther._names)
+	{
+		intern(name);
+	}
+	return *this;
+}
+
+int32 SymbolTable::intern(std::string_view inName)
+{
+	const auto found = _ids.find(inName);
+	if (found != _ids.end())
+	{
+		return found->second;
+	}
+
+	const int32 symbol = static_cast<int32>(_names.size());
+	_names.emplace_back(inName);
+	_ids.emplace(std::string_view(_names.back()), symbol);
+	return symbol;
+}
+
+int32 SymbolTable::find(std::string_view inName) const
+{
+	const auto found = _ids.find(inName);
+	return found != _ids.end() ? found->second : NoSymbol;
+}
+
+std::string_view SymbolTable::getName(int32 inSymbol) const
+{
+	if (inSymbol < 0 || inSymbol >= static_cast<int32>(_names.size()))
+	{
+		return std::string_view();
+	}
+	return _names[inSymbol];
+}
+
+int32 SymbolTable::getSize() const
+{
+	return static_cast<int32>(_names.size());
+}
+
+std::size_t SymbolTable::getMemoryUsage() const
+{
+	std::size_t usage = _names.size() * sizeof(std::string) + _ids.size() * (sizeof(std::string_view) + sizeof(int32) + sizeof(void*));
+	for (const std::string& name : _names)
+	{
+		// short names live inside the std::string itself
+		if (name.capacity() >= sizeof(std::string))
+		{
+			usage += name.capacity() + 1;
+		}
+	}
+	return usage;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "CommonTypes.h"
+
+/*
+	Summary: Interned strings addressed by a dense id.
+	Every distinct string is stored once and keeps its id for the lifetime of the table,
+	the views returned by getName stay valid as long as the table itself.
+	Lookups by name go through a hash of the stored views, so parsing a command
+	costs one hash instead of a string comparison per candidate.
+*/
+class SymbolTable {
+public:
+	static constexpr int32 NoSymbol = -1;
+
+	SymbolTable();
+	// the copy owns its own strings, views into the source are not shared
+	SymbolTable(const SymbolTable& inOther);
+	SymbolTable& operator=(const SymbolTable& inOther);
+
+	// id of inName, stored on first use
+	int32 intern(std::string_view inName);
+	// id of inName or NoSymbol if it was never interned
+	int32 find(std::string_view inName) const;
+	// empty for NoSymbol and unknown ids
+	std::string_view getName(int32 inSymbol) const;
+
+	int32 getSize() const;
+	std::size_t getMemoryUsage() const;
+
+private:
+	// a deque never moves its elements, the views used as keys stay valid
+	std::deque<std::string> _names;
+	std::unordered_map<std::string_view, int32> _ids;
+};
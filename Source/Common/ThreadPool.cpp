@@ -0,0 +1,96 @@
+#include "ThreadPool.h"
+
+#include <utility>
+
+ThreadPool::ThreadPool(int32 inThreadCount)
+{
+	const int32 threadCount = inThreadCount > 0 ? inThreadCount : getDefaultThreadCount();
+	_workers.reserve(threadCount);
+	for (int32 i = 0; i < threadCount; i++)
+	{
+		_workers.emplace_back(&ThreadPool::workerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		bIsStopping = true;
+	}
+	_taskAvailable.notify_all();
+
+	for (auto& worker : _workers)
+	{
+		worker.join();
+	}
+}
+
+int32 ThreadPool::getThreadCount() const
+{
+	return static_cast<int32>(_workers.size());
+}
+
+int32 ThreadPool::getDefaultThreadCount()
+{
+	const unsigned int cores = std::thread::hardware_concurrency();
+	return cores > 0 ? static_cast<int32>(cores) : 1;
+}
+
+void ThreadPool::submit(std::function<void()> inTask)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_tasks.push_back(std::move(inTask));
+		_pendingTasks++;
+	}
+	_taskAvailable.notify_one();
+}
+
+void ThreadPool::wait()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_allTasksDone.wait(lock, [this]() { return _pendingTasks == 0; });
+}
+
+void ThreadPool::parallelFor(int32 inCount, int32 inChunkSize, const std::function<void(int32, int32)>& inTask)
+{
+	const int32 chunkSize = inChunkSize > 0 ? inChunkSize : 1;
+	for (int32 begin = 0; begin < inCount; begin += chunkSize)
+	{
+		const int32 end = inCount - begin > chunkSize ? begin + chunkSize : inCount;
+		submit([&inTask, begin, end]() { inTask(begin, end); });
+	}
+	wait();
+}
+
+void ThreadPool::workerLoop()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_taskAvailable.wait(lock, [this]() { return bIsStopping || !_tasks.empty(); });
+			if (_tasks.empty())
+			{
+				return;
+			}
+			task = std::move(_tasks.front());
+			_tasks.pop_front();
+		}
+
+		task();
+
+		bool bIsIdle = false;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_pendingTasks--;
+			bIsIdle = _pendingTasks == 0;
+		}
+		if (bIsIdle)
+		{
+			_allTasksDone.notify_all();
+		}
+	}
+}
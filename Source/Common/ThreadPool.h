@@ -0,0 +1,46 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "CommonTypes.h"
+
+/*
+	Summary: Fixed set of worker threads running queued tasks.
+	Tasks run in no particular order, callers that need a deterministic
+	result write into their own slot and merge after wait().
+*/
+class ThreadPool {
+public:
+	// inThreadCount below 1 uses one thread per hardware core
+	explicit ThreadPool(int32 inThreadCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	int32 getThreadCount() const;
+
+	void submit(std::function<void()> inTask);
+	// blocks until every submitted task has finished
+	void wait();
+
+	// calls inTask(begin, end) on consecutive ranges covering [0, inCount) and waits for all of them
+	void parallelFor(int32 inCount, int32 inChunkSize, const std::function<void(int32, int32)>& inTask);
+
+	static int32 getDefaultThreadCount();
+
+private:
+	void workerLoop();
+
+	std::vector<std::thread> _workers;
+	std::deque<std::function<void()>> _tasks;
+	std::mutex _mutex;
+	std::condition_variable _taskAvailable;
+	std::condition_variable _allTasksDone;
+	int32 _pendingTasks = 0;
+	bool bIsStopping = false;
+};
@@ -0,0 +1,514 @@
+#include "Engine/GameCheckpoint.h"
+#include "Engine/GameContext.h"
+#include "Engine/TournamentScheduler.h"
+#include "Player/Player.h"
+#include "Map/map.h"
+#include "Map/MapGraph.h"
+#include "Cards/Cards.h"
+#include "Order/Orders.h"
+#include "Common/BinaryStream.h"
+#include "Common/GameRandom.h"
+#include "Common/Hash.h"
+#include "Common/MappedFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <list>
+
+namespace
+{
+	const char WzCheckpointMagic[4] = { 'W', 'Z', 'S', 'V' };
+
+	int64 checkpointPlayer(const Player* inPlayer)
+	{
+		return inPlayer != nullptr ? static_cast<int64>(inPlayer->getPlayerID()) : -1;
+	}
+
+	uint32 edgeCountOf(const Map& inMap)
+	{
+		return inMap.hasGraph() ? static_cast<uint32>(inMap.getGraph().getEdgeCount()) : 0;
+	}
+}
+
+GameCheckpointWriter::GameCheckpointWriter()
+{
+}
+
+const std::string& GameCheckpointWriter::getError() const
+{
+	return _error;
+}
+
+bool GameCheckpointWriter::write(const GameContext& inGame, std::vector<char>& outData)
+{
+	_error.clear();
+	const Map* map = inGame._map;
+	if (map == nullptr)
+	{
+		_error = "the game has no map";
+		return false;
+	}
+	const TerritoryState& state = map->getState();
+	const std::size_t territoryCount = static_cast<std::size_t>(state.getTerritoryCount());
+
+	// the header is filled in once the payload it describes is written
+	outData.clear();
+	outData.resize(sizeof(WzCheckpointHeader));
+	BinaryWriter writer(outData);
+
+	writer.writeString(inGame._mapName);
+	writer.writeVarInt(inGame._turn);
+	writer.writeVarUInt(inGame._nextPlayerID);
+	writer.writeUInt64(inGame._random.getSeed());
+	writer.writeVarUInt(static_cast<uint64>(ERandomStream::Count));
+	for (int32 i = 0; i < static_cast<int32>(ERandomStream::Count); i++)
+	{
+		const RandomStream& stream = inGame._random.getStream(static_cast<ERandomStream>(i));
+		writer.writeUInt64(stream.getState());
+		writer.writeUInt64(stream.getIncrement());
+	}
+
+	const std::vector<Player*>& players = inGame._players;
+	writer.writeVarUInt(players.size());
+	for (Player* player : players)
+	{
+		writer.writeVarUInt(player->getPlayerID());
+		writer.writeString(player->getPlayerNameView());
+		writer.writeString(TournamentScheduler::getStrategyName(player->getPlayerStrategy()));
+		writer.writeVarUInt(player->getReinforcementPoolSize());
+		writer.writeVarInt(player->numDeployments);
+		writer.writeUInt8(static_cast<uint8>(player->getPlayerTurnPhase()));
+		writer.writeUInt8((player->getCapturedTerritoryFlag() ? 1 : 0) | (player->getPlayerWasAttacked() ? 2 : 0));
+
+		const Hand* hand = player->getCurrentHand();
+		const std::size_t handSize = hand != nullptr ? hand->getHand().size() : 0;
+		writer.writeVarUInt(handSize);
+		for (std::size_t i = 0; i < handSize; i++)
+		{
+			writer.writeUInt8(static_cast<uint8>(hand->getHand()[i]->getCardType()));
+		}
+
+		// in the order the player keeps them, the strategies walk them in that order.
+		// The lists to attack and defend are made during a turn and still read at the start of the next.
+		writeTerritories(writer, player->getTerritoriesOwned());
+		writeTerritories(writer, player->getTerritoriesToAttack());
+		writeTerritories(writer, player->getTerritoriesToDefend());
+	}
+
+	// references between players are written once every player is
+	OrderRecord record;
+	for (Player* player : players)
+	{
+		const std::vector<Player*>& notAttackable = player->getNotAttackablePlayers();
+		writer.writeVarUInt(notAttackable.size());
+		for (const Player* other : notAttackable)
+		{
+			writer.writeVarInt(checkpointPlayer(other));
+		}
+
+		const std::list<Order*> orders = player->getOrders() != nullptr ? player->getOrders()->getOList() : std::list<Order*>();
+		writer.writeVarUInt(orders.size());
+		for (const Order* order : orders)
+		{
+			order->getRecord(record);
+			writer.writeUInt8(static_cast<uint8>(record.type));
+			writer.writeVarInt(record.owner);
+			writer.writeVarInt(record.source);
+			writer.writeVarInt(record.target);
+			writer.writeVarInt(record.armies);
+		}
+	}
+
+	writer.writeVarInt(checkpointPlayer(inGame._neutralPlayer));
+	writer.writeVarUInt(inGame._activePlayers.size());
+	for (const Player* player : inGame._activePlayers)
+	{
+		writer.writeVarInt(checkpointPlayer(player));
+	}
+
+	const Deck* deck = inGame._deck;
+	writer.writeUInt8(deck != nullptr ? 1 : 0);
+	if (deck != nullptr)
+	{
+		writer.writeVarInt(const_cast<Deck*>(deck)->getCurrentCard());
+		writer.writeVarUInt(deck->getCards().size());
+		for (const Card* card : deck->getCards())
+		{
+			writer.writeUInt8(static_cast<uint8>(card->getCardType()));
+		}
+	}
+
+	writer.writeVarUInt(static_cast<uint64>(state.getPlayerCount()));
+	for (int32 i = 0; i < state.getPlayerCount(); i++)
+	{
+		writer.writeVarInt(checkpointPlayer(state.getPlayerByIndex(i)));
+	}
+	writer.writeVarIntArray(state.getOwners().data(), territoryCount);
+	writer.writeVarIntArray(state.getArmies().data(), territoryCount);
+	writer.writeVarIntArray(state.getValues().data(), territoryCount);
+	state.getFrontierIndex().saveOrder(_frontierOrder);
+	writer.writeVarUInt(_frontierOrder.size());
+	writer.writeVarIntArray(_frontierOrder.data(), _frontierOrder.size());
+
+	const std::size_t payloadSize = outData.size() - sizeof(WzCheckpointHeader);
+	WzCheckpointHeader header;
+	std::memcpy(header.magic, WzCheckpointMagic, sizeof(WzCheckpointMagic));
+	header.version = Version;
+	header.byteOrder = ByteOrderMark;
+	header.checksum = Hash::fnv1a(outData.data() + sizeof(WzCheckpointHeader), payloadSize);
+	header.territoryCount = static_cast<uint32>(territoryCount);
+	header.edgeCount = edgeCountOf(*map);
+	header.payloadSize = payloadSize;
+	std::memcpy(outData.data(), &header, sizeof(header));
+	return true;
+}
+
+void GameCheckpointWriter::writeTerritories(BinaryWriter& inWriter, const std::vector<Territory*>& inTerritories)
+{
+	_indexes.resize(inTerritories.size());
+	for (std::size_t i = 0; i < inTerritories.size(); i++)
+	{
+		_indexes[i] = inTerritories[i]->getIndex();
+	}
+	inWriter.writeVarUInt(_indexes.size());
+	inWriter.writeVarIntArray(_indexes.data(), _indexes.size(), true);
+}
+
+bool GameCheckpointWriter::writeFile(const GameContext& inGame, const std::string& inPath)
+{
+	if (!write(inGame, _buffer))
+	{
+		return false;
+	}
+
+	const std::string temporaryPath = inPath + ".tmp";
+	{
+		std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!output)
+		{
+			_error = "cannot create " + temporaryPath;
+			return false;
+		}
+		output.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+		if (!output)
+		{
+			_error = "cannot write " + temporaryPath;
+			return false;
+		}
+	}
+
+	// rename replaces the previous checkpoint at once where it can, Windows wants it removed first
+	if (std::rename(temporaryPath.c_str(), inPath.c_str()) != 0)
+	{
+		std::remove(inPath.c_str());
+		if (std::rename(temporaryPath.c_str(), inPath.c_str()) != 0)
+		{
+			_error = "cannot replace " + inPath;
+			return false;
+		}
+	}
+	return true;
+}
+
+GameCheckpointLoader::GameCheckpointLoader()
+{
+}
+
+const std::string& GameCheckpointLoader::getError() const
+{
+	return _error;
+}
+
+bool GameCheckpointLoader::fail(const std::string& inError)
+{
+	_error = inError;
+	return false;
+}
+
+bool GameCheckpointLoader::readHeader(const char* inData, std::size_t inSize, WzCheckpointHeader& outHeader, const char*& outPayload)
+{
+	if (inSize < sizeof(outHeader))
+	{
+		return fail("the data is too small to be a checkpoint");
+	}
+	std::memcpy(&outHeader, inData, sizeof(outHeader));
+
+	if (std::memcmp(outHeader.magic, WzCheckpointMagic, sizeof(WzCheckpointMagic)) != 0)
+	{
+		return fail("the data is not a checkpoint");
+	}
+	if (outHeader.byteOrder == SwappedByteOrderMark)
+	{
+		return fail("the checkpoint was written on a machine of the other byte order");
+	}
+	if (outHeader.version != GameCheckpointWriter::Version || outHeader.byteOrder != ByteOrderMark)
+	{
+		return fail("the checkpoint was written by another version");
+	}
+	if (outHeader.payloadSize != inSize - sizeof(outHeader))
+	{
+		return fail("the checkpoint size does not match its header");
+	}
+
+	outPayload = inData + sizeof(outHeader);
+	if (Hash::fnv1a(outPayload, outHeader.payloadSize) != outHeader.checksum)
+	{
+		return fail("the checkpoint is corrupt");
+	}
+	return true;
+}
+
+bool GameCheckpointLoader::readTerritories(BinaryReader& inReader, Map& inMap, std::vector<Territory*>& outTerritories)
+{
+	const int32 territoryCount = inMap.getState().getTerritoryCount();
+	const std::size_t count = inReader.readCount(static_cast<std::size_t>(territoryCount));
+	_indexes.resize(count);
+	inReader.readVarIntArray(_indexes.data(), count, true);
+
+	outTerritories.clear();
+	outTerritories.reserve(count);
+	for (const int32 index : _indexes)
+	{
+		if (index < 0 || index >= territoryCount)
+		{
+			return fail("a territory index is outside the map");
+		}
+		outTerritories.push_back(inMap.getTerritoryByIndex(index));
+	}
+	return true;
+}
+
+bool GameCheckpointLoader::restore(const char* inData, std::size_t inSize, GameContext& outGame)
+{
+	_error.clear();
+
+	WzCheckpointHeader header;
+	const char* payload = nullptr;
+	if (!readHeader(inData, inSize, header, payload))
+	{
+		return false;
+	}
+
+	Map* map = outGame._map;
+	if (map == nullptr)
+	{
+		return fail("the game has no map to restore on");
+	}
+	TerritoryState& state = map->getState();
+	const int32 territoryCount = state.getTerritoryCount();
+	if (header.territoryCount != static_cast<uint32>(territoryCount) || header.edgeCount != edgeCountOf(*map))
+	{
+		return fail("the checkpoint was made on another map");
+	}
+	if (!outGame._players.empty())
+	{
+		return fail("the game to restore already has players");
+	}
+
+	BinaryReader reader(payload, static_cast<std::size_t>(header.payloadSize));
+	outGame._mapName = reader.readString();
+	outGame._turn = static_cast<int32>(reader.readVarInt());
+	const uint64 nextPlayerID = reader.readVarUInt();
+	outGame._random.reseed(reader.readUInt64());
+	if (reader.readVarUInt() != static_cast<uint64>(ERandomStream::Count))
+	{
+		return fail("the checkpoint has other random streams");
+	}
+	for (int32 i = 0; i < static_cast<int32>(ERandomStream::Count); i++)
+	{
+		const uint64 streamState = reader.readUInt64();
+		const uint64 increment = reader.readUInt64();
+		outGame._random.getStream(static_cast<ERandomStream>(i)).setState(streamState, increment);
+	}
+
+	const std::size_t playerCount = reader.readCount(reader.getRemaining());
+	for (std::size_t p = 0; p < playerCount && reader.isValid(); p++)
+	{
+		const uint64 id = reader.readVarUInt();
+		const std::string name = reader.readString();
+		const std::string strategy = reader.readString();
+		Player* player = strategy.empty() ? new Player(name) : TournamentScheduler::createPlayer(strategy, name);
+		if (player == nullptr)
+		{
+			return fail("unknown strategy " + strategy);
+		}
+		// registered first so the game deletes it whatever happens next
+		outGame.registerPlayer(player);
+		player->setPlayerID(static_cast<std::size_t>(id));
+
+		player->setReinforcementPool(static_cast<std::size_t>(reader.readVarUInt()));
+		player->numDeployments = static_cast<int>(reader.readVarInt());
+		const uint8 phase = reader.readUInt8();
+		if (phase > static_cast<uint8>(EPlayerTurnPhase::EndOfTurn))
+		{
+			return fail("unknown turn phase");
+		}
+		player->setPlayerTurnPhase(static_cast<EPlayerTurnPhase>(phase));
+		const uint8 flags = reader.readUInt8();
+		player->setCapturedTerritoryFlag((flags & 1) != 0);
+		player->setPlayerWasAttacked((flags & 2) != 0);
+
+		const std::size_t handSize = reader.readCount(reader.getRemaining());
+		for (std::size_t i = 0; i < handSize; i++)
+		{
+			const uint8 cardType = reader.readUInt8();
+			if (cardType > static_cast<uint8>(ECardTypes::Diplomacy))
+			{
+				return fail("unknown card type");
+			}
+			player->getCurrentHand()->insertCard_Hand(new Card(static_cast<ECardTypes>(cardType)));
+		}
+
+		if (!readTerritories(reader, *map, player->getTerritoriesOwned())
+			|| !readTerritories(reader, *map, player->getTerritoriesToAttack())
+			|| !readTerritories(reader, *map, player->getTerritoriesToDefend()))
+		{
+			return false;
+		}
+	}
+	outGame._nextPlayerID = static_cast<std::size_t>(nextPlayerID);
+
+	OrderRecord record;
+	for (Player* player : outGame._players)
+	{
+		const std::size_t notAttackableCount = reader.readCount(playerCount);
+		for (std::size_t i = 0; i < notAttackableCount; i++)
+		{
+			Player* other = outGame.findPlayerByID(reader.readVarInt());
+			if (other == nullptr)
+			{
+				return fail("a truce names an unknown player");
+			}
+			player->getNotAttackablePlayers().push_back(other);
+		}
+
+		const std::size_t orderCount = reader.readCount(reader.getRemaining());
+		for (std::size_t i = 0; i < orderCount; i++)
+		{
+			const uint8 orderType = reader.readUInt8();
+			if (orderType > static_cast<uint8>(EOrderType::Negotiate))
+			{
+				return fail("unknown order type");
+			}
+			record.type = static_cast<EOrderType>(orderType);
+			record.owner = static_cast<int32>(reader.readVarInt());
+			record.source = static_cast<int32>(reader.readVarInt());
+			record.target = static_cast<int32>(reader.readVarInt());
+			record.armies = static_cast<int32>(reader.readVarInt());
+			Order* order = Order::createFromRecord(record, outGame);
+			if (order == nullptr)
+			{
+				return fail("an order does not fit the game");
+			}
+			player->getOrders()->add(order);
+		}
+	}
+
+	const int64 neutralID = reader.readVarInt();
+	outGame._neutralPlayer = neutralID < 0 ? nullptr : outGame.findPlayerByID(neutralID);
+	if (neutralID >= 0 && outGame._neutralPlayer == nullptr)
+	{
+		return fail("the neutral player is unknown");
+	}
+
+	const std::size_t activeCount = reader.readCount(playerCount);
+	outGame._activePlayers.clear();
+	for (std::size_t i = 0; i < activeCount; i++)
+	{
+		Player* player = outGame.findPlayerByID(reader.readVarInt());
+		if (player == nullptr)
+		{
+			return fail("an active player is unknown");
+		}
+		outGame._activePlayers.push_back(player);
+	}
+
+	delete outGame._deck;
+	outGame._deck = nullptr;
+	if (reader.readUInt8() != 0)
+	{
+		Deck* deck = new Deck();
+		outGame._deck = deck;
+		deck->setRandomStream(&outGame._random.getStream(ERandomStream::Deck));
+		const int currentCard = static_cast<int>(reader.readVarInt());
+		const std::size_t cardCount = reader.readCount(reader.getRemaining());
+		for (std::size_t i = 0; i < cardCount; i++)
+		{
+			const uint8 cardType = reader.readUInt8();
+			if (cardType > static_cast<uint8>(ECardTypes::Diplomacy))
+			{
+				return fail("unknown card type");
+			}
+			deck->insertCard_Deck(new Card(static_cast<ECardTypes>(cardType)));
+		}
+		deck->setCurrentCard(currentCard);
+	}
+
+	const std::size_t registryCount = reader.readCount(playerCount);
+	_snapshot.players.resize(registryCount);
+	for (std::size_t i = 0; i < registryCount; i++)
+	{
+		const int64 id = reader.readVarInt();
+		_snapshot.players[i] = id < 0 ? nullptr : outGame.findPlayerByID(id);
+	}
+	_snapshot.owners.resize(territoryCount);
+	_snapshot.armies.resize(territoryCount);
+	_snapshot.values.resize(territoryCount);
+	reader.readVarIntArray(_snapshot.owners.data(), _snapshot.owners.size());
+	reader.readVarIntArray(_snapshot.armies.data(), _snapshot.armies.size());
+	reader.readVarIntArray(_snapshot.values.data(), _snapshot.values.size());
+	_snapshot.frontierOrder.resize(reader.readCount(reader.getRemaining()));
+	reader.readVarIntArray(_snapshot.frontierOrder.data(), _snapshot.frontierOrder.size());
+
+	if (!reader.isValid())
+	{
+		return fail("the checkpoint is truncated");
+	}
+	if (!reader.isAtEnd())
+	{
+		return fail("the checkpoint has data after its end");
+	}
+	for (const int32 owner : _snapshot.owners)
+	{
+		if (owner < TerritoryState::NoOwner || owner >= static_cast<int32>(registryCount))
+		{
+			return fail("a territory owner is unknown");
+		}
+	}
+	if (!state.restoreSnapshot(_snapshot))
+	{
+		return fail("the territory state does not fit the map");
+	}
+	return true;
+}
+
+bool GameCheckpointLoader::loadFile(const std::string& inPath, GameContext& outGame)
+{
+	MappedFile file;
+	if (!file.open(inPath))
+	{
+		return fail("cannot open " + inPath);
+	}
+	return restore(file.getData(), file.getSize(), outGame);
+}
+
+bool GameCheckpointLoader::readMapName(const std::string& inPath, std::string& outMapName)
+{
+	_error.clear();
+	MappedFile file;
+	if (!file.open(inPath))
+	{
+		return fail("cannot open " + inPath);
+	}
+
+	WzCheckpointHeader header;
+	const char* payload = nullptr;
+	if (!readHeader(file.getData(), file.getSize(), header, payload))
+	{
+		return false;
+	}
+	BinaryReader reader(payload, static_cast<std::size_t>(header.payloadSize));
+	outMapName = reader.readString();
+	return reader.isValid() ? true : fail("the checkpoint is truncated");
+}
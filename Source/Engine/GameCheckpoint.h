@@ -0,0 +1,100 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Map/TerritoryState.h"
+
+class GameContext;
+class Map;
+class Territory;
+class BinaryWriter;
+class BinaryReader;
+
+/*
+	Layout of a .wzsave checkpoint, a header then the var ints and strings of a BinaryWriter.
+	The header and the fixed size values are in the byte order of the machine that wrote them,
+	the header holds ByteOrderMark so a machine of the other byte order rejects the file:
+		WzCheckpointHeader
+		map name, turn, next player id, seed, state and increment of every random stream
+		every player: id, name, strategy, reinforcement pool, deployments, turn phase, flags,
+			hand, territories owned, to attack and to defend (dense indexes, delta coded)
+		every player: ids of the players it cannot attack, pending orders (OrderRecord fields)
+		neutral player id, ids of the players still taking turns
+		deck: current card and the cards left
+		territory state: player registry, then owners, armies and values of every territory,
+			then the frontier sets in their order (FrontierIndex::saveOrder)
+	Players are written by id and territories by dense index, so a checkpoint can only be
+	restored on the map it was made on. The checksum covers the payload.
+*/
+struct WzCheckpointHeader
+{
+	char magic[4];
+	uint16 version;
+	uint16 byteOrder;
+	uint64 checksum;
+	uint32 territoryCount;
+	uint32 edgeCount;
+	uint64 payloadSize;
+};
+
+static_assert(sizeof(WzCheckpointHeader) == 32, "the .wzsave header layout changed");
+
+/*
+	Summary: Writes the state of a game between two turns to the .wzsave binary format.
+	The territory arrays are written in one pass each, a checkpoint of a map with 100k territories
+	is about 1.5 MB and takes some 15 ms, little next to the turn it follows.
+*/
+class GameCheckpointWriter {
+public:
+	static constexpr uint16 Version = 2;
+
+	GameCheckpointWriter();
+
+	// replaces the content of outData with the checkpoint of inGame, which needs a map
+	bool write(const GameContext& inGame, std::vector<char>& outData);
+	// writes next to inPath first and renames, a crash while writing keeps the checkpoint before it
+	bool writeFile(const GameContext& inGame, const std::string& inPath);
+
+	const std::string& getError() const;
+
+private:
+	void writeTerritories(BinaryWriter& inWriter, const std::vector<Territory*>& inTerritories);
+
+	// kept between checkpoints so writing one every turn does not allocate
+	std::vector<char> _buffer;
+	std::vector<int32> _indexes;
+	std::vector<int32> _frontierOrder;
+	std::string _error;
+};
+
+/*
+	Summary: Rebuilds a game from a .wzsave checkpoint.
+	The game has to be a new GameContext with the map of the checkpoint set and no player yet,
+	the players, their hands and orders, the deck, the random streams and the territory state are
+	made again so the game goes on exactly as it would have. A failed restore can leave part of
+	the game built, the context is to be thrown away.
+*/
+class GameCheckpointLoader {
+public:
+	GameCheckpointLoader();
+
+	bool restore(const char* inData, std::size_t inSize, GameContext& outGame);
+	bool loadFile(const std::string& inPath, GameContext& outGame);
+	// map name of a checkpoint file, to load the map before restoring on it
+	bool readMapName(const std::string& inPath, std::string& outMapName);
+
+	const std::string& getError() const;
+
+private:
+	bool fail(const std::string& inError);
+	// checks the header and the checksum, outPayload points at the outHeader.payloadSize bytes after the header
+	bool readHeader(const char* inData, std::size_t inSize, WzCheckpointHeader& outHeader, const char*& outPayload);
+	// territories written by writeTerritories, fails on an index outside inMap
+	bool readTerritories(BinaryReader& inReader, Map& inMap, std::vector<Territory*>& outTerritories);
+
+	std::vector<int32> _indexes;
+	TerritoryStateSnapshot _snapshot;
+	std::string _error;
+};
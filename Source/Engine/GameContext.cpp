@@ -0,0 +1,529 @@
+#include "Engine/GameContext.h"
+#include "Player/Player.h"
+#include "Map/map.h"
+#include "Cards/Cards.h"
+#include "Order/Orders.h"
+#include "Strategy/PlayerStrategies.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+GameContext::GameContext()
+{
+}
+
+GameContext::~GameContext()
+{
+	if (_outputSink != nullptr)
+	{
+		_outputSink->flush();
+	}
+
+	// a player can be listed more than once, the neutral player is not always listed
+	std::vector<Player*> players = _players;
+	players.push_back(_neutralPlayer);
+	std::sort(players.begin(), players.end());
+	players.erase(std::unique(players.begin(), players.end()), players.end());
+	for (Player* player : players)
+	{
+		delete player;
+	}
+	delete _deck;
+}
+
+void GameContext::setMap(Map* inMap)
+{
+	_map = inMap;
+}
+
+Map* GameContext::getMap() const
+{
+	return _map;
+}
+
+void GameContext::setMapName(std::string inMapName)
+{
+	_mapName = std::move(inMapName);
+}
+
+const std::string& GameContext::getMapName() const
+{
+	return _mapName;
+}
+
+void GameContext::setNeutralPlayer(std::string inNeutralPlName)
+{
+	_neutralPlayer = new Player(inNeutralPlName);
+	// named after the id it is about to get
+	_neutralPlayer->setPlayerName(_neutralPlayer->getPlayerName() + std::to_string(_nextPlayerID));
+	_neutralPlayer->setPlayerStrategy(new NeutralPlayerStrategy());
+	registerPlayer(_neutralPlayer);
+}
+
+Player* GameContext::getNeutralPlayer() const
+{
+	return _neutralPlayer;
+}
+
+void GameContext::registerPlayer(Player* inPlayer)
+{
+	inPlayer->setPlayerID(_nextPlayerID++);
+	inPlayer->setGameContext(this);
+	_players.push_back(inPlayer);
+
+	const int32 symbol = _playerNames.intern(inPlayer->getPlayerNameView());
+	if (symbol >= static_cast<int32>(_playersBySymbol.size()))
+	{
+		_playersBySymbol.resize(symbol + 1, nullptr);
+	}
+	// a name already taken keeps its first player
+	if (_playersBySymbol[symbol] == nullptr)
+	{
+		_playersBySymbol[symbol] = inPlayer;
+	}
+}
+
+void GameContext::unregisterPlayer(Player* inPlayer)
+{
+	// searched by pointer, the player may have been renamed since it joined
+	std::replace(_playersBySymbol.begin(), _playersBySymbol.end(), inPlayer, static_cast<Player*>(nullptr));
+}
+
+Player* GameContext::findPlayer(std::string_view inName) const
+{
+	const int32 symbol = _playerNames.find(inName);
+	if (symbol == SymbolTable::NoSymbol || _playersBySymbol[symbol] == nullptr)
+	{
+		return nullptr;
+	}
+	// players can be renamed after they joined
+	Player* player = _playersBySymbol[symbol];
+	return player->getPlayerNameView() == inName ? player : nullptr;
+}
+
+Player* GameContext::findPlayerByID(int64 inID) const
+{
+	// a game only has a handful of players
+	for (Player* player : _players)
+	{
+		if (static_cast<int64>(player->getPlayerID()) == inID)
+		{
+			return player;
+		}
+	}
+	return nullptr;
+}
+
+const std::vector<Player*>& GameContext::getActivePlayers() const
+{
+	return _activePlayers;
+}
+
+const std::vector<Player*>& GameContext::getPlayerList() const
+{
+	return _players;
+}
+
+std::vector<Player*>& GameContext::getPlayerList()
+{
+	return _players;
+}
+
+Deck* GameContext::getDeck() const
+{
+	return _deck;
+}
+
+int32 GameContext::getTurn() const
+{
+	return _turn;
+}
+
+/*
+* Sets where the narration of the game goes, a null inSink goes back to the console
+*
+* @param inSink the sink, owned by the game from now on
+*/
+void GameContext::setOutputSink(std::unique_ptr<OutputSink> inSink)
+{
+	if (_outputSink != nullptr)
+	{
+		_outputSink->flush();
+	}
+	_outputSink = std::move(inSink);
+}
+
+std::unique_ptr<OutputSink> GameContext::releaseOutputSink()
+{
+	if (_outputSink != nullptr)
+	{
+		_outputSink->flush();
+	}
+	return std::move(_outputSink);
+}
+
+OutputSink& GameContext::getOutputSink()
+{
+	if (_outputSink == nullptr)
+	{
+		_outputSink = std::make_unique<ConsoleOutputSink>();
+	}
+	return *_outputSink;
+}
+
+std::ostream& GameContext::getOutput()
+{
+	return getOutputSink().getStream();
+}
+
+GameRandom& GameContext::getRandom()
+{
+	return _random;
+}
+
+const GameRandom& GameContext::getRandom() const
+{
+	return _random;
+}
+
+void GameContext::setRandomSeed(uint64 inSeed)
+{
+	_random.reseed(inSeed);
+}
+
+void GameContext::setTurnEndCallback(std::function<void(GameContext&)> inCallback)
+{
+	_onTurnEnd = std::move(inCallback);
+}
+
+void GameContext::setOrderSource(std::function<void(GameContext&, Player&)> inSource)
+{
+	_orderSource = std::move(inSource);
+}
+
+/**
+ * Sets a game up on the map of the context
+ * @param blank
+ * @return void
+ */
+void GameContext::startGame() {
+	std::ostream& out = getOutput();
+	delete _deck;
+	_deck = new Deck(30, &_random.getStream(ERandomStream::Deck));
+	_turn = 0;
+	//a) fairly distribute all the territories to the players
+
+	RandomStream& setupRandom = _random.getStream(ERandomStream::Setup);
+
+	int numberOfTerritory = _map->listTerritory.size();
+	const int playercount = _players.size();
+
+	for (auto& pl : _players)
+	{
+		pl->getTerritoriesOwned().clear();
+		pl->setReinforcementPool(0);
+		Hand* plHand = pl->getCurrentHand();
+		if (plHand != nullptr)
+		{
+			while (plHand->getHand().size() > 0)
+			{
+				Card* plCard = plHand->drawCard_Hand();
+				delete plCard;
+			}
+		}
+	}
+
+	out << "\nThe numberOfTerritory in the map is: " << numberOfTerritory << '\n';
+	Territory* t = nullptr;
+	int round = numberOfTerritory / playercount;
+	for (int ii = 0; ii < round; ii++) {
+		for (int i = 0; i < playercount; i++) {
+			t = _map->listTerritory.at(i + ii * playercount);
+			t->setPlayer(_players[i]);
+			_players[i]->getTerritoriesOwned().push_back(t);
+		}
+	}
+	int remainder = numberOfTerritory % playercount;
+	for (int i = 0; i < remainder; i++) {
+		t = _map->listTerritory.at(round * playercount + i);
+		t->setPlayer(_players[i]);
+		_players[i]->getTerritoriesOwned().push_back(t);
+	}
+
+	out << "Fairly distribute all the territories to the players>>>>>>>\n";
+	for (int i = 0; i < playercount; i++)
+	{
+		out << *(_players.at(i)) << '\n';
+	}
+
+	//b) determine randomly the order of play of the players in the game
+	out << "\nDetermine randomly the order of play of the players in the game>>>>>>\n";
+	out << "Before shuffle, the order of play is: ";
+	for (std::vector<Player*>::iterator it = _players.begin(); it != _players.end(); ++it) {
+		out << " " << (*it)->getPlayerName();
+	}
+
+	setupRandom.shuffle(_players.begin(), _players.end());
+
+	out << "\nAfter shuffle, the order of play is: ";
+	for (std::vector<Player*>::iterator it = _players.begin(); it != _players.end(); ++it)
+	{
+		out << " " << (*it)->getPlayerName();
+	}
+	out << '\n';
+
+	//c) give 50 initial armies to the players, which are placed in their respective reinforcement pool
+	out << "\nGive 50 initial armies to the players>>>>>>\n";
+	for (auto& pl : _players)
+	{
+		if (pl != nullptr)
+		{
+			pl->setReinforcementPool(50);
+		}
+	}
+
+	out << "player name        quantity of armies\n";
+	for (int i = 0; i < playercount; i++)
+	{
+		out << _players.at(i)->getPlayerNameView();
+		out << std::setw(25 - _players.at(i)->getPlayerName().size());
+		out << _players.at(i)->getReinforcementPoolSize() << '\n';
+	}
+	out << '\n';
+	//d) let each player draw 2 initial cards from the deck using the deck's draw() method
+
+	for (int i = 0; i < playercount; i++) {
+		_players.at(i)->getCurrentHand()->insertCard_Hand(_deck->drawCard_Deck());
+		_players.at(i)->getCurrentHand()->insertCard_Hand(_deck->drawCard_Deck());
+	}
+	out << "Let each player draw 2 initial cards from the deck>>>>>>>\n";
+	out << "players' initial cards are: \n";
+	out << "player name        cards\n";
+	for (int i = 0; i < playercount; i++)
+	{
+		out << _players.at(i)->getPlayerNameView() << '\n';
+		const Hand* plHand = _players[i]->getCurrentHand();
+		for (const auto& card : plHand->getHand())
+		{
+			out << "\t" << *card << '\n';
+		}
+	}
+	out << '\n';
+}
+
+/*
+* The main game loop of the Warzone game
+*
+* @param players A vector of players
+* @param maxNumberOfTurns The maximum number of turns
+*/
+std::string GameContext::playGame(std::vector<Player*> players, int maxNumberOfTurns)
+{
+	_activePlayers = std::move(players);
+	_turn = 0; //Turn counter
+	return resumeGame(maxNumberOfTurns);
+}
+
+/*
+* Plays the turns left of a game, from the current turn with the active players
+*
+* @param maxNumberOfTurns The maximum number of turns, the ones already played included
+*/
+std::string GameContext::resumeGame(int maxNumberOfTurns)
+{
+	std::ostream& out = getOutput();
+	std::vector<Player*>& players = _activePlayers;
+	while (players.size() != 1 && _turn < maxNumberOfTurns)
+	{ //Loop if there are 2 or more players left
+		out << "It is now turn: " << std::to_string(_turn + 1) << "!\n\n";
+
+		for (Player* p : players)
+		{
+			if (p->getPlayerStrategy() == nullptr) continue;
+			if (p->getPlayerWasAttacked() && dynamic_cast<NeutralPlayerStrategy*>(p->getPlayerStrategy()))
+			{
+				delete p->getPlayerStrategy();
+				p->setPlayerStrategy(new AggressivePlayerStrategy());
+			}
+		}
+
+		for (Player* p : players)
+		{
+			if (p == nullptr) continue;
+			if (p->getCapturedTerritoryFlag())
+			{
+				out << p->getPlayerNameView() << "gets to draw a card!\n";
+				Card* newCard = _deck->drawCard_Deck();
+				out << p->getPlayerNameView() << " drew " << *newCard << "!\n";
+				p->getCurrentHand()->insertCard_Hand(newCard);
+				p->setCapturedTerritoryFlag(false);
+			}
+
+			p->clearPlayersNotToAttack();
+			p->setCapturedTerritoryFlag(false);
+		}
+
+		//Give a number of armies to each player
+		for (Player* p : players)
+			reinforcementPhase(p);
+
+		//Have each player issue orders
+		for (Player* p : players)
+			issueOrdersPhase(p);
+
+		//Execute all orders from players
+		for (Player* p : players)
+			executeOrdersPhase(p);
+
+		//Remove player(s) if they have no more territories.
+		//They stay in the game until it ends, orders of the others can still name them.
+		players.erase(std::remove_if(players.begin(), players.end(), [](Player* player)
+		{
+			return player->getTerritoriesOwned().size() <= 0;
+		}), players.end());
+
+		//Increment turn counter
+		_turn++;
+		if (_onTurnEnd)
+		{
+			_onTurnEnd(*this);
+		}
+	}//end while
+	std::string endGameMessage = (players.size() == 1) ? "Game over, " + players.at(0)->getPlayerName() + " wins\n"
+		: "The game has exceeded the amount of turns, therefore the game is a draw.\n";
+	out << endGameMessage;
+	out << '\n';
+	for (Player* p : players)
+	{
+		if (p == nullptr) continue;
+
+		out << p->getPlayerNameView() << " ended the game with " << std::to_string(p->getTerritoriesOwned().size())
+			<< " territories under their control.\n";
+	}
+
+	//Return player strategy of the winning player or draw
+	std::string result = "";
+	if (players.size() != 1) {
+		result = "Draw";
+	}
+	else {
+		PlayerStrategies* ps = players.at(0)->getPlayerStrategy();
+		if (dynamic_cast<AggressivePlayerStrategy*>(ps)) {
+			result = "Aggressive";
+		}
+		else if (dynamic_cast<BenevolentPlayerStrategy*>(ps)) {
+			result = "Benevolent";
+		}
+		else if (dynamic_cast<NeutralPlayerStrategy*>(ps)) {
+			result = "Neutral";
+		}
+		else if (dynamic_cast<CheaterPlayerStrategy*>(ps)) {
+			result = "Cheater";
+		}
+	}
+
+	return result;
+}
+
+/*
+* Gives a number of armies to the player's reinforcement pool
+* based on the number of territories
+*
+* @param *p pointer to a Player object
+*/
+void GameContext::reinforcementPhase(Player* p) {
+	std::ostream& out = getOutput();
+
+	//Add armies to reinforcement pool based on territories owned
+	int numTerritoriesOwned = p->getTerritoriesOwned().size();
+	int currentRPool = p->getReinforcementPoolSize();
+
+	int newArmies = (numTerritoriesOwned >= 1 && numTerritoriesOwned < 12) ? 3 : numTerritoriesOwned / 3;
+	out << "Adding " << newArmies << " armies to reinforcement pool\n";
+	currentRPool = (numTerritoriesOwned >= 1 && numTerritoriesOwned < 12) ? currentRPool + 3 : currentRPool + newArmies;
+
+	/*
+	* Check if the player owns all territories of a continent,
+	* if so, add continent's bonus to reinforcement pool.
+	* The map state counts the territories of every player per continent
+	* as they change hands, so this is one lookup per continent.
+	*/
+	const TerritoryState& state = _map->getState();
+	const int32 playerIndex = state.findPlayerIndex(p);
+
+	for (int32 i = 0; i < state.getContinentCount(); i++)
+	{
+		if (state.ownsContinent(playerIndex, i)) {
+			Continent* c = _map->listContinents.at(i);
+			out << "BONUS: Adding " << c->getArmyValu() << " armies to reinforcement pool\n";
+			currentRPool = currentRPool + c->getArmyValu();
+		}
+	}
+
+	p->setReinforcementPool(currentRPool); //Update new reinforcement pool
+	out << p->getPlayerNameView() << "\'s reinforcement pool: " << currentRPool << "\n\n";
+}
+
+const std::vector<Territory*> GameContext::GetEnemyTerritoriesOfCurrentPlayer(Player* p)
+{
+	std::vector<Territory*> allEnemyTerritories;
+	for (auto& enemy : _players)
+	{
+		allEnemyTerritories.insert(
+			allEnemyTerritories.end(),
+			enemy->getTerritoriesOwned().begin(),
+			enemy->getTerritoriesOwned().end()
+		);
+	}
+
+	return allEnemyTerritories;
+}
+
+/*
+* Issue players orders and place them in their order list
+*
+* @param *p pointer to a Player object
+*/
+void GameContext::issueOrdersPhase(Player* p) {
+	if (_orderSource)
+	{
+		_orderSource(*this, *p);
+		return;
+	}
+	p->issueOrder();
+}
+
+/*
+* Execute player orders
+*
+* @param *p pointer to a Player object
+*/
+void GameContext::executeOrdersPhase(Player* p) {
+	getOutput() << "Executing " << p->getPlayerNameView() << "\'s orders\n";
+	OrdersList* ol = p->getOrders();
+	// getOList hands out a copy, one is made for the whole phase
+	const std::list<Order*> orders = ol->getOList();
+
+	/*
+	Loop player orders for deploy orders and execute them
+	*/
+	for (Order* o : orders) {
+		if (o->getType() == EOrderType::Deploy) {
+			o->execute();
+		}
+	}
+
+	/*
+	Loop player orders and execute remaining orders
+	*/
+	for (Order* o : orders) {
+		if (o->getType() != EOrderType::Deploy) {
+			o->execute();
+		}
+		ol->remove(0);
+	}
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/GameRandom.h"
+#include "Common/OutputSink.h"
+#include "Common/SymbolTable.h"
+
+class Territory;
+class Player;
+class Map;
+class Deck;
+
+/*
+	Summary: Everything one game is made of: its map, players, deck, random numbers and
+	where its narration goes. Nothing is shared with another game, so games held by different
+	contexts can be played on different threads at the same time.
+	The context owns its players and deck, the map belongs to whoever set it and has to
+	outlive the game.
+*/
+class GameContext {
+public:
+	GameContext();
+	~GameContext();
+
+	GameContext(const GameContext&) = delete;
+	GameContext& operator=(const GameContext&) = delete;
+
+	void setMap(Map* inMap);
+	Map* getMap() const;
+	// file the map was loaded from, kept in checkpoints so a game can be restored on it
+	void setMapName(std::string inMapName);
+	const std::string& getMapName() const;
+
+	// adds inPlayer to the game, which numbers it, attaches it and deletes it with the game
+	void registerPlayer(Player* inPlayer);
+	// forgets the name of a player, it stays in the game
+	void unregisterPlayer(Player* inPlayer);
+	const std::vector<Player*>& getPlayerList() const;
+	std::vector<Player*>& getPlayerList();
+	// player of this game called inName, nullptr if there is none
+	Player* findPlayer(std::string_view inName) const;
+	// player of this game with the id inID, nullptr if there is none
+	Player* findPlayerByID(int64 inID) const;
+	// players still taking turns in the game being played, in the order they play
+	const std::vector<Player*>& getActivePlayers() const;
+
+	Player* getNeutralPlayer() const;
+	// creates the neutral player of the game and registers it
+	void setNeutralPlayer(std::string inNeutralPlName);
+
+	const std::vector<Territory*> GetEnemyTerritoriesOfCurrentPlayer(Player* p);
+
+	Deck* getDeck() const;
+	// turns played so far by playGame
+	int32 getTurn() const;
+
+	// where the narration of the game goes, the console unless another sink is set
+	void setOutputSink(std::unique_ptr<OutputSink> inSink);
+	// hands the sink over to another game, this one goes back to the console
+	std::unique_ptr<OutputSink> releaseOutputSink();
+	OutputSink& getOutputSink();
+	std::ostream& getOutput();
+
+	GameRandom& getRandom();
+	const GameRandom& getRandom() const;
+	void setRandomSeed(uint64 inSeed);
+
+	// shares the territories of the map out between the players, draws the order of play
+	// and gives every player its first armies and cards
+	void startGame();
+	// plays turns until one of inPlayers is left or inMaxTurns turns have been played.
+	// Returns the strategy of the winner, "Draw" when there is none.
+	std::string playGame(std::vector<Player*> inPlayers, int inMaxTurns);
+	// goes on with the active players from the current turn, after a checkpoint was restored
+	std::string resumeGame(int inMaxTurns);
+	// called after every turn played, with the game between two turns. An empty function removes it.
+	void setTurnEndCallback(std::function<void(GameContext&)> inCallback);
+	// issues the orders of a player in place of running its strategy, an empty function goes back to the
+	// strategies. A replay gives recorded orders this way, a recorder runs the strategy itself and notes them.
+	void setOrderSource(std::function<void(GameContext&, Player&)> inSource);
+
+private:
+	// save and restore the players, deck, random streams and turn counter
+	friend class GameCheckpointWriter;
+	friend class GameCheckpointLoader;
+
+	void reinforcementPhase(Player* p);
+	void issueOrdersPhase(Player* p);
+	void executeOrdersPhase(Player* p);
+
+	Map* _map = nullptr;
+	std::string _mapName;
+	Deck* _deck = nullptr;
+
+	std::vector<Player*> _players;
+	// players of _players left in the game, the neutral player only joins when it is attacked
+	std::vector<Player*> _activePlayers;
+	Player* _neutralPlayer = nullptr;
+	// names of the registered players, _playersBySymbol gives the player of each name
+	SymbolTable _playerNames;
+	std::vector<Player*> _playersBySymbol;
+	// ids are handed out in the order players join, the same game always numbers them the same
+	std::size_t _nextPlayerID = 0;
+
+	int32 _turn = 0;
+	std::function<void(GameContext&)> _onTurnEnd;
+	std::function<void(GameContext&, Player&)> _orderSource;
+
+	std::unique_ptr<OutputSink> _outputSink;
+	GameRandom _random;
+};
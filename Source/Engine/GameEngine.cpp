@@ -1,4 +1,8 @@
 #include "Engine/GameEngine.h"
+#include "Engine/GameContext.h"
+#include "Engine/GameCheckpoint.h"
+#include "Engine/GameReplay.h"
+#include "Engine/TournamentScheduler.h"
 #include "Player/Player.h"
 #include "Map/map.h"
 #include "Cards/Cards.h"
@@ -11,7 +15,6 @@
 #include <string>
 #include <algorithm>
 #include <vector>
-#include <random>
 #include <iomanip>
 #include <sstream>
 
@@ -114,6 +117,9 @@ GameEngine::GameEngine(Observer* list)
  */
 GameEngine::~GameEngine()
 {
+	// the game flushes its narration and deletes its players and deck
+	_game.reset();
+	_mapLoader.reset();
 	delete eState;
 	eState = NULL;
 #ifdef DEBUG_ENABLE
@@ -149,17 +155,165 @@ GameEngine& GameEngine::operator=(const GameEngine& obj)
 	return *this;
 }
 
+GameContext& GameEngine::getGameContext()
+{
+	if (_game == nullptr)
+	{
+		_game = std::make_unique<GameContext>();
+	}
+	return *_game;
+}
+
+MapLoader& GameEngine::getMapLoader()
+{
+	if (_mapLoader == nullptr)
+	{
+		_mapLoader = std::make_unique<MapLoader>();
+	}
+	return *_mapLoader;
+}
+
+/*
+* Writes the game of the engine to a .wzsave checkpoint, between two turns
+*
+* @param inPath the file written, a checkpoint already there is replaced
+* @return false, with the reason printed, when nothing was written
+*/
+bool GameEngine::saveCheckpoint(const std::string& inPath)
+{
+	GameCheckpointWriter writer;
+	if (!writer.writeFile(getGameContext(), inPath))
+	{
+		std::cout << "Checkpoint " << inPath << " not saved: " << writer.getError() << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/*
+* Replaces the game of the engine with the one of a checkpoint. The map it was played on is loaded again,
+* the game keeps the output sink of the engine. The game of the engine is left as it was when this fails.
+*
+* @param inPath a file written by saveCheckpoint
+* @return false, with the reason printed, when the checkpoint cannot be restored
+*/
+bool GameEngine::loadCheckpoint(const std::string& inPath)
+{
+	GameCheckpointLoader loader;
+	std::string mapName;
+	if (!loader.readMapName(inPath, mapName))
+	{
+		std::cout << "Checkpoint " << inPath << " not loaded: " << loader.getError() << std::endl;
+		return false;
+	}
+	if (!getMapLoader().loadMap(mapName))
+	{
+		std::cout << "Checkpoint " << inPath << " not loaded: the map " << mapName << " is invalid" << std::endl;
+		return false;
+	}
+
+	std::unique_ptr<GameContext> game = std::make_unique<GameContext>();
+	game->setMap(getMapLoader().getListMap()->back());
+	game->setMapName(mapName);
+	if (!loader.loadFile(inPath, *game))
+	{
+		std::cout << "Checkpoint " << inPath << " not loaded: " << loader.getError() << std::endl;
+		return false;
+	}
+	for (Player* p : game->getPlayerList())
+	{
+		p->setCommandProcessor(commandProces);
+	}
+	game->setOutputSink(getGameContext().releaseOutputSink());
+	watchCheckpointFile(*game);
+
+	_game = std::move(game);
+	_mapFileName = mapName;
+	setCurrentState(GAME_STATE_PLAY);
+	return true;
+}
+
+std::string GameEngine::resumeGame(int maxNumberOfTurns)
+{
+	return getGameContext().resumeGame(maxNumberOfTurns);
+}
+
+void GameEngine::setCheckpointFile(std::string inPath)
+{
+	_checkpointFile = std::move(inPath);
+	watchCheckpointFile(getGameContext());
+}
+
+/*
+* Plays again a game recorded by a tournament. The players issue the orders they issued then and no strategy
+* is run, the game is checked to end on the state the recording ended on. It keeps the output sink of the engine.
+*
+* @param inPath a .wzreplay file
+* @return false, with the reason printed, when the replay cannot be played or strays from the recording
+*/
+bool GameEngine::replayGame(const std::string& inPath)
+{
+	GameReplayer replayer;
+	if (!replayer.loadFile(inPath))
+	{
+		std::cout << "Replay " << inPath << " not loaded: " << replayer.getError() << std::endl;
+		return false;
+	}
+	const std::string mapName = replayer.getMapName();
+	if (!getMapLoader().loadMap(mapName))
+	{
+		std::cout << "Replay " << inPath << " not loaded: the map " << mapName << " is invalid" << std::endl;
+		return false;
+	}
+
+	std::unique_ptr<GameContext> game = std::make_unique<GameContext>();
+	game->setMap(getMapLoader().getListMap()->back());
+	game->setOutputSink(getGameContext().releaseOutputSink());
+	std::string winner;
+	const bool bReplayed = replayer.replay(*game, winner);
+	if (!bReplayed)
+	{
+		std::cout << "Replay " << inPath << " strayed from the recording: " << replayer.getError() << std::endl;
+	}
+
+	_game = std::move(game);
+	_mapFileName = mapName;
+	gameresult = winner;
+	setCurrentState(GAME_STATE_FINISHED);
+	return bReplayed;
+}
+
+void GameEngine::watchCheckpointFile(GameContext& inGame)
+{
+	if (_checkpointFile.empty())
+	{
+		inGame.setTurnEndCallback(nullptr);
+		return;
+	}
+	// the writer keeps its buffer from one turn to the next
+	std::shared_ptr<GameCheckpointWriter> writer = std::make_shared<GameCheckpointWriter>();
+	inGame.setTurnEndCallback([writer, path = _checkpointFile](GameContext& inTurnGame)
+	{
+		if (!writer->writeFile(inTurnGame, path))
+		{
+			inTurnGame.getOutput() << "Checkpoint " << path << " not saved: " << writer->getError() << "\n";
+		}
+	});
+}
+
 void GameEngine::setNeutralPlayer(std::string inNeutralPlName)
 {
-	neutralPlayer = new Player(inNeutralPlName);
-	neutralPlayer->setPlayerName(neutralPlayer->getPlayerName() + std::to_string(neutralPlayer->getPlayerID()));
-	neutralPlayer->setPlayerStrategy(new NeutralPlayerStrategy());
-	this->playerlist.push_back(neutralPlayer);
+	getGameContext().setNeutralPlayer(inNeutralPlName);
 }
 
 Player* GameEngine::getNeutralPlayer() const
 {
-    return neutralPlayer;
+	return _game != nullptr ? _game->getNeutralPlayer() : nullptr;
+}
+
+Player* GameEngine::findPlayer(std::string_view inName) const
+{
+	return _game != nullptr ? _game->findPlayer(inName) : nullptr;
 }
 
 /**
@@ -257,13 +411,6 @@ std::string GameEngine::stringToLog() {
     return  toLog;
 }
 
-static std::string filename;
-static std::string playername;
-static int playercount = 0;
-MapLoader* newmap = new MapLoader();
-Map* mapToUse = new Map();
-std::vector<int> ReinforcementPools;
-
 /**
  * private function extractName(string) of GameEngine class
  * @param string str user input
@@ -298,6 +445,7 @@ void GameEngine::addPlayer(std::string user_input) {
 	std::string tmp = "";
 	std::vector<std::string> words;
 	std::string strat = "";
+	std::string playername;
 
 	std::stringstream myStream(user_input);
 
@@ -351,130 +499,20 @@ void GameEngine::addPlayer(std::string user_input) {
 		p->setPlayerStrategy(new HumanPlayerStrategy(p));
 	}
 
-	p->setCurrentGameInstance(this);
 	p->setCommandProcessor(commandProces);
-	playerlist.push_back(p);
-	playercount++;
+	getGameContext().registerPlayer(p);
+	const std::vector<Player*>& playerlist = getPlayerList();
 	std::cout << "The player " << playername << " is added." << std::endl;
-	std::cout << "There should be 2-6 players in this game. Now we have " << playercount << " players." << std::endl;
+	std::cout << "There should be 2-6 players in this game. Now we have " << playerlist.size() << " players." << std::endl;
 	std::cout << std::endl << "Player#    PlayerName" << std::endl;
 	for (int i = 0; i < (int)playerlist.size(); i++)
 	{
-		std::cout << i + 1 << "             " << playerlist.at(i)->getPlayerName() << std::endl;
+		std::cout << i + 1 << "             " << playerlist.at(i)->getPlayerNameView() << std::endl;
 	}
 	std::cout << std::endl;
 }
 
 
-/**
- * private function gamestart() of GameEngine class
- * @param blank
- * @return void
- */
-
-void GameEngine::gamestart() {
-	_deck = new Deck(30);
-	//a) fairly distribute all the territories to the players
-
-	std::random_device rd;
-	std::mt19937 g(rd());
-
-	int numberOfTerritory = mapToUse->listTerritory.size();
-
-	for (auto& pl : playerlist)
-	{
-		pl->getTerritoriesOwned().clear();
-		pl->setReinforcementPool(0);
-		Hand* plHand = pl->getCurrentHand();
-		if (plHand != nullptr)
-		{
-			while (plHand->getHand().size() > 0)
-			{
-				Card* plCard = plHand->drawCard_Hand();
-				delete plCard;
-			}
-		}
-	}
-
-	//std::shuffle(mapToUse->listTerritory.begin(), mapToUse->listTerritory.end(), g);
-
-	std::cout << std::endl << "The numberOfTerritory in the map is: " << numberOfTerritory << std::endl;
-	Territory* t = new Territory();
-	int round = numberOfTerritory / playercount;
-	for (int ii = 0; ii < round; ii++) {
-		for (int i = 0; i < playercount; i++) {
-			t = mapToUse->listTerritory.at(i + ii * playercount);
-			t->setPlayer(playerlist[i]);
-			playerlist[i]->getTerritoriesOwned().push_back(t);
-		}
-	}
-	int remainder = numberOfTerritory % playercount;
-	for (int i = 0; i < remainder; i++) {
-		t = mapToUse->listTerritory.at(round * playercount);
-		t->setPlayer(playerlist[i]);
-		playerlist[i]->getTerritoriesOwned().push_back(t);
-	}
-
-	std::cout << "Fairly distribute all the territories to the players>>>>>>>" << std::endl;
-	for (int i = 0; i < playercount; i++)
-	{
-		std::cout << *(playerlist.at(i)) << std::endl;
-	}
-
-	//b) determine randomly the order of play of the players in the game
-	std::cout << std::endl << "Determine randomly the order of play of the players in the game>>>>>>" << std::endl;
-	std::cout << "Before shuffle, the order of play is: ";
-	for (std::vector<Player*>::iterator it = playerlist.begin(); it != playerlist.end(); ++it) {
-		std::cout << " " << (*it)->getPlayerName();
-	}
-
-	std::shuffle(playerlist.begin(), playerlist.end(), g);
-
-	std::cout << std::endl << "After shuffle, the order of play is: ";
-	for (std::vector<Player*>::iterator it = playerlist.begin(); it != playerlist.end(); ++it)
-	{
-		std::cout << " " << (*it)->getPlayerName();
-	}
-	std::cout << std::endl;
-
-	//c) give 50 initial armies to the players, which are placed in their respective reinforcement pool
-	std::cout << std::endl << "Give 50 initial armies to the players>>>>>>" << std::endl;
-	for (auto& pl : playerlist)
-	{
-		if (pl != nullptr)
-		{
-			pl->setReinforcementPool(50);
-		}
-	}
-
-	std::cout << "player name        quantity of armies" << std::endl;
-	for (int i = 0; i < playercount; i++)
-	{
-		std::cout << playerlist.at(i)->getPlayerName();
-		std::cout << std::setw(25 - playerlist.at(i)->getPlayerName().size());
-		std::cout << playerlist.at(i)->getReinforcementPoolSize() << std::endl;
-	}
-	std::cout << std::endl;
-	//d) let each player draw 2 initial cards from the deck using the deck�s draw() method
-
-	for (int i = 0; i < playercount; i++) {
-		playerlist.at(i)->getCurrentHand()->insertCard_Hand(_deck->drawCard_Deck());
-		playerlist.at(i)->getCurrentHand()->insertCard_Hand(_deck->drawCard_Deck());
-	}
-	std::cout << "Let each player draw 2 initial cards from the deck>>>>>>>" << std::endl;
-	std::cout << "players' initial cards are: " << std::endl;
-	std::cout << "player name        cards" << std::endl;
-	for (int i = 0; i < playercount; i++)
-	{
-		std::cout << playerlist.at(i)->getPlayerName() << std::endl;
-		const Hand* plHand = playerlist[i]->getCurrentHand();
-		for (const auto& card : plHand->getHand())
-		{
-			std::cout << "\t" << *card << std::endl;
-		}
-	}
-	std::cout << std::endl;
-}
 
 /*
  The startup phase the number of player and the number of territory 
@@ -508,7 +546,7 @@ void GameEngine::startupPhase() {
 		case  GAME_STATE_START:
 			if (/*!user_input.substr(0, 7).compare(user_input_list[LOADMAP])*/commandProces->validate(userCommand, user_input_list[LOADMAP])) {
 				//do mapload
-				filename = extractName(user_input);
+				_mapFileName = extractName(user_input);
 				setCurrentState(GAME_STATE_MAP_LOAD);
 				userCommand->saveEffect("Passing from  <GAME_STATE_START> to <GAME_STATE_MAP_LOAD>");
 				std::cout << "Map loaded!\nPlease try: " << "\"" << user_input_list[VALIDATEMAP] << "\" to validate the current map, or "
@@ -546,6 +584,21 @@ void GameEngine::startupPhase() {
 						i++;
 						maxNbTurnCommand = std::stoi(extractName(inTournamentCommend.at(i)));
 					}
+					else if (inTournamentCommend.at(i) == "-T") {
+						// optional, the number of threads the games are played on
+						i++;
+						setTournamentThreadCount(std::stoi(extractName(inTournamentCommend.at(i))));
+					}
+					else if (inTournamentCommend.at(i) == "-C") {
+						// optional, the directory the games checkpoint to and resume from
+						i++;
+						setTournamentCheckpointDirectory(extractName(inTournamentCommend.at(i)));
+					}
+					else if (inTournamentCommend.at(i) == "-R") {
+						// optional, the directory the games record their orders to
+						i++;
+						setTournamentReplayDirectory(extractName(inTournamentCommend.at(i)));
+					}
 				}
 				// Testing if the command is valid / if all the info are correcly entered 
 
@@ -587,7 +640,7 @@ void GameEngine::startupPhase() {
 		case  GAME_STATE_MAP_LOAD:
 			if (commandProces->validate(userCommand, user_input_list[LOADMAP])) {
 				//do mapload	
-				filename = extractName(user_input);
+				_mapFileName = extractName(user_input);
 				setCurrentState(GAME_STATE_MAP_LOAD);
 				userCommand->saveEffect("Passing from  <GAME_STATE_START> to <GAME_STATE_MAP_LOAD>");
 				std::cout << "Map loaded!\nPlease try: " << "\"" << user_input_list[VALIDATEMAP] << "\" to validate the current map, or "
@@ -595,13 +648,14 @@ void GameEngine::startupPhase() {
 			}
 			else if (commandProces->validate(userCommand, user_input_list[VALIDATEMAP]))
 			{
-				std::cout << "filename: " << filename << std::endl;
-				bool mapload = newmap->MapLoader::loadMap(filename);
+				std::cout << "filename: " << _mapFileName << std::endl;
+				bool mapload = getMapLoader().loadMap(_mapFileName);
 
 				if (mapload == true) {
-					mapToUse = newmap->getListMap()->at(0);
+					getGameContext().setMap(getMapLoader().getListMap()->back());
+					getGameContext().setMapName(_mapFileName);
 					setCurrentState(GAME_STATE_MAP_VALIDATED);
-					userCommand->saveEffect("Passing from  <GAME_STATE_MAP_LOAD> to <GAME_STATE_MAP_VALIDATED> : Map validated :"+ filename);
+					userCommand->saveEffect("Passing from  <GAME_STATE_MAP_LOAD> to <GAME_STATE_MAP_VALIDATED> : Map validated :"+ _mapFileName);
 					std::cout << "Map validated!\nPlease enter: \"addplayer\" command to begin adding players." << "\n";
 					std::cout << "Add [aggressive] or [benevolent] or [neutral] or [cheater] to be AI'd, or [human] or don't for User control." << "\n";
 				}
@@ -630,7 +684,7 @@ void GameEngine::startupPhase() {
 			}
 			break;
 		case GAME_STATE_PLAYERS_ADDED:
-			if (playercount < 2) {
+			if (getPlayerList().size() < 2) {
 				if (commandProces->validate(userCommand, user_input_list[ADDPLAYER]))
 				{
 					addPlayer(user_input.substr(user_input_list[ADDPLAYER].size() + 1, user_input.size()));
@@ -645,16 +699,16 @@ void GameEngine::startupPhase() {
 					std::cout << "Please enter \"addplayer <playername>.\"" << std::endl;
 				}
 			}
-			else if (playercount >= 6) {
+			else if (getPlayerList().size() >= 6) {
 				if (commandProces->validate(userCommand, user_input_list[GAMESTART])) {
-					GameEngine::gamestart();
+					getGameContext().startGame();
 					setCurrentState(GAME_STATE_PLAY);
 					userCommand->saveEffect("Passing from  <GAME_STATE_PLAYERS_ADDED> to <GAME_STATE_PLAY> , The game will start");
 					std::cout << "Player limit reached! There is a limit of 6." << std::endl;
 					std::cout << "All set! Ready to play!" << std::endl;
 					//TODO: Add variable for maxNumberOfTurns
 					int tempMaxTurn = 10;//Samuel temp fix Potato 
-					mainGameLoop(playerlist, mapToUse, tempMaxTurn);
+					mainGameLoop(getPlayerList(), getGameContext().getMap(), tempMaxTurn);
 				}
 				else {
 					std::cout << "Error input! The players have reached to upper limit of 6. Please enter gamestart." << std::endl;
@@ -669,13 +723,13 @@ void GameEngine::startupPhase() {
 
 			}
 			else if (commandProces->validate(userCommand, user_input_list[GAMESTART])) {
-				GameEngine::gamestart();
+				getGameContext().startGame();
 				setCurrentState(GAME_STATE_PLAY);
 				userCommand->saveEffect("Passing from  <GAME_STATE_PLAYERS_ADDED> to <GAME_STATE_PLAY> , The game will start");
 				std::cout << "All set! Ready to play!" << std::endl;
 				//TODO: Add variable for maxNumberOfTurns
 				int tempMaxTurn = 10;//Samuel temp fix Potato
-				mainGameLoop(playerlist, mapToUse, tempMaxTurn);
+				mainGameLoop(getPlayerList(), getGameContext().getMap(), tempMaxTurn);
 			}
 			else {
 				std::cout << "Error input(please try: " << user_input_list[ADDPLAYER] << " or "
@@ -695,7 +749,7 @@ void GameEngine::startupPhase() {
 
 
 /*
-* The main game loop of the Warzone game
+* The main game loop of the Warzone game, played in the context of the engine
 * 
 * @param players A vector of players
 * @param map The current game map
@@ -703,247 +757,50 @@ void GameEngine::startupPhase() {
 */
 std::string GameEngine::mainGameLoop(std::vector<Player*> players, Map* map, int maxNumberOfTurns)
 {
-	int turn = 0; //Turn counter
-	while (players.size() != 1 && turn < maxNumberOfTurns)
-	{ //Loop if there are 2 or more players left
-		std::cout << "It is now turn: " << std::to_string(turn + 1) << "!" << std::endl << std::endl;
-
-		int initPlayersSize = players.size();
-
-		for (Player* p : players)
-		{
-			if (p->getPlayerStrategy() == nullptr) continue;
-			if (p->getPlayerWasAttacked() && dynamic_cast<NeutralPlayerStrategy*>(p->getPlayerStrategy()))
-			{
-				delete p->getPlayerStrategy();
-				p->setPlayerStrategy(new AggressivePlayerStrategy());
-			}
-		}
-
-		for (Player* p : players)
-		{
-			if (p == nullptr) continue;
-			if (p->getCapturedTerritoryFlag())
-			{
-				std::cout << p->getPlayerName() << "gets to draw a card!" << std::endl;
-				Card* newCard = _deck->drawCard_Deck();
-				std::cout << p->getPlayerName() << " drew " << *newCard << "!" << std::endl;
-				p->getCurrentHand()->insertCard_Hand(newCard);
-				p->setCapturedTerritoryFlag(false);
-			}
-
-			p->clearPlayersNotToAttack();
-			p->setCapturedTerritoryFlag(false);
-		}
-
-		//Give a number of armies to each player
-		for (Player* p : players)
-			reinforcementPhase(p, map);
-
-		//Have each player issue orders
-		for (Player* p : players)
-			issueOrdersPhase(p, map);
-
-		//Execute all orders from players
-		for (Player* p : players)
-			executeOrdersPhase(p);
-
-		//Remove player(s) if they have no more territories
-		//int playerIndex = 0;
-		//for (int i = 0; i < initPlayersSize; i++) {
-		//	Player* p = players.at(playerIndex);
-		//	if (p->getTerritoriesOwned().size() == 0) {
-		//		players.erase(players.begin() + playerIndex);
-		//		playerIndex--;
-		//	}
-		//	else {
-		//		playerIndex++;
-		//	}
-		//}
-
-		std::vector<Player*>::iterator itor;
-		for (auto& player : players)
-		{
-			if (player->getTerritoriesOwned().size() <= 0)
-			{
-				itor = std::find(players.begin(), players.end(), player);
-				if (itor != players.end())
-				{
-					players.erase(itor);
-					if (player != nullptr)
-					{
-						delete player;
-					}
-				}
-			}
-		}
-
-		//Increment turn counter
-		turn++;
-	}//end while
-	std::string endGameMessage = (players.size() == 1) ? "Game over, " + players.at(0)->getPlayerName() + " wins\n"
-		: "The game has exceeded the amount of turns, therefore the game is a draw.\n";
-	std::cout << endGameMessage;
-	std::cout << std::endl;
-	for (Player* p : players)
-	{
-		if (p == nullptr) continue;
-		
-		std::cout << p->getPlayerName() << " ended the game with " << std::to_string(p->getTerritoriesOwned().size())
-			<< " territories under their control." << std::endl;
-	}
-
-	//Return player strategy of the winning player or draw
-	std::string result = "";
-	if (players.size() != 1) {
-		result = "Draw";
-	}
-	else {
-		PlayerStrategies* ps = players.at(0)->getPlayerStrategy();
-		if (dynamic_cast<AggressivePlayerStrategy*>(ps)) {
-			result = "Aggressive";
-		}
-		else if (dynamic_cast<BenevolentPlayerStrategy*>(ps)) {
-			result = "Benevolent";
-		}
-		else if (dynamic_cast<NeutralPlayerStrategy*>(ps)){
-			result = "Neutral";
-		}
-		else if (dynamic_cast<CheaterPlayerStrategy*>(ps)) {
-			result = "Cheater";
-		}
-	}
-
-	return result;
+	getGameContext().setMap(map);
+	return getGameContext().playGame(players, maxNumberOfTurns);
 }
 
-/*
-* Gives a number of armies to the player's reinforcement pool
-* based on the number of territories
-*
-* @param *p pointer to a Player object
-* @param *map pointer to a Map object
-*/
-const void GameEngine::reinforcementPhase(Player* p, Map* map) {
-
-	//Add armies to reinforcement pool based on territories owned
-	std::vector<Territory*> playerTerritories = p->getTerritoriesOwned();
-	int numTerritoriesOwned = playerTerritories.size();
-	int currentRPool = p->getReinforcementPoolSize();
-
-	int newArmies = (numTerritoriesOwned >= 1 && numTerritoriesOwned < 12) ? 3 : numTerritoriesOwned / 3;
-	std::cout << "Adding " << newArmies << " armies to reinforcement pool\n";
-	currentRPool = (numTerritoriesOwned >= 1 && numTerritoriesOwned < 12) ? currentRPool + 3 : currentRPool + newArmies;
-
-	/*
-	* Check if the player owns all territories of a continent,
-	* if so, add continent's bonus to reinforcement pool
-	*/
-	//Sort player territories
-	std::vector<Territory*> sortedPlayerTerritories = playerTerritories;
-	std::sort(sortedPlayerTerritories.begin(), sortedPlayerTerritories.end(), [](const Territory* lhs, const Territory* rhs) {
-		return lhs->getID() < rhs->getID();
-		});
-
-	//Iterate through each territory
-	int currentContinentID = sortedPlayerTerritories.at(0)->getContinent(); // Get the minimum territory id
-	int territoryToContinentCount = 0; //Variable to count territories belonging to one continent
-	std::vector<Continent*> mapContinents = map->listContinents;
-	for (Territory* t : sortedPlayerTerritories) {
-
-		/*
-		Reset territoryToContinentCount if the current territory's continent id
-		is different from the previous territory
-		*/
-		if (t->getContinent() != currentContinentID) {
-			currentContinentID = t->getContinent();
-			territoryToContinentCount = 1;
-		}
-		else {
-			territoryToContinentCount++; //Increment territoryToContinentCount
-		}
-
-		/*
-		Verify if the territoryToContinentCount is equal to the size of the
-		continent's country list size. If so, add bonus armies to reinforcement pool
-		*/
-		Continent* c = mapContinents.at(currentContinentID - 1);
-		int numCountries = c->getCountryList()->size();
-		if (territoryToContinentCount == numCountries) {
-			std::cout << "BONUS: Adding " << c->getArmyValu() << " armies to reinforcement pool\n";
-			currentRPool = currentRPool + c->getArmyValu();
-			territoryToContinentCount = 0;
-			currentContinentID++;
-		}
-	}//end for loop
-
-	p->setReinforcementPool(currentRPool); //Update new reinforcement pool
-	std::cout << p->getPlayerName() << "\'s reinforcement pool: " << currentRPool << "\n" << std::endl;
+const std::vector<Territory*> GameEngine::GetEnemyTerritoriesOfCurrentPlayer(Player* p)
+{
+	return getGameContext().GetEnemyTerritoriesOfCurrentPlayer(p);
 }
 
-const std::vector<Territory*> GameEngine::GetEnemyTerritoriesOfCurrentPlayer(Player* p)
+void GameEngine::setOutputSink(std::unique_ptr<OutputSink> inSink)
 {
-	std::vector<Territory*> allEnemyTerritories;
-	std::vector<Player*> allPlayers = getPlayerList();
-	for (auto& enemy : allPlayers)
-	{
-		allEnemyTerritories.insert(
-			allEnemyTerritories.end(),
-			enemy->getTerritoriesOwned().begin(),
-			enemy->getTerritoriesOwned().end()
-		);
-	}
+	getGameContext().setOutputSink(std::move(inSink));
+}
 
-	return allEnemyTerritories;
+OutputSink& GameEngine::getOutputSink()
+{
+	return getGameContext().getOutputSink();
 }
 
-/*
-* Issue players orders and place them in their order list
-*
-* @param *p pointer to a Player object
-*/
-const void GameEngine::issueOrdersPhase(Player* p, Map* map) {
-	p->issueOrder();
+std::ostream& GameEngine::getOutput()
+{
+	return getGameContext().getOutput();
 }
 
-/*
-* Execute player orders
-*
-* @param *p pointer to a Player object
-*/
-const void GameEngine::executeOrdersPhase(Player* p) {
-	std::cout << "Executing " << p->getPlayerName() << "\'s orders\n";
-	OrdersList* ol = p->getOrders();
-
-	/*
-	Loop player orders for deploy orders and execute them
-	*/
-	for (int i = 0; i < ol->getOList().size(); i++) {
-		Order* o = ol->get(i);
-		if (o->getType() == EOrderType::Deploy) {
-			o->execute();
-		}
-	}
+GameRandom& GameEngine::getRandom()
+{
+	return getGameContext().getRandom();
+}
 
-	/*
-	Loop player orders and execute remaining orders
-	*/
-	for (Order* o : ol->getOList()) {
-		if (o->getType() != EOrderType::Deploy) {
-			o->execute();
-		}
-		ol->remove(0);
-	}
+void GameEngine::setRandomSeed(uint64 inSeed)
+{
+	getGameContext().setRandomSeed(inSeed);
 }
 
 const std::vector<Player*>& GameEngine::getPlayerList() const
 {
-	return this->playerlist;
+	// an engine that never played has no players
+	static const std::vector<Player*> noPlayers;
+	return _game != nullptr ? _game->getPlayerList() : noPlayers;
 }
 
 std::vector<Player*>& GameEngine::getPlayerList()
 {
-	return this->playerlist;
+	return getGameContext().getPlayerList();
 }
 
 /*
@@ -969,107 +826,81 @@ void GameEngine::setIsATournament(bool tournamentValue) {
 * @return: void
 */
 void GameEngine::TournamentMode(std::string M, std::string P, int G, int D) {
+	std::ostream& out = getOutput();
 	this->numberGamePrint = G;
 	this->drawTurnLimitPrint = D;
 	// create map list
-	MapLoader* newmap = new MapLoader();
-	Map* map = new Map();
-	std::vector<Map*> maps;
+	// maps seen by an earlier tournament come from the shared cache without being parsed again
+	MapLoader& loader = getMapLoader();
+	Map* map = nullptr;
+	std::vector<const Map*> maps;
+	std::vector<std::string> mapNames;
 	listMapName = splitString(M);
-	int nbGameFromMap = listMapName.size();
 	
-	for (int x = 0; x < listMapName.size(); x++) {
-		if (newmap->loadMap(listMapName.at(x))) {
-			map = newmap->getListMap()->at(x);
-			maps.push_back(map);
+	// all the maps are parsed and validated at the same time, the results come back in the order they were asked for
+	std::vector<MapLoadResult> loadResults;
+	loader.loadMaps(listMapName, loadResults);
+	for (int x = 0; x < loadResults.size(); x++) {
+		out << "Map " << x << " (" << loadResults.at(x).fileName << "): " << MapLoader::getLoadStatusName(loadResults.at(x).status) << "\n";
+		map = loadResults.at(x).map;
+		std::string mapName = loadResults.at(x).fileName;
+		if (map == nullptr) {
+			out << "The map in invalid the default one will be use insted.\n ";
+			mapName = "canada";
+			if (loader.loadMap(mapName)) {
+				map = loader.getListMap()->back();
+			}
 		}
-		else {
-			std::cout << "The map in invalid the default one will be use insted.\n ";
-			newmap->MapLoader::loadMap("canada");
-			map = newmap->getListMap()->at(0);
+		if (map != nullptr) {
 			maps.push_back(map);
+			mapNames.push_back(mapName);
 		}
 	}
-	/*
-	//map1
-	newmap->MapLoader::loadMap("canada");
-	map = newmap->getListMap()->at(0);
-	maps.push_back(map);
-	//map2
-	newmap->MapLoader::loadMap("caribbean");
-	map = newmap->getListMap()->at(0);
-	maps.push_back(map);
-	//map3
-	newmap->MapLoader::loadMap("chutes");
-	map = newmap->getListMap()->at(0);
-	maps.push_back(map);
-	//map4
-	newmap->MapLoader::loadMap("myImortal");
-	map = newmap->getListMap()->at(0);
-	maps.push_back(map);
-	//map5
-	newmap->MapLoader::loadMap("simpsons_world");
-	map = newmap->getListMap()->at(0);
-	maps.push_back(map);
-	*/
 	listPlayerFromConsole = splitString(P);
-	Player* p = nullptr;
-	std::string playerName;
-	for (int y = 0; y < listPlayerFromConsole.size(); y++) {
-		playerName = "player " + std::to_string(y);
-		if (listPlayerFromConsole.at(y) == "Human") {
-			
-			p = new Player(playerName);
-			p->setPlayerStrategy(new HumanPlayerStrategy(p));
-		}
-		if (listPlayerFromConsole.at(y) == "Aggressive") {
-			p = new Player(new AggressivePlayerStrategy(), playerName);
-		}
-		if (listPlayerFromConsole.at(y) == "Benevolent") {
-			p = new Player(new BenevolentPlayerStrategy(), playerName);
-		}
-		if (listPlayerFromConsole.at(y) == "Neutral") {
-			p = new Player(new NeutralPlayerStrategy(), playerName);
+
+	// every game plays on its own copy of its map with its own players, the loaded maps are only read
+	TournamentScheduler scheduler(_tournamentThreadCount);
+	scheduler.setMaps(maps);
+	scheduler.setMapNames(mapNames);
+	scheduler.setStrategies(listPlayerFromConsole);
+	scheduler.setGamesPerMap(G);
+	scheduler.setMaxTurns(D);
+	// each game gets a seed of its own derived from this one, replaying one game needs only its seed
+	scheduler.setSeed(getRandom().getSeed());
+	scheduler.setKeepLogs(getOutputSink().isEnabled());
+	scheduler.setCheckpointDirectory(_tournamentCheckpointDirectory);
+	scheduler.setReplayDirectory(_tournamentReplayDirectory);
+	out << "Tournament seed: " << scheduler.getSeed() << " on " << scheduler.getThreadCount() << " threads\n";
+
+	// results come back in map then game order whatever thread played them
+	gameresult = "Result :\n";
+	scheduler.run([this, &out, G](const TournamentGameResult& inResult)
+	{
+		out << inResult.log;
+		if (inResult.gameIndex == 0) {
+			gameresult = gameresult + "Map " + std::to_string(inResult.mapIndex) + " : ";
 		}
-		if (listPlayerFromConsole.at(y) == "Cheater") {
-			p = new Player(new CheaterPlayerStrategy(), playerName);
+		gameresult = gameresult + "      " + inResult.winner;
+		if (inResult.gameIndex == G - 1) {
+			gameresult = gameresult + "\n";
 		}
+	});
+	out << gameresult;
+	getOutputSink().flush();
+	setCurrentState(GAME_STATE_FINISHED);
+}//end of TournamentMode
 
-		p->setCurrentGameInstance(this);
-		playerlist.push_back(p);
-		
-	}
-	playercount = playerlist.size();
-
-	// create current player list
-	std::vector<Player*> currentPlayerlist;
-	for (int i = 0; i < 2/*P*/; i++)
-	{
-		currentPlayerlist.push_back(playerlist.at(i));
-	}
+void GameEngine::setTournamentThreadCount(int32 inThreadCount)
+{
+	_tournamentThreadCount = inThreadCount;
+}
 
+void GameEngine::setTournamentCheckpointDirectory(std::string inDirectory)
+{
+	_tournamentCheckpointDirectory = std::move(inDirectory);
+}
 
-	Map* currentMap = nullptr;
-	// outer loop for listofmapfiles
-	std::string gameresult = "Result :\n";
-	std::string winner = "";
-	for (int i = 0; i < nbGameFromMap; i++) {
-		currentMap = maps.at(i);
-		mapToUse = currentMap;
-		gameresult = "Map " + std::to_string(i) + " : ";
-		// inner loop for numberofgames
-		
-		for (int j = 0; j < G; j++) {
-			for (int i = 0; i < 2/*P*/; i++) {
-				currentPlayerlist.push_back(playerlist.at(i));
-			}
-			GameEngine::gamestart();
-			/*winner =*/mainGameLoop(currentPlayerlist, currentMap, D);
-
-			gameresult = gameresult + "      " + winner;
-			currentPlayerlist.clear();
-		}//end of inner loop
-		gameresult = gameresult + "\n";
-	}//end of outer loop
-	setCurrentState(GAME_STATE_FINISHED);
-}//end of TournamentMode
+void GameEngine::setTournamentReplayDirectory(std::string inDirectory)
+{
+	_tournamentReplayDirectory = std::move(inDirectory);
+}
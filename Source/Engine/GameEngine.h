@@ -1,16 +1,22 @@
 #pragma once
 #include <iostream>
 #include <list>
+#include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "../GameLog/LoggingObserver.h"
+#include "Common/CommonTypes.h"
+#include "Common/OutputSink.h"
+#include "Common/GameRandom.h"
 
 class Territory;
 class Player;
 class Map;
-class Deck;
 class CommandProcessor;
+class GameContext;
+class MapLoader;
 
 //game state
 enum GameState
@@ -61,6 +67,8 @@ public:
     void setNeutralPlayer(std::string inNeutralPlName);
     const std::vector<Player*>& getPlayerList() const;
     std::vector<Player*>& getPlayerList();
+    // player of this game called inName, nullptr if there is none
+    Player* findPlayer(std::string_view inName) const;
 
     std::string mainGameLoop(std::vector<Player*> players, Map* map, int maxNumberOfTurns); //Game loop function
 
@@ -71,25 +79,59 @@ public:
 
     bool getIsATournament();
     void setIsATournament(bool tournamentValue);
+    // threads the games of a tournament are played on, below 1 uses one per hardware core
+    void setTournamentThreadCount(int32 inThreadCount);
+    // directory the games of a tournament save their checkpoints to and resume from, empty for none
+    void setTournamentCheckpointDirectory(std::string inDirectory);
+    // directory the games of a tournament write their .wzreplay order logs to, empty for none
+    void setTournamentReplayDirectory(std::string inDirectory);
+
+    // the game played by startupPhase, made the first time it is needed
+    GameContext& getGameContext();
+
+    // writes the game of the engine, between two turns, to a .wzsave checkpoint at inPath
+    bool saveCheckpoint(const std::string& inPath);
+    // replaces the game of the engine with the one saved at inPath, on a new copy of the map it was played on
+    bool loadCheckpoint(const std::string& inPath);
+    // plays on from the turn the game of the engine is at, after loadCheckpoint
+    std::string resumeGame(int maxNumberOfTurns);
+    // saves the game of the engine to inPath after every turn it plays, an empty path stops saving
+    void setCheckpointFile(std::string inPath);
+    // plays again the game recorded at inPath, from its orders alone, on a new copy of the map it was played on.
+    // The replayed game becomes the game of the engine.
+    bool replayGame(const std::string& inPath);
 
     const std::vector<Territory*> GetEnemyTerritoriesOfCurrentPlayer(Player* p);
+
+    // where the narration of the game goes, the console unless another sink is set.
+    // A tournament narrates its games there in the order they were set up.
+    void setOutputSink(std::unique_ptr<OutputSink> inSink);
+    OutputSink& getOutputSink();
+    std::ostream& getOutput();
+
+    // random numbers of the game of the engine, one stream per subsystem
+    GameRandom& getRandom();
+    // makes the next games play out the same as the ones started from inSeed.
+    // A tournament derives the seed of each of its games from the seed it starts with.
+    void setRandomSeed(uint64 inSeed);
 private:
     GameState* eState;
     void setCurrentState(GameState eState);
-    const void reinforcementPhase(Player* p, Map* m);
-    /* issueOrdersPhase methods */
-    // issueOrdersPhase
-    const void issueOrdersPhase(Player* p, Map* map);
-    const void executeOrdersPhase(Player* p);
-    void gamestart();
+    MapLoader& getMapLoader();
+    // makes inGame save itself to _checkpointFile at the end of every turn
+    void watchCheckpointFile(GameContext& inGame);
     std::string extractName(std::string);//extract name from loadmap and addplayer command
     std::string extractPlayerStrategy(std::string str);
     void addPlayer(std::string);//add player
 
-    Deck* _deck = nullptr;
-
-    std::vector<Player*> playerlist;
-    Player* neutralPlayer = nullptr;
+    // map, players and deck of the game, a tournament gives each of its games a context of its own
+    std::unique_ptr<GameContext> _game;
+    std::unique_ptr<MapLoader> _mapLoader;
+    std::string _mapFileName;
+    std::string _checkpointFile;
 
     bool isATournament; //Determines if a game is part of a tournament
+    int32 _tournamentThreadCount = 0;
+    std::string _tournamentCheckpointDirectory;
+    std::string _tournamentReplayDirectory;
 };
@@ -0,0 +1,475 @@
+#include "Engine/GameReplay.h"
+#include "Engine/GameContext.h"
+#include "Engine/TournamentScheduler.h"
+#include "Player/Player.h"
+#include "Cards/Cards.h"
+#include "Map/map.h"
+#include "Map/MapGraph.h"
+#include "Order/Orders.h"
+#include "Common/GameRandom.h"
+#include "Common/Hash.h"
+#include "Common/MappedFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <list>
+
+namespace
+{
+	const char WzReplayMagic[4] = { 'W', 'Z', 'R', 'P' };
+
+	uint32 edgeCountOf(const Map& inMap)
+	{
+		return inMap.hasGraph() ? static_cast<uint32>(inMap.getGraph().getEdgeCount()) : 0;
+	}
+
+	// what a replay has to end on: the owners and armies of every territory and the cards of every player
+	uint64 hashState(const GameContext& inGame)
+	{
+		const TerritoryState& state = inGame.getMap()->getState();
+		const std::size_t size = static_cast<std::size_t>(state.getTerritoryCount()) * sizeof(int32);
+		const uint64 owners = Hash::fnv1a(state.getOwners().data(), size);
+		uint64 hash = Hash::fnv1a(state.getArmies().data(), size, owners);
+		for (const Player* player : inGame.getPlayerList())
+		{
+			const uint64 id = player->getPlayerID();
+			hash = Hash::fnv1a(&id, sizeof(id), hash);
+			const Hand* hand = player->getCurrentHand();
+			if (hand == nullptr)
+			{
+				continue;
+			}
+			for (const Card* card : hand->getHand())
+			{
+				const uint8 cardType = static_cast<uint8>(card->getCardType());
+				hash = Hash::fnv1a(&cardType, sizeof(cardType), hash);
+			}
+		}
+		return hash;
+	}
+
+	// gives inHand the cards of inCardTypes in that order, in place of the ones it holds
+	void setHand(Hand& inHand, const std::vector<uint8>& inCardTypes)
+	{
+		while (!inHand.getHand().empty())
+		{
+			delete inHand.drawCard_Hand();
+		}
+		for (const uint8 cardType : inCardTypes)
+		{
+			inHand.insertCard_Hand(new Card(static_cast<ECardTypes>(cardType)));
+		}
+	}
+
+	// moves inTerritory to inNewOwner the way a strategy taking it without an order does
+	void takeTerritory(Territory* inTerritory, Player* inNewOwner)
+	{
+		Player* previousOwner = inTerritory->getPlayer();
+		if (previousOwner != nullptr)
+		{
+			std::vector<Territory*>& owned = previousOwner->getTerritoriesOwned();
+			std::vector<Territory*>::iterator found = std::find(owned.begin(), owned.end(), inTerritory);
+			if (found != owned.end())
+			{
+				owned.erase(found);
+			}
+		}
+		inTerritory->setPlayer(inNewOwner);
+		inNewOwner->getTerritoriesOwned().push_back(inTerritory);
+	}
+}
+
+GameReplayRecorder::GameReplayRecorder()
+{
+}
+
+GameReplayRecorder::~GameReplayRecorder()
+{
+	detach();
+}
+
+const std::string& GameReplayRecorder::getError() const
+{
+	return _error;
+}
+
+void GameReplayRecorder::attach(GameContext& inGame)
+{
+	detach();
+	_game = &inGame;
+	_setup.clear();
+	_phases.clear();
+	_phaseCount = 0;
+
+	// the game is not started yet, the players are still in the order they joined
+	BinaryWriter writer(_setup);
+	writer.writeString(inGame.getMapName());
+	writer.writeUInt64(inGame.getRandom().getSeed());
+	const std::vector<Player*>& players = inGame.getPlayerList();
+	writer.writeVarUInt(players.size());
+	for (const Player* player : players)
+	{
+		writer.writeVarUInt(player->getPlayerID());
+		writer.writeString(player->getPlayerNameView());
+		writer.writeString(TournamentScheduler::getStrategyName(player->getPlayerStrategy()));
+	}
+
+	inGame.setOrderSource([this](GameContext& inTurnGame, Player& inPlayer)
+	{
+		recordOrders(inTurnGame, inPlayer);
+	});
+}
+
+void GameReplayRecorder::detach()
+{
+	if (_game != nullptr)
+	{
+		_game->setOrderSource(nullptr);
+		_game = nullptr;
+	}
+}
+
+void GameReplayRecorder::recordOrders(GameContext& inGame, Player& inPlayer)
+{
+	// a strategy can take territories during its issue phase without giving an order, the cheater does
+	TerritoryState& state = inGame.getMap()->getState();
+	_taken.clear();
+	// it can play cards as well, shuffling the hand and deleting the cards it played
+	Hand* hand = inPlayer.getCurrentHand();
+	_handBefore.clear();
+	if (hand != nullptr)
+	{
+		_handBefore = hand->getHand();
+	}
+	state.setOwnerJournal(&_taken);
+	inPlayer.issueOrder();
+	state.setOwnerJournal(nullptr);
+
+	BinaryWriter writer(_phases);
+	writer.writeVarUInt(static_cast<uint64>(inGame.getTurn()));
+	writer.writeVarUInt(inPlayer.getPlayerID());
+	writer.writeVarUInt(_taken.size());
+	for (const int32 territory : _taken)
+	{
+		const Player* owner = state.getOwnerPlayer(territory);
+		writer.writeVarInt(territory);
+		writer.writeVarInt(owner != nullptr ? static_cast<int64>(owner->getPlayerID()) : -1);
+	}
+
+	// the strategy does not add cards, a hand holding the same cards in the same order is unchanged
+	const bool bHandChanged = hand != nullptr && hand->getHand() != _handBefore;
+	writer.writeUInt8(bHandChanged ? 1 : 0);
+	if (bHandChanged)
+	{
+		writer.writeVarUInt(hand->getHand().size());
+		for (const Card* card : hand->getHand())
+		{
+			writer.writeUInt8(static_cast<uint8>(card->getCardType()));
+		}
+	}
+
+	// the orders are still waiting for the execute phase
+	const std::list<Order*> orders = inPlayer.getOrders() != nullptr ? inPlayer.getOrders()->getOList() : std::list<Order*>();
+	writer.writeVarUInt(orders.size());
+	OrderRecord record;
+	for (const Order* order : orders)
+	{
+		order->getRecord(record);
+		writer.writeUInt8(static_cast<uint8>(record.type));
+		writer.writeVarInt(record.source);
+		writer.writeVarInt(record.target);
+		writer.writeVarInt(record.armies);
+	}
+	_phaseCount++;
+}
+
+bool GameReplayRecorder::write(const GameContext& inGame, std::vector<char>& outData)
+{
+	_error.clear();
+	const Map* map = inGame.getMap();
+	if (map == nullptr || _setup.empty())
+	{
+		_error = "nothing was recorded";
+		return false;
+	}
+
+	outData.clear();
+	outData.resize(sizeof(WzReplayHeader));
+	BinaryWriter writer(outData);
+	writer.writeBytes(_setup.data(), _setup.size());
+	writer.writeVarUInt(static_cast<uint64>(inGame.getTurn()));
+	writer.writeUInt64(hashState(inGame));
+	writer.writeVarUInt(_phaseCount);
+	writer.writeBytes(_phases.data(), _phases.size());
+
+	const std::size_t payloadSize = outData.size() - sizeof(WzReplayHeader);
+	WzReplayHeader header;
+	std::memcpy(header.magic, WzReplayMagic, sizeof(WzReplayMagic));
+	header.version = Version;
+	header.byteOrder = ByteOrderMark;
+	header.checksum = Hash::fnv1a(outData.data() + sizeof(WzReplayHeader), payloadSize);
+	header.territoryCount = static_cast<uint32>(map->getState().getTerritoryCount());
+	header.edgeCount = edgeCountOf(*map);
+	header.payloadSize = payloadSize;
+	std::memcpy(outData.data(), &header, sizeof(header));
+	return true;
+}
+
+bool GameReplayRecorder::writeFile(const GameContext& inGame, const std::string& inPath)
+{
+	std::vector<char> data;
+	if (!write(inGame, data))
+	{
+		return false;
+	}
+
+	std::ofstream output(inPath, std::ios::binary | std::ios::trunc);
+	if (!output)
+	{
+		_error = "cannot create " + inPath;
+		return false;
+	}
+	output.write(data.data(), static_cast<std::streamsize>(data.size()));
+	if (!output)
+	{
+		_error = "cannot write " + inPath;
+		return false;
+	}
+	return true;
+}
+
+GameReplayer::GameReplayer()
+{
+}
+
+const std::string& GameReplayer::getError() const
+{
+	return _error;
+}
+
+bool GameReplayer::fail(const std::string& inError)
+{
+	_error = inError;
+	return false;
+}
+
+const std::string& GameReplayer::getMapName() const
+{
+	return _mapName;
+}
+
+int32 GameReplayer::getTurnCount() const
+{
+	return _turnCount;
+}
+
+bool GameReplayer::load(const char* inData, std::size_t inSize)
+{
+	_error.clear();
+	_data.clear();
+	_players.clear();
+	if (inSize < sizeof(WzReplayHeader))
+	{
+		return fail("the data is too small to be a replay");
+	}
+	std::memcpy(&_header, inData, sizeof(_header));
+	if (std::memcmp(_header.magic, WzReplayMagic, sizeof(WzReplayMagic)) != 0)
+	{
+		return fail("the data is not a replay");
+	}
+	if (_header.byteOrder == SwappedByteOrderMark)
+	{
+		return fail("the replay was written on a machine of the other byte order");
+	}
+	if (_header.version != GameReplayRecorder::Version || _header.byteOrder != ByteOrderMark)
+	{
+		return fail("the replay was written by another version");
+	}
+	if (_header.payloadSize != inSize - sizeof(_header))
+	{
+		return fail("the replay size does not match its header");
+	}
+	const char* payload = inData + sizeof(_header);
+	if (Hash::fnv1a(payload, _header.payloadSize) != _header.checksum)
+	{
+		return fail("the replay is corrupt");
+	}
+
+	BinaryReader reader(payload, static_cast<std::size_t>(_header.payloadSize));
+	_mapName = reader.readString();
+	_seed = reader.readUInt64();
+	const std::size_t playerCount = reader.readCount(reader.getRemaining());
+	_players.resize(playerCount);
+	for (RecordedPlayer& player : _players)
+	{
+		player.id = reader.readVarUInt();
+		player.name = reader.readString();
+		player.strategy = reader.readString();
+	}
+	_turnCount = static_cast<int32>(reader.readVarUInt());
+	_stateHash = reader.readUInt64();
+	_phaseCount = reader.readVarUInt();
+	if (!reader.isValid())
+	{
+		return fail("the replay is truncated");
+	}
+
+	// the phases are read as the game asks for them
+	_data.assign(payload, payload + _header.payloadSize);
+	_phasesOffset = reader.getPosition();
+	return true;
+}
+
+bool GameReplayer::loadFile(const std::string& inPath)
+{
+	MappedFile file;
+	if (!file.open(inPath))
+	{
+		return fail("cannot open " + inPath);
+	}
+	return load(file.getData(), file.getSize());
+}
+
+bool GameReplayer::replay(GameContext& inGame, std::string& outWinner)
+{
+	_error.clear();
+	if (_data.empty())
+	{
+		return fail("no replay is loaded");
+	}
+	Map* map = inGame.getMap();
+	if (map == nullptr)
+	{
+		return fail("the game has no map to replay on");
+	}
+	if (_header.territoryCount != static_cast<uint32>(map->getState().getTerritoryCount()) || _header.edgeCount != edgeCountOf(*map))
+	{
+		return fail("the replay was recorded on another map");
+	}
+	if (!inGame.getPlayerList().empty())
+	{
+		return fail("the game to replay on already has players");
+	}
+
+	// the same seed and players joining in the same order set the game up as it was
+	inGame.setMapName(_mapName);
+	inGame.setRandomSeed(_seed);
+	for (const RecordedPlayer& recorded : _players)
+	{
+		Player* player = recorded.strategy.empty() ? new Player(recorded.name) : TournamentScheduler::createPlayer(recorded.strategy, recorded.name);
+		if (player == nullptr)
+		{
+			return fail("unknown strategy " + recorded.strategy);
+		}
+		inGame.registerPlayer(player);
+		if (player->getPlayerID() != recorded.id)
+		{
+			return fail("the players of the replay are numbered differently");
+		}
+	}
+
+	_phases = BinaryReader(_data.data() + _phasesOffset, _data.size() - _phasesOffset);
+	_phasesPlayed = 0;
+	bStrayed = false;
+	inGame.setOrderSource([this](GameContext& inTurnGame, Player& inPlayer)
+	{
+		issueRecordedOrders(inTurnGame, inPlayer);
+	});
+	inGame.startGame();
+	outWinner = inGame.playGame(inGame.getPlayerList(), _turnCount);
+	inGame.setOrderSource(nullptr);
+
+	if (bStrayed)
+	{
+		return false;
+	}
+	if (_phasesPlayed != _phaseCount || !_phases.isAtEnd())
+	{
+		return fail("the game ended before the replay did");
+	}
+	if (inGame.getTurn() != _turnCount || hashState(inGame) != _stateHash)
+	{
+		return fail("the game ended on another state than the recorded one");
+	}
+	return true;
+}
+
+void GameReplayer::issueRecordedOrders(GameContext& inGame, Player& inPlayer)
+{
+	// once the game strays its players issue nothing, the turns left go by quickly
+	if (bStrayed)
+	{
+		return;
+	}
+
+	const uint64 turn = _phases.readVarUInt();
+	const uint64 playerID = _phases.readVarUInt();
+	if (!_phases.isValid() || turn != static_cast<uint64>(inGame.getTurn()) || playerID != inPlayer.getPlayerID())
+	{
+		bStrayed = true;
+		fail("turn " + std::to_string(inGame.getTurn() + 1) + " of " + inPlayer.getPlayerName() + " was not recorded");
+		return;
+	}
+
+	Map* map = inGame.getMap();
+	const int32 territoryCount = map->getState().getTerritoryCount();
+	const std::size_t takenCount = _phases.readCount(static_cast<std::size_t>(territoryCount));
+	for (std::size_t i = 0; i < takenCount; i++)
+	{
+		const int64 territory = _phases.readVarInt();
+		Player* newOwner = inGame.findPlayerByID(_phases.readVarInt());
+		if (territory < 0 || territory >= territoryCount || newOwner == nullptr)
+		{
+			bStrayed = true;
+			fail("a territory taken on turn " + std::to_string(inGame.getTurn() + 1) + " is not in the game");
+			return;
+		}
+		takeTerritory(map->getTerritoryByIndex(static_cast<int32>(territory)), newOwner);
+	}
+
+	if (_phases.readUInt8() != 0)
+	{
+		const std::size_t cardCount = _phases.readCount(_phases.getRemaining());
+		_cardTypes.resize(cardCount);
+		for (uint8& cardType : _cardTypes)
+		{
+			cardType = _phases.readUInt8();
+			if (cardType > static_cast<uint8>(ECardTypes::Diplomacy))
+			{
+				bStrayed = true;
+				fail("a card played on turn " + std::to_string(inGame.getTurn() + 1) + " is of an unknown type");
+				return;
+			}
+		}
+		if (!_phases.isValid() || inPlayer.getCurrentHand() == nullptr)
+		{
+			bStrayed = true;
+			fail("the hand of " + inPlayer.getPlayerName() + " on turn " + std::to_string(inGame.getTurn() + 1) + " does not fit the game");
+			return;
+		}
+		setHand(*inPlayer.getCurrentHand(), _cardTypes);
+	}
+
+	const std::size_t orderCount = _phases.readCount(_phases.getRemaining());
+	OrderRecord record;
+	record.owner = static_cast<int32>(inPlayer.getPlayerID());
+	for (std::size_t i = 0; i < orderCount; i++)
+	{
+		const uint8 type = _phases.readUInt8();
+		record.type = static_cast<EOrderType>(type);
+		record.source = static_cast<int32>(_phases.readVarInt());
+		record.target = static_cast<int32>(_phases.readVarInt());
+		record.armies = static_cast<int32>(_phases.readVarInt());
+		Order* order = type <= static_cast<uint8>(EOrderType::Negotiate) && _phases.isValid() ? Order::createFromRecord(record, inGame) : nullptr;
+		if (order == nullptr)
+		{
+			bStrayed = true;
+			fail("an order of turn " + std::to_string(inGame.getTurn() + 1) + " does not fit the game");
+			return;
+		}
+		inPlayer.getOrders()->add(order);
+	}
+	_phasesPlayed++;
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Common/BinaryStream.h"
+#include "Common/CommonTypes.h"
+
+class Card;
+class GameContext;
+class Player;
+
+/*
+	Layout of a .wzreplay file, a header then the var ints and strings of a BinaryWriter.
+	The header and the fixed size values are in the byte order of the machine that wrote them,
+	the header holds ByteOrderMark so a machine of the other byte order rejects the file:
+		WzReplayHeader
+		map name, seed, every player in the order it joined: id, name, strategy
+		turns played, hash of the owners, armies and hands the game ended on
+		issue phases recorded, then each of them in the order they were played:
+			turn, player id, territories the player took without an order (index, new owner id),
+			1 and the card types left in the hand when the player played cards, 0 when it did not,
+			orders issued (EOrderType, source, target, armies as in OrderRecord)
+	Players are written by id and territories by dense index, a replay can only be played on the
+	map it was recorded on. The checksum covers the payload.
+*/
+struct WzReplayHeader
+{
+	char magic[4];
+	uint16 version;
+	uint16 byteOrder;
+	uint64 checksum;
+	uint32 territoryCount;
+	uint32 edgeCount;
+	uint64 payloadSize;
+};
+
+static_assert(sizeof(WzReplayHeader) == 32, "the .wzreplay header layout changed");
+
+/*
+	Summary: Records the orders every player issues in a game, to play it again with GameReplayer.
+	The recorder takes the place of the order source of the game and runs the strategies itself,
+	writing down each order as an OrderRecord, the territories a strategy takes without one and
+	the hand it is left with when it played cards.
+	Everything else a turn does follows from the seed and these orders.
+*/
+class GameReplayRecorder {
+public:
+	static constexpr uint16 Version = 3;
+
+	GameReplayRecorder();
+	~GameReplayRecorder();
+
+	GameReplayRecorder(const GameReplayRecorder&) = delete;
+	GameReplayRecorder& operator=(const GameReplayRecorder&) = delete;
+
+	// starts recording inGame, which has its map, seed and players set and has not been started yet
+	void attach(GameContext& inGame);
+	// stops recording, the game goes back to its strategies. Done by the destructor as well.
+	void detach();
+
+	// the replay of what was recorded of inGame, best written once the game is over
+	bool write(const GameContext& inGame, std::vector<char>& outData);
+	bool writeFile(const GameContext& inGame, const std::string& inPath);
+
+	const std::string& getError() const;
+
+private:
+	// runs the strategy of inPlayer and records what it did
+	void recordOrders(GameContext& inGame, Player& inPlayer);
+
+	GameContext* _game = nullptr;
+	// map name, seed and players, written when attached before the strategies change anything
+	std::vector<char> _setup;
+	std::vector<char> _phases;
+	uint64 _phaseCount = 0;
+	std::vector<int32> _taken;
+	std::vector<Card*> _handBefore;
+	std::string _error;
+};
+
+/*
+	Summary: Plays a recorded game again without running any strategy.
+	Every player issues the orders it issued in the recording, they go through the usual turns and
+	Order::execute, and the seed gives back the same cards and combat rolls. Nothing is computed
+	to choose the orders, so a replay takes a fraction of the time the game took.
+*/
+class GameReplayer {
+public:
+	GameReplayer();
+
+	bool load(const char* inData, std::size_t inSize);
+	bool loadFile(const std::string& inPath);
+
+	// map the game was recorded on, to load it before replaying
+	const std::string& getMapName() const;
+	int32 getTurnCount() const;
+
+	// plays the loaded game on inGame, a new context with the map of the recording set and no player.
+	// outWinner is what playGame returned. False when the game strays from the recording.
+	bool replay(GameContext& inGame, std::string& outWinner);
+
+	const std::string& getError() const;
+
+private:
+	struct RecordedPlayer
+	{
+		uint64 id = 0;
+		std::string name;
+		std::string strategy;
+	};
+
+	bool fail(const std::string& inError);
+	// gives inPlayer the orders of the next recorded issue phase
+	void issueRecordedOrders(GameContext& inGame, Player& inPlayer);
+
+	std::vector<char> _data;
+	WzReplayHeader _header = {};
+	std::string _mapName;
+	uint64 _seed = 0;
+	std::vector<RecordedPlayer> _players;
+	int32 _turnCount = 0;
+	uint64 _stateHash = 0;
+	uint64 _phaseCount = 0;
+	std::size_t _phasesOffset = 0;
+
+	BinaryReader _phases{ nullptr, 0 };
+	uint64 _phasesPlayed = 0;
+	std::vector<uint8> _cardTypes;
+	bool bStrayed = false;
+	std::string _error;
+};
@@ -0,0 +1,352 @@
+#include "Engine/TournamentScheduler.h"
+#include "Engine/GameContext.h"
+#include "Engine/GameCheckpoint.h"
+#include "Engine/GameReplay.h"
+#include "Player/Player.h"
+#include "Map/map.h"
+#include "Strategy/PlayerStrategies.h"
+#include "Common/GameRandom.h"
+#include "Common/OutputSink.h"
+#include "Common/ThreadPool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+
+namespace
+{
+	// games of a batch per thread, enough to keep every thread busy until the batch ends
+	constexpr int32 GamesPerThreadInBatch = 4;
+}
+
+TournamentScheduler::TournamentScheduler(int32 inThreadCount)
+	: _threadCount(inThreadCount < 1 ? ThreadPool::getDefaultThreadCount() : inThreadCount)
+{
+}
+
+void TournamentScheduler::setMaps(std::vector<const Map*> inMaps)
+{
+	_maps = std::move(inMaps);
+}
+
+void TournamentScheduler::setMapNames(std::vector<std::string> inMapNames)
+{
+	_mapNames = std::move(inMapNames);
+}
+
+void TournamentScheduler::setStrategies(std::vector<std::string> inStrategies)
+{
+	_strategies = std::move(inStrategies);
+}
+
+void TournamentScheduler::setGamesPerMap(int32 inGamesPerMap)
+{
+	_gamesPerMap = std::max(inGamesPerMap, 0);
+}
+
+int32 TournamentScheduler::getGamesPerMap() const
+{
+	return _gamesPerMap;
+}
+
+void TournamentScheduler::setMaxTurns(int32 inMaxTurns)
+{
+	_maxTurns = inMaxTurns;
+}
+
+void TournamentScheduler::setSeed(uint64 inSeed)
+{
+	_seed = inSeed;
+}
+
+uint64 TournamentScheduler::getSeed() const
+{
+	return _seed;
+}
+
+void TournamentScheduler::setKeepLogs(bool bInKeepLogs)
+{
+	bKeepLogs = bInKeepLogs;
+}
+
+void TournamentScheduler::setCheckpointDirectory(std::string inDirectory)
+{
+	_checkpointDirectory = std::move(inDirectory);
+}
+
+void TournamentScheduler::setReplayDirectory(std::string inDirectory)
+{
+	_replayDirectory = std::move(inDirectory);
+}
+
+int32 TournamentScheduler::getGameCount() const
+{
+	return static_cast<int32>(_maps.size()) * _gamesPerMap;
+}
+
+int32 TournamentScheduler::getThreadCount() const
+{
+	// a human answers on the console, two of its games cannot ask at the same time
+	if (std::find(_strategies.begin(), _strategies.end(), "Human") != _strategies.end())
+	{
+		return 1;
+	}
+	return _threadCount;
+}
+
+void TournamentScheduler::run(const std::function<void(const TournamentGameResult&)>& inOnResult) const
+{
+	const int32 gameCount = getGameCount();
+	if (gameCount == 0)
+	{
+		return;
+	}
+
+	ThreadPool pool(std::min(getThreadCount(), gameCount));
+	const int32 batchSize = pool.getThreadCount() * GamesPerThreadInBatch;
+	std::vector<TournamentGameResult> batch;
+
+	for (int32 first = 0; first < gameCount; first += batchSize)
+	{
+		const int32 count = std::min(batchSize, gameCount - first);
+		batch.assign(count, TournamentGameResult());
+		// every game writes its own slot only
+		for (int32 i = 0; i < count; i++)
+		{
+			TournamentGameResult* slot = &batch[i];
+			pool.submit([this, first, i, slot]()
+			{
+				playGame(first + i, *slot);
+			});
+		}
+		pool.wait();
+
+		for (const TournamentGameResult& result : batch)
+		{
+			inOnResult(result);
+		}
+	}
+}
+
+void TournamentScheduler::run(std::vector<TournamentGameResult>& outResults) const
+{
+	outResults.clear();
+	outResults.reserve(getGameCount());
+	run([&outResults](const TournamentGameResult& inResult)
+	{
+		outResults.push_back(inResult);
+	});
+}
+
+Player* TournamentScheduler::createPlayer(const std::string& inStrategy, const std::string& inName)
+{
+	Player* p = nullptr;
+	if (inStrategy == "Human") {
+		p = new Player(inName);
+		p->setPlayerStrategy(new HumanPlayerStrategy(p));
+	}
+	else if (inStrategy == "Aggressive") {
+		p = new Player(new AggressivePlayerStrategy(), inName);
+	}
+	else if (inStrategy == "Benevolent") {
+		p = new Player(new BenevolentPlayerStrategy(), inName);
+	}
+	else if (inStrategy == "Neutral") {
+		p = new Player(new NeutralPlayerStrategy(), inName);
+	}
+	else if (inStrategy == "Cheater") {
+		p = new Player(new CheaterPlayerStrategy(), inName);
+	}
+	return p;
+}
+
+const char* TournamentScheduler::getStrategyName(const PlayerStrategies* inStrategy)
+{
+	if (dynamic_cast<const HumanPlayerStrategy*>(inStrategy) != nullptr) {
+		return "Human";
+	}
+	if (dynamic_cast<const AggressivePlayerStrategy*>(inStrategy) != nullptr) {
+		return "Aggressive";
+	}
+	if (dynamic_cast<const BenevolentPlayerStrategy*>(inStrategy) != nullptr) {
+		return "Benevolent";
+	}
+	if (dynamic_cast<const NeutralPlayerStrategy*>(inStrategy) != nullptr) {
+		return "Neutral";
+	}
+	if (dynamic_cast<const CheaterPlayerStrategy*>(inStrategy) != nullptr) {
+		return "Cheater";
+	}
+	return "";
+}
+
+bool TournamentScheduler::isSameGame(const GameContext& inGame, uint64 inSeed, std::string& outError) const
+{
+	if (inGame.getRandom().getSeed() != inSeed)
+	{
+		outError = "it was saved from the game of seed " + std::to_string(inGame.getRandom().getSeed());
+		return false;
+	}
+
+	// the players joined in the order of the strategies, names createPlayer does not know made no player
+	std::vector<std::string> strategies;
+	for (const std::string& strategy : _strategies)
+	{
+		if (strategy == "Human" || strategy == "Aggressive" || strategy == "Benevolent" || strategy == "Neutral" || strategy == "Cheater")
+		{
+			strategies.push_back(strategy);
+		}
+	}
+	// startGame shuffled the players, their ids are still in the order they joined
+	std::vector<const Player*> players(inGame.getPlayerList().begin(), inGame.getPlayerList().end());
+	std::sort(players.begin(), players.end(), [](const Player* inA, const Player* inB)
+	{
+		return inA->getPlayerID() < inB->getPlayerID();
+	});
+	std::vector<std::string> restored;
+	for (const Player* player : players)
+	{
+		if (player != inGame.getNeutralPlayer())
+		{
+			restored.push_back(getStrategyName(player->getPlayerStrategy()));
+		}
+	}
+	if (restored != strategies)
+	{
+		outError = "it was saved from a game with other players";
+		return false;
+	}
+	return true;
+}
+
+void TournamentScheduler::playGame(int32 inIndex, TournamentGameResult& outResult) const
+{
+	outResult.mapIndex = inIndex / _gamesPerMap;
+	outResult.gameIndex = inIndex % _gamesPerMap;
+	outResult.seed = GameRandom::deriveSeed(_seed, static_cast<uint64>(inIndex));
+
+	const std::string fileName = "map" + std::to_string(outResult.mapIndex) + "_game" + std::to_string(outResult.gameIndex);
+	std::string checkpoint;
+	if (!_checkpointDirectory.empty())
+	{
+		checkpoint = _checkpointDirectory + "/" + fileName + ".wzsave";
+	}
+	const std::string mapName = static_cast<std::size_t>(outResult.mapIndex) < _mapNames.size() ? _mapNames[outResult.mapIndex] : std::string();
+
+	// the map is made before the game, the game deletes its players before the map goes
+	std::unique_ptr<Map> map = std::make_unique<Map>(*_maps[outResult.mapIndex]);
+	std::unique_ptr<GameContext> game = std::make_unique<GameContext>();
+	game->setMap(map.get());
+
+	std::string restoreError;
+	if (!checkpoint.empty() && std::ifstream(checkpoint).good())
+	{
+		GameCheckpointLoader loader;
+		if (!loader.loadFile(checkpoint, *game))
+		{
+			restoreError = loader.getError();
+		}
+		else if (isSameGame(*game, outResult.seed, restoreError))
+		{
+			outResult.resumedTurn = game->getTurn();
+		}
+		if (!restoreError.empty())
+		{
+			// what a failed restore left is thrown away, the game starts over
+			game.reset();
+			map = std::make_unique<Map>(*_maps[outResult.mapIndex]);
+			game = std::make_unique<GameContext>();
+			game->setMap(map.get());
+		}
+	}
+	const bool bResumed = outResult.resumedTurn > 0;
+	if (!bResumed)
+	{
+		game->setRandomSeed(outResult.seed);
+		game->setMapName(mapName);
+	}
+
+	BufferedOutputSink* log = nullptr;
+	if (bKeepLogs)
+	{
+		std::unique_ptr<BufferedOutputSink> sink = std::make_unique<BufferedOutputSink>();
+		log = sink.get();
+		game->setOutputSink(std::move(sink));
+	}
+	else
+	{
+		game->setOutputSink(std::make_unique<NullOutputSink>());
+	}
+
+	if (!bResumed)
+	{
+		for (std::size_t y = 0; y < _strategies.size(); y++)
+		{
+			Player* p = createPlayer(_strategies[y], "player " + std::to_string(y));
+			if (p != nullptr)
+			{
+				game->registerPlayer(p);
+			}
+		}
+		if (game->getPlayerList().size() < 2)
+		{
+			outResult.winner = "Draw";
+			return;
+		}
+	}
+
+	// a replay needs every order from the first turn, a resumed game is not recorded
+	GameReplayRecorder recorder;
+	std::string replay;
+	if (!bResumed && !_replayDirectory.empty())
+	{
+		replay = _replayDirectory + "/" + fileName + ".wzreplay";
+		recorder.attach(*game);
+	}
+
+	GameCheckpointWriter writer;
+	if (!checkpoint.empty())
+	{
+		game->setTurnEndCallback([&writer, &checkpoint](GameContext& inGame)
+		{
+			if (!writer.writeFile(inGame, checkpoint))
+			{
+				inGame.getOutput() << "Checkpoint " << checkpoint << " not saved: " << writer.getError() << "\n";
+			}
+		});
+	}
+
+	game->getOutput() << "Map " << outResult.mapIndex << " game " << outResult.gameIndex << " seed: " << outResult.seed << "\n";
+	if (!restoreError.empty())
+	{
+		game->getOutput() << "Checkpoint " << checkpoint << " not restored, the game starts over: " << restoreError << "\n";
+	}
+	if (bResumed)
+	{
+		game->getOutput() << "Resumed from " << checkpoint << " at turn " << outResult.resumedTurn << "\n";
+		outResult.winner = game->resumeGame(_maxTurns);
+	}
+	else
+	{
+		game->startGame();
+		outResult.winner = game->playGame(game->getPlayerList(), _maxTurns);
+	}
+	outResult.turns = game->getTurn();
+	if (!replay.empty())
+	{
+		recorder.detach();
+		if (!recorder.writeFile(*game, replay))
+		{
+			game->getOutput() << "Replay " << replay << " not saved: " << recorder.getError() << "\n";
+		}
+	}
+	if (log != nullptr)
+	{
+		outResult.log = log->getText();
+	}
+	if (!checkpoint.empty())
+	{
+		std::remove(checkpoint.c_str());
+	}
+}
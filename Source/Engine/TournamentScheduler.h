@@ -0,0 +1,90 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+class GameContext;
+class Map;
+class Player;
+class PlayerStrategies;
+
+// how one game of a tournament ended
+struct TournamentGameResult
+{
+	int32 mapIndex = 0;
+	int32 gameIndex = 0;
+	uint64 seed = 0;
+	// strategy of the winner, "Draw" when the turns ran out
+	std::string winner;
+	int32 turns = 0;
+	// turn the game went on from when it was resumed from a checkpoint, 0 when it was played from the start
+	int32 resumedTurn = 0;
+	// narration of the game, empty when the logs are not kept
+	std::string log;
+};
+
+/*
+	Summary: Plays the games of a tournament on worker threads.
+	Every game has its own GameContext, its own copy of the map and its own players made from
+	the strategy names, so nothing is shared between the games but the loaded maps, which are only read.
+	The seed of a game comes from the tournament seed and the place of the game in the tournament,
+	the results and the narration are the same whatever the number of threads.
+	Results are handed back in map then game order, a batch of games at a time so the logs
+	waiting for the games before them stay few.
+*/
+class TournamentScheduler {
+public:
+	// inThreadCount below 1 uses one thread per hardware core
+	explicit TournamentScheduler(int32 inThreadCount = 0);
+
+	// every map is played getGamesPerMap times, the maps have to outlive run
+	void setMaps(std::vector<const Map*> inMaps);
+	// names the maps were loaded by, in the order of setMaps, the games and their replays are told which map they are on
+	void setMapNames(std::vector<std::string> inMapNames);
+	// one player per name: Human, Aggressive, Benevolent, Neutral or Cheater
+	void setStrategies(std::vector<std::string> inStrategies);
+	void setGamesPerMap(int32 inGamesPerMap);
+	int32 getGamesPerMap() const;
+	void setMaxTurns(int32 inMaxTurns);
+	void setSeed(uint64 inSeed);
+	uint64 getSeed() const;
+	// when false the games narrate nothing, which is the fastest
+	void setKeepLogs(bool bInKeepLogs);
+	// every game saves itself to inDirectory after each turn and deletes its checkpoint when it ends.
+	// A game whose checkpoint is found there goes on from it, so a stopped tournament can be run again.
+	void setCheckpointDirectory(std::string inDirectory);
+	// every game played from its first turn records its orders to inDirectory, to be replayed with GameReplayer
+	void setReplayDirectory(std::string inDirectory);
+
+	int32 getGameCount() const;
+	// threads the games will be played on, a human player keeps the tournament on one
+	int32 getThreadCount() const;
+
+	// plays every game and calls inOnResult with each of them in order, on the calling thread
+	void run(const std::function<void(const TournamentGameResult&)>& inOnResult) const;
+	void run(std::vector<TournamentGameResult>& outResults) const;
+
+	// player with the strategy called inStrategy, nullptr for an unknown name
+	static Player* createPlayer(const std::string& inStrategy, const std::string& inName);
+	// name createPlayer takes for inStrategy, empty for no or an unknown strategy
+	static const char* getStrategyName(const PlayerStrategies* inStrategy);
+
+private:
+	void playGame(int32 inIndex, TournamentGameResult& outResult) const;
+	// false, with the reason in outError, when inGame restored from a checkpoint is not the game
+	// started from inSeed with the strategies of this tournament
+	bool isSameGame(const GameContext& inGame, uint64 inSeed, std::string& outError) const;
+
+	int32 _threadCount = 0;
+	std::vector<const Map*> _maps;
+	std::vector<std::string> _mapNames;
+	std::vector<std::string> _strategies;
+	int32 _gamesPerMap = 1;
+	int32 _maxTurns = 0;
+	uint64 _seed = 0;
+	bool bKeepLogs = true;
+	std::string _checkpointDirectory;
+	std::string _replayDirectory;
+};
@@ -0,0 +1,329 @@
+#include "FrontierIndex.h"
+#include "MapGraph.h"
+#include "TerritoryState.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+	void insertMember(std::vector<int32>& outMembers, int32* outPositions, int32 inTerritory)
+	{
+		outPositions[inTerritory] = static_cast<int32>(outMembers.size());
+		outMembers.push_back(inTerritory);
+	}
+
+	// the last member takes the place of the removed one
+	void eraseMember(std::vector<int32>& outMembers, int32* outPositions, int32 inTerritory, int32 inAbsent)
+	{
+		const int32 position = outPositions[inTerritory];
+		const int32 last = outMembers.back();
+		outMembers[position] = last;
+		outPositions[last] = position;
+		outMembers.pop_back();
+		outPositions[inTerritory] = inAbsent;
+	}
+
+	// gives outMembers the order of the count and members at inOrder[ioRead], which has to list each of them once
+	bool reorderMembers(const std::vector<int32>& inOrder, std::size_t& ioRead, std::vector<int32>& outMembers, int32* outPositions, int32 inTerritoryCount, int32 inAbsent)
+	{
+		if (ioRead >= inOrder.size() || inOrder[ioRead] != static_cast<int32>(outMembers.size()))
+		{
+			return false;
+		}
+		const std::size_t count = outMembers.size();
+		ioRead++;
+		if (inOrder.size() - ioRead < count)
+		{
+			return false;
+		}
+
+		// a member is crossed out when it is listed, a second listing finds it gone
+		const int32* order = inOrder.data() + ioRead;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			const int32 territory = order[i];
+			if (territory < 0 || territory >= inTerritoryCount)
+			{
+				return false;
+			}
+			const int32 position = outPositions[territory];
+			if (position == inAbsent || outMembers[position] != territory)
+			{
+				return false;
+			}
+			outMembers[position] = inAbsent;
+		}
+
+		for (std::size_t i = 0; i < count; i++)
+		{
+			outMembers[i] = order[i];
+			outPositions[order[i]] = static_cast<int32>(i);
+		}
+		ioRead += count;
+		return true;
+	}
+
+	const std::vector<int32> EmptySet;
+}
+
+FrontierIndex::FrontierIndex()
+{
+}
+
+void FrontierIndex::reset(std::shared_ptr<const MapGraph> inGraph, const std::vector<int32>& inOwners, int32 inPlayerCount)
+{
+	_graph = std::move(inGraph);
+	_territoryCount = _graph ? _graph->getTerritoryCount() : 0;
+	_playerCount = 0;
+	_frontiers.clear();
+	_interiors.clear();
+	_enemies.clear();
+	_ownedNeighbours.clear();
+	_enemyPositions.clear();
+
+	if (!_graph)
+	{
+		_foreignNeighbours.clear();
+		_ownedPositions.clear();
+		return;
+	}
+
+	recount(inOwners, inPlayerCount);
+}
+
+void FrontierIndex::recount(const std::vector<int32>& inOwners, int32 inPlayerCount)
+{
+	if (!_graph)
+	{
+		return;
+	}
+
+	// storage of players seen before is kept, a game restarting with as many players allocates nothing
+	_playerCount = 0;
+	while (_playerCount < inPlayerCount)
+	{
+		addPlayer();
+	}
+	for (std::size_t p = 0; p < _frontiers.size(); p++)
+	{
+		_frontiers[p].clear();
+		_interiors[p].clear();
+		_enemies[p].clear();
+	}
+	_foreignNeighbours.assign(_territoryCount, 0);
+	_ownedPositions.assign(_territoryCount, Absent);
+	std::fill(_ownedNeighbours.begin(), _ownedNeighbours.end(), 0);
+	std::fill(_enemyPositions.begin(), _enemyPositions.end(), Absent);
+
+	for (int32 i = 0; i < _territoryCount; i++)
+	{
+		for (int32 neighbour : _graph->getNeighbours(i))
+		{
+			if (inOwners[neighbour] != inOwners[i])
+			{
+				_foreignNeighbours[i]++;
+			}
+			if (inOwners[i] != TerritoryState::NoOwner)
+			{
+				_ownedNeighbours[static_cast<std::size_t>(inOwners[i]) * _territoryCount + neighbour]++;
+			}
+		}
+	}
+
+	for (int32 i = 0; i < _territoryCount; i++)
+	{
+		if (inOwners[i] != TerritoryState::NoOwner)
+		{
+			placeOwned(i, inOwners[i]);
+		}
+		for (int32 p = 0; p < _playerCount; p++)
+		{
+			updateEnemy(p, i, inOwners);
+		}
+	}
+}
+
+void FrontierIndex::saveOrder(std::vector<int32>& outOrder) const
+{
+	outOrder.clear();
+	for (int32 p = 0; p < _playerCount; p++)
+	{
+		for (const std::vector<int32>* set : { &_frontiers[p], &_interiors[p], &_enemies[p] })
+		{
+			outOrder.push_back(static_cast<int32>(set->size()));
+			outOrder.insert(outOrder.end(), set->begin(), set->end());
+		}
+	}
+}
+
+bool FrontierIndex::restoreOrder(const std::vector<int32>& inOrder)
+{
+	std::size_t read = 0;
+	for (int32 p = 0; p < _playerCount; p++)
+	{
+		int32* enemyPositions = _enemyPositions.data() + static_cast<std::size_t>(p) * _territoryCount;
+		if (!reorderMembers(inOrder, read, _frontiers[p], _ownedPositions.data(), _territoryCount, Absent)
+			|| !reorderMembers(inOrder, read, _interiors[p], _ownedPositions.data(), _territoryCount, Absent)
+			|| !reorderMembers(inOrder, read, _enemies[p], enemyPositions, _territoryCount, Absent))
+		{
+			return false;
+		}
+	}
+	return read == inOrder.size();
+}
+
+bool FrontierIndex::isBuilt() const
+{
+	return _graph != nullptr;
+}
+
+void FrontierIndex::addPlayer()
+{
+	if (!_graph)
+	{
+		return;
+	}
+
+	_playerCount++;
+	if (static_cast<int32>(_frontiers.size()) >= _playerCount)
+	{
+		return;
+	}
+	_frontiers.emplace_back();
+	_interiors.emplace_back();
+	_enemies.emplace_back();
+	_ownedNeighbours.resize(_ownedNeighbours.size() + _territoryCount, 0);
+	_enemyPositions.resize(_enemyPositions.size() + _territoryCount, Absent);
+}
+
+void FrontierIndex::placeOwned(int32 inTerritory, int32 inOwner)
+{
+	std::vector<int32>& set = _foreignNeighbours[inTerritory] > 0 ? _frontiers[inOwner] : _interiors[inOwner];
+	insertMember(set, _ownedPositions.data(), inTerritory);
+}
+
+void FrontierIndex::removeOwned(int32 inTerritory, int32 inOwner)
+{
+	std::vector<int32>& set = _foreignNeighbours[inTerritory] > 0 ? _frontiers[inOwner] : _interiors[inOwner];
+	eraseMember(set, _ownedPositions.data(), inTerritory, Absent);
+}
+
+void FrontierIndex::updateEnemy(int32 inPlayerIndex, int32 inTerritory, const std::vector<int32>& inOwners)
+{
+	const std::size_t slot = static_cast<std::size_t>(inPlayerIndex) * _territoryCount;
+	const int32 owner = inOwners[inTerritory];
+	const bool bIsEnemy = owner != TerritoryState::NoOwner && owner != inPlayerIndex && _ownedNeighbours[slot + inTerritory] > 0;
+	const bool bIsListed = _enemyPositions[slot + inTerritory] != Absent;
+
+	if (bIsEnemy && !bIsListed)
+	{
+		insertMember(_enemies[inPlayerIndex], _enemyPositions.data() + slot, inTerritory);
+	}
+	else if (!bIsEnemy && bIsListed)
+	{
+		eraseMember(_enemies[inPlayerIndex], _enemyPositions.data() + slot, inTerritory, Absent);
+	}
+}
+
+void FrontierIndex::onOwnerChanged(int32 inTerritory, int32 inPreviousOwner, const std::vector<int32>& inOwners)
+{
+	const int32 newOwner = inOwners[inTerritory];
+	if (!_graph || newOwner == inPreviousOwner)
+	{
+		return;
+	}
+
+	// the territory itself: leaves the sets of its old owner, is recounted for the new one
+	if (inPreviousOwner != TerritoryState::NoOwner)
+	{
+		removeOwned(inTerritory, inPreviousOwner);
+	}
+	_foreignNeighbours[inTerritory] = 0;
+	for (int32 neighbour : _graph->getNeighbours(inTerritory))
+	{
+		if (inOwners[neighbour] != newOwner)
+		{
+			_foreignNeighbours[inTerritory]++;
+		}
+	}
+	if (newOwner != TerritoryState::NoOwner)
+	{
+		placeOwned(inTerritory, newOwner);
+	}
+
+	// territories bordering it: one more or one less foreign neighbour.
+	// Borders are not always listed both ways, the graph keeps the territories pointing at it
+	for (int32 neighbour : _graph->getIncoming(inTerritory))
+	{
+		const int32 neighbourOwner = inOwners[neighbour];
+		if (neighbour == inTerritory || (neighbourOwner != inPreviousOwner && neighbourOwner != newOwner))
+		{
+			continue;
+		}
+
+		const bool bWasFrontier = _foreignNeighbours[neighbour] > 0;
+		_foreignNeighbours[neighbour] += neighbourOwner == inPreviousOwner ? 1 : -1;
+
+		// only a territory crossing between frontier and interior moves
+		if (neighbourOwner != TerritoryState::NoOwner && bWasFrontier != (_foreignNeighbours[neighbour] > 0))
+		{
+			std::vector<int32>& from = bWasFrontier ? _frontiers[neighbourOwner] : _interiors[neighbourOwner];
+			eraseMember(from, _ownedPositions.data(), neighbour, Absent);
+			placeOwned(neighbour, neighbourOwner);
+		}
+	}
+
+	// territories it borders: one less for the old owner, one more for the new one
+	for (int32 neighbour : _graph->getNeighbours(inTerritory))
+	{
+		if (inPreviousOwner != TerritoryState::NoOwner)
+		{
+			_ownedNeighbours[static_cast<std::size_t>(inPreviousOwner) * _territoryCount + neighbour]--;
+			updateEnemy(inPreviousOwner, neighbour, inOwners);
+		}
+		if (newOwner != TerritoryState::NoOwner)
+		{
+			_ownedNeighbours[static_cast<std::size_t>(newOwner) * _territoryCount + neighbour]++;
+			updateEnemy(newOwner, neighbour, inOwners);
+		}
+	}
+
+	// whether the territory is an enemy of each player depends on its owner
+	for (int32 p = 0; p < _playerCount; p++)
+	{
+		updateEnemy(p, inTerritory, inOwners);
+	}
+}
+
+const std::vector<int32>& FrontierIndex::getFrontier(int32 inPlayerIndex) const
+{
+	if (inPlayerIndex < 0 || inPlayerIndex >= _playerCount)
+	{
+		return EmptySet;
+	}
+	return _frontiers[inPlayerIndex];
+}
+
+const std::vector<int32>& FrontierIndex::getInterior(int32 inPlayerIndex) const
+{
+	if (inPlayerIndex < 0 || inPlayerIndex >= _playerCount)
+	{
+		return EmptySet;
+	}
+	return _interiors[inPlayerIndex];
+}
+
+const std::vector<int32>& FrontierIndex::getAdjacentEnemies(int32 inPlayerIndex) const
+{
+	if (inPlayerIndex < 0 || inPlayerIndex >= _playerCount)
+	{
+		return EmptySet;
+	}
+	return _enemies[inPlayerIndex];
+}
+
+bool FrontierIndex::isFrontier(int32 inTerritory) const
+{
+	return _foreignNeighbours[inTerritory] > 0;
+}
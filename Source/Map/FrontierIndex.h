@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+class MapGraph;
+
+/*
+	Summary: Frontier, interior and adjacent enemies of every player, kept up to date on each owner change.
+	A territory is on the frontier of its owner when one of its neighbours belongs to someone else,
+	otherwise it is interior. The adjacent enemies of a player are the territories of other players
+	bordering one of its own. Every set is an unordered array with a position table, so a change of
+	hands costs O(degree + players) and a query returns the array as it is.
+	Territories are addressed by their dense index, players by their index in the TerritoryState.
+*/
+class FrontierIndex {
+public:
+	FrontierIndex();
+
+	// rebuilds every set from inOwners, an index without graph stays empty
+	void reset(std::shared_ptr<const MapGraph> inGraph, const std::vector<int32>& inOwners, int32 inPlayerCount);
+	// rebuilds every set for the same graph, reusing the storage of the previous owners
+	void recount(const std::vector<int32>& inOwners, int32 inPlayerCount);
+	// the order of the members of a set follows the changes of hands that made it and recount does not
+	// bring it back. saveOrder lists every set of every player, restoreOrder puts the sets rebuilt by
+	// recount from the same owners back in that order. Fails on a list made from other owners,
+	// the sets are then to be recounted.
+	void saveOrder(std::vector<int32>& outOrder) const;
+	bool restoreOrder(const std::vector<int32>& inOrder);
+	bool isBuilt() const;
+	// makes room for a newly registered player, it owns nothing yet
+	void addPlayer();
+
+	// inOwners already holds the new owner of inTerritory
+	void onOwnerChanged(int32 inTerritory, int32 inPreviousOwner, const std::vector<int32>& inOwners);
+
+	const std::vector<int32>& getFrontier(int32 inPlayerIndex) const;
+	const std::vector<int32>& getInterior(int32 inPlayerIndex) const;
+	const std::vector<int32>& getAdjacentEnemies(int32 inPlayerIndex) const;
+	bool isFrontier(int32 inTerritory) const;
+
+private:
+	static constexpr int32 Absent = -1;
+
+	// files an owned territory under the frontier or the interior of its owner
+	void placeOwned(int32 inTerritory, int32 inOwner);
+	void removeOwned(int32 inTerritory, int32 inOwner);
+	// adds or removes inTerritory from the enemies of inPlayerIndex to match the counts
+	void updateEnemy(int32 inPlayerIndex, int32 inTerritory, const std::vector<int32>& inOwners);
+
+	std::shared_ptr<const MapGraph> _graph;
+	int32 _territoryCount = 0;
+	// the per-player arrays can hold more players, those past _playerCount are unused
+	int32 _playerCount = 0;
+
+	// neighbours of a territory that its owner does not own
+	std::vector<int32> _foreignNeighbours;
+	// position of an owned territory inside the frontier or interior set of its owner
+	std::vector<int32> _ownedPositions;
+	std::vector<std::vector<int32>> _frontiers;
+	std::vector<std::vector<int32>> _interiors;
+
+	// territories of player p listing territory t as a neighbour at p * territoryCount + t
+	std::vector<int32> _ownedNeighbours;
+	// position of territory t in the enemy set of player p at p * territoryCount + t
+	std::vector<int32> _enemyPositions;
+	std::vector<std::vector<int32>> _enemies;
+};
@@ -0,0 +1,315 @@
+#include "MapBinary.h"
+#include "MapParser.h"
+#include "map.h"
+#include "Common/BinaryStream.h"
+#include "Common/Hash.h"
+#include "Common/MappedFile.h"
+
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+	const char WzMapMagic[4] = { 'W', 'Z', 'M', 'P' };
+
+	template <typename T>
+	void appendBytes(std::vector<char>& outBuffer, const T* inData, std::size_t inCount)
+	{
+		const char* bytes = reinterpret_cast<const char*>(inData);
+		outBuffer.insert(outBuffer.end(), bytes, bytes + sizeof(T) * inCount);
+	}
+
+	uint32 appendString(std::string& outPool, std::string_view inValue)
+	{
+		const uint32 offset = static_cast<uint32>(outPool.size());
+		outPool += inValue;
+		return offset;
+	}
+}
+
+MapBinaryWriter::MapBinaryWriter()
+{
+}
+
+const std::string& MapBinaryWriter::getError() const
+{
+	return _error;
+}
+
+bool MapBinaryWriter::writeFile(const Map& inMap, const std::string& inPath, uint64 inSourceHash)
+{
+	_error.clear();
+	if (!inMap.hasGraph())
+	{
+		_error = "the map has no graph to write";
+		return false;
+	}
+
+	const MapGraph& graph = inMap.getGraph();
+	std::string stringPool;
+
+	std::vector<WzMapContinent> continents(inMap.listContinents.size());
+	for (std::size_t i = 0; i < continents.size(); i++)
+	{
+		Continent* continent = inMap.listContinents[i];
+		const std::string_view name = continent->getNameView();
+		const std::string_view colour = continent->getColourView();
+
+		continents[i].nameOffset = appendString(stringPool, name);
+		continents[i].nameLength = static_cast<uint32>(name.size());
+		continents[i].colourOffset = appendString(stringPool, colour);
+		continents[i].colourLength = static_cast<uint32>(colour.size());
+		continents[i].armyValue = continent->getArmyValu();
+	}
+
+	std::vector<WzMapTerritory> territories(inMap.listTerritory.size());
+	for (std::size_t i = 0; i < territories.size(); i++)
+	{
+		Territory* territory = inMap.listTerritory[i];
+		const std::string_view name = territory->getNameView();
+
+		territories[i].id = territory->getID();
+		territories[i].continent = territory->getContinent();
+		territories[i].posx = territory->getPosx();
+		territories[i].posy = territory->getPosy();
+		territories[i].nameOffset = appendString(stringPool, name);
+		territories[i].nameLength = static_cast<uint32>(name.size());
+	}
+
+	std::vector<char> payload;
+	appendBytes(payload, continents.data(), continents.size());
+	appendBytes(payload, territories.data(), territories.size());
+	appendBytes(payload, graph.getOffsets().data(), graph.getOffsets().size());
+	appendBytes(payload, graph.getNeighbourIndexes().data(), graph.getNeighbourIndexes().size());
+	appendBytes(payload, stringPool.data(), stringPool.size());
+
+	WzMapHeader header;
+	std::memcpy(header.magic, WzMapMagic, sizeof(WzMapMagic));
+	header.version = Version;
+	header.byteOrder = ByteOrderMark;
+	header.sourceHash = inSourceHash;
+	header.checksum = Hash::fnv1a(payload.data(), payload.size());
+	header.continentCount = static_cast<uint32>(continents.size());
+	header.territoryCount = static_cast<uint32>(territories.size());
+	header.edgeCount = static_cast<uint32>(graph.getEdgeCount());
+	header.stringPoolSize = static_cast<uint32>(stringPool.size());
+
+	std::ofstream output(inPath, std::ios::binary | std::ios::trunc);
+	if (!output)
+	{
+		_error = "cannot create " + inPath;
+		return false;
+	}
+
+	output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	output.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+	if (!output)
+	{
+		_error = "cannot write " + inPath;
+		return false;
+	}
+	return true;
+}
+
+bool MapBinaryWriter::convertFile(const std::string& inMapPath, const std::string& inBinaryPath)
+{
+	_error.clear();
+
+	uint64 sourceHash = 0;
+	if (!Hash::hashFile(inMapPath, sourceHash))
+	{
+		_error = "cannot open " + inMapPath;
+		return false;
+	}
+
+	Map map;
+	MapParser parser;
+	if (!parser.parseFile(inMapPath, map))
+	{
+		_error = inMapPath + " is not a valid map file";
+		return false;
+	}
+	map.buildGraph();
+
+	return writeFile(map, inBinaryPath, sourceHash);
+}
+
+MapBinaryLoader::MapBinaryLoader()
+{
+}
+
+const std::string& MapBinaryLoader::getError() const
+{
+	return _error;
+}
+
+bool MapBinaryLoader::fail(Map& outMap, const std::string& inError)
+{
+	_error = inError;
+	outMap.isValidFile = false;
+	return false;
+}
+
+bool MapBinaryLoader::loadFile(const std::string& inPath, Map& outMap, uint64 inExpectedSourceHash)
+{
+	_error.clear();
+
+	MappedFile file;
+	if (!file.open(inPath))
+	{
+		return fail(outMap, "cannot open " + inPath);
+	}
+
+	const char* data = file.getData();
+	const std::size_t size = file.getSize();
+
+	WzMapHeader header;
+	if (size < sizeof(header))
+	{
+		return fail(outMap, "the file is too small to be a .wzmap");
+	}
+	std::memcpy(&header, data, sizeof(header));
+
+	if (std::memcmp(header.magic, WzMapMagic, sizeof(WzMapMagic)) != 0)
+	{
+		return fail(outMap, "the file is not a .wzmap");
+	}
+	if (header.byteOrder == SwappedByteOrderMark)
+	{
+		return fail(outMap, "the file was written on a machine of the other byte order");
+	}
+	if (header.version != MapBinaryWriter::Version || header.byteOrder != ByteOrderMark)
+	{
+		return fail(outMap, "the file was written by another version");
+	}
+	if (inExpectedSourceHash != 0 && header.sourceHash != inExpectedSourceHash)
+	{
+		return fail(outMap, "the file is older than its .map");
+	}
+
+	const std::size_t continentCount = header.continentCount;
+	const std::size_t territoryCount = header.territoryCount;
+	const std::size_t edgeCount = header.edgeCount;
+
+	const std::size_t continentsStart = sizeof(header);
+	const std::size_t territoriesStart = continentsStart + continentCount * sizeof(WzMapContinent);
+	const std::size_t offsetsStart = territoriesStart + territoryCount * sizeof(WzMapTerritory);
+	const std::size_t bordersStart = offsetsStart + (territoryCount + 1) * sizeof(int32);
+	const std::size_t stringsStart = bordersStart + edgeCount * sizeof(int32);
+
+	if (stringsStart + header.stringPoolSize != size)
+	{
+		return fail(outMap, "the file size does not match its header");
+	}
+	if (Hash::fnv1a(data + sizeof(header), size - sizeof(header)) != header.checksum)
+	{
+		return fail(outMap, "the checksum does not match, the file is damaged");
+	}
+
+	const char* strings = data + stringsStart;
+	auto readString = [&](uint32 inOffset, uint32 inLength, std::string& outValue)
+	{
+		if (static_cast<std::size_t>(inOffset) + inLength > header.stringPoolSize)
+		{
+			return false;
+		}
+		outValue.assign(strings + inOffset, inLength);
+		return true;
+	};
+
+	outMap.listContinents.reserve(continentCount);
+	for (std::size_t i = 0; i < continentCount; i++)
+	{
+		WzMapContinent entry;
+		std::memcpy(&entry, data + continentsStart + i * sizeof(entry), sizeof(entry));
+
+		std::string name;
+		std::string colour;
+		if (!readString(entry.nameOffset, entry.nameLength, name) || !readString(entry.colourOffset, entry.colourLength, colour))
+		{
+			return fail(outMap, "a continent name is outside the string pool");
+		}
+
+		Continent* continent = new Continent();
+		continent->setArmyValue(entry.armyValue);
+		continent->setName(name);
+		continent->setColour(colour);
+		outMap.listContinents.push_back(continent);
+	}
+
+	// the CSR arrays are copied in one block each
+	std::vector<int32> offsets(territoryCount + 1);
+	std::vector<int32> borders(edgeCount);
+	std::memcpy(offsets.data(), data + offsetsStart, offsets.size() * sizeof(int32));
+	if (edgeCount > 0)
+	{
+		std::memcpy(borders.data(), data + bordersStart, borders.size() * sizeof(int32));
+	}
+
+	if (offsets[0] != 0 || offsets[territoryCount] != static_cast<int32>(edgeCount))
+	{
+		return fail(outMap, "the border table is inconsistent");
+	}
+	for (std::size_t i = 0; i < territoryCount; i++)
+	{
+		if (offsets[i] > offsets[i + 1])
+		{
+			return fail(outMap, "the border table is inconsistent");
+		}
+	}
+	for (int32 border : borders)
+	{
+		if (border < 0 || border >= static_cast<int32>(territoryCount))
+		{
+			return fail(outMap, "a border refers to a territory that does not exist");
+		}
+	}
+
+	std::vector<int32> territoryContinents(territoryCount);
+	outMap.listTerritory.reserve(territoryCount);
+	for (std::size_t i = 0; i < territoryCount; i++)
+	{
+		WzMapTerritory entry;
+		std::memcpy(&entry, data + territoriesStart + i * sizeof(entry), sizeof(entry));
+
+		std::string name;
+		if (!readString(entry.nameOffset, entry.nameLength, name))
+		{
+			return fail(outMap, "a territory name is outside the string pool");
+		}
+		if (entry.continent < 1 || entry.continent > static_cast<int32>(continentCount))
+		{
+			return fail(outMap, "a territory refers to a continent that does not exist");
+		}
+
+		Territory* territory = new Territory();
+		territory->setId(entry.id);
+		territory->setName(name);
+		territory->setContinent(entry.continent);
+		territory->setPosx(entry.posx);
+		territory->setPosy(entry.posy);
+		outMap.listTerritory.push_back(territory);
+		territoryContinents[i] = entry.continent - 1;
+	}
+
+	// the border lists are still used by the code that walks Territory objects
+	for (std::size_t i = 0; i < territoryCount; i++)
+	{
+		std::vector<Territory*>& borderList = outMap.listTerritory[i]->getBorderList();
+		borderList.reserve(offsets[i + 1] - offsets[i]);
+		for (int32 position = offsets[i]; position < offsets[i + 1]; position++)
+		{
+			borderList.push_back(outMap.listTerritory[borders[position]]);
+		}
+		outMap.addTerritoryToContinent(outMap.listTerritory[i]);
+	}
+
+	std::shared_ptr<MapGraph> graph = std::make_shared<MapGraph>();
+	graph->assign(std::move(offsets), std::move(borders), std::move(territoryContinents), static_cast<int32>(continentCount));
+	outMap.setGraph(graph);
+
+	return outMap.isValidFile;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+class Map;
+
+/*
+	Layout of a .wzmap file, every value is stored in the byte order of the machine that wrote it,
+	the header holds ByteOrderMark so a machine of the other byte order rejects the file:
+		WzMapHeader
+		WzMapContinent[continentCount]
+		WzMapTerritory[territoryCount]
+		int32 borderOffsets[territoryCount + 1]
+		int32 borders[edgeCount]              (dense territory indexes)
+		char strings[stringPoolSize]          (names and colours, not null terminated)
+	The checksum covers everything after the header.
+*/
+struct WzMapHeader
+{
+	char magic[4];
+	uint16 version;
+	uint16 byteOrder;
+	// hash of the .map file the binary was made from, 0 when unknown
+	uint64 sourceHash;
+	uint64 checksum;
+	uint32 continentCount;
+	uint32 territoryCount;
+	uint32 edgeCount;
+	uint32 stringPoolSize;
+};
+
+struct WzMapContinent
+{
+	uint32 nameOffset;
+	uint32 nameLength;
+	uint32 colourOffset;
+	uint32 colourLength;
+	int32 armyValue;
+};
+
+struct WzMapTerritory
+{
+	int32 id;
+	// 1-based, like the text format
+	int32 continent;
+	int32 posx;
+	int32 posy;
+	uint32 nameOffset;
+	uint32 nameLength;
+};
+
+static_assert(sizeof(WzMapHeader) == 40, "the .wzmap header layout changed");
+static_assert(sizeof(WzMapContinent) == 20, "the .wzmap continent layout changed");
+static_assert(sizeof(WzMapTerritory) == 24, "the .wzmap territory layout changed");
+
+/*
+	Summary: Writes a loaded map to the .wzmap binary format.
+*/
+class MapBinaryWriter {
+public:
+	static constexpr uint16 Version = 2;
+
+	MapBinaryWriter();
+
+	// inMap must have its graph built, inSourceHash is stored to detect stale files
+	bool writeFile(const Map& inMap, const std::string& inPath, uint64 inSourceHash);
+	// parses the text map at inMapPath and writes it to inBinaryPath
+	bool convertFile(const std::string& inMapPath, const std::string& inBinaryPath);
+
+	const std::string& getError() const;
+
+private:
+	std::string _error;
+};
+
+/*
+	Summary: Builds a Map from a memory mapped .wzmap file.
+	The tables are copied straight into the territories and the graph, nothing is tokenized.
+	Files with another version or byte order, a bad checksum or an unexpected source hash are rejected.
+*/
+class MapBinaryLoader {
+public:
+	MapBinaryLoader();
+
+	// inExpectedSourceHash of 0 accepts the file whatever .map it was made from
+	bool loadFile(const std::string& inPath, Map& outMap, uint64 inExpectedSourceHash = 0);
+
+	const std::string& getError() const;
+
+private:
+	bool fail(Map& outMap, const std::string& inError);
+
+	std::string _error;
+};
@@ -0,0 +1,45 @@
+#include "MapCache.h"
+#include "map.h"
+
+#include <utility>
+
+MapCache::MapCache()
+{
+}
+
+MapCache& MapCache::getShared()
+{
+	static MapCache sharedCache;
+	return sharedCache;
+}
+
+std::shared_ptr<const Map> MapCache::find(const std::string& inPath, uint64 inContentHash) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto entry = _entries.find(inPath);
+	if (entry == _entries.end() || entry->second.contentHash != inContentHash)
+	{
+		return nullptr;
+	}
+	return entry->second.prototype;
+}
+
+void MapCache::insert(const std::string& inPath, uint64 inContentHash, std::shared_ptr<const Map> inPrototype)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	Entry& entry = _entries[inPath];
+	entry.contentHash = inContentHash;
+	entry.prototype = std::move(inPrototype);
+}
+
+void MapCache::clear()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_entries.clear();
+}
+
+int32 MapCache::getSize() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return static_cast<int32>(_entries.size());
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Common/CommonTypes.h"
+
+class Map;
+
+/*
+	Summary: Parsed and validated maps kept by path and content hash.
+	The cached maps are prototypes that are never played on, games get their own
+	instance through Map::instantiate which shares the immutable graph.
+	Invalid maps are cached as well so they are not parsed again either.
+*/
+class MapCache {
+public:
+	MapCache();
+
+	MapCache(const MapCache&) = delete;
+	MapCache& operator=(const MapCache&) = delete;
+
+	// cache used by every MapLoader unless told otherwise
+	static MapCache& getShared();
+
+	// the prototype loaded from inPath when its content hashed to inContentHash, nullptr otherwise
+	std::shared_ptr<const Map> find(const std::string& inPath, uint64 inContentHash) const;
+	// replaces whatever was cached for inPath
+	void insert(const std::string& inPath, uint64 inContentHash, std::shared_ptr<const Map> inPrototype);
+
+	void clear();
+	int32 getSize() const;
+
+private:
+	struct Entry
+	{
+		uint64 contentHash = 0;
+		std::shared_ptr<const Map> prototype;
+	};
+
+	mutable std::mutex _mutex;
+	std::unordered_map<std::string, Entry> _entries;
+};
@@ -0,0 +1,265 @@
+#include "MapChokepointIndex.h"
+
+#include <algorithm>
+
+MapChokepointIndex::MapChokepointIndex()
+{
+}
+
+/*
+	Tarjan's depth first search with an explicit stack, the maps are too large for recursion.
+	low[u] is the earliest discovery time reachable from the subtree of u through one back border,
+	a child v that cannot climb above its parent p (low[v] >= disc[p]) only reaches the rest of
+	the map through p, and a border p-v is a bridge when v cannot even climb back to p.
+*/
+void MapChokepointIndex::build(const MapGraph& inGraph)
+{
+	_territoryCount = inGraph.getTerritoryCount();
+	_flags.assign(_territoryCount, 0);
+	_separated.assign(_territoryCount, 0);
+	_articulationPoints.clear();
+	_bridges.clear();
+
+	std::vector<int32> offsets;
+	std::vector<int32> neighbours;
+	buildUndirected(inGraph, offsets, neighbours);
+
+	std::vector<int32> discovery(_territoryCount, -1);
+	std::vector<int32> low(_territoryCount, 0);
+	std::vector<int32> subtreeSize(_territoryCount, 1);
+	std::vector<int32> parent(_territoryCount, -1);
+	// next border of every territory on the stack still to look at
+	std::vector<int32> position(offsets.begin(), offsets.end() - 1);
+	std::vector<int32> stack;
+	stack.reserve(_territoryCount);
+	int32 time = 0;
+
+	for (int32 root = 0; root < _territoryCount; root++)
+	{
+		if (discovery[root] != -1)
+		{
+			continue;
+		}
+
+		int32 rootChildren = 0;
+		int32 largestRootChild = 0;
+		discovery[root] = low[root] = time++;
+		stack.push_back(root);
+
+		while (!stack.empty())
+		{
+			const int32 current = stack.back();
+			if (position[current] < offsets[current + 1])
+			{
+				const int32 next = neighbours[position[current]++];
+				if (discovery[next] == -1)
+				{
+					parent[next] = current;
+					discovery[next] = low[next] = time++;
+					stack.push_back(next);
+				}
+				else if (next != parent[current])
+				{
+					low[current] = std::min(low[current], discovery[next]);
+				}
+				continue;
+			}
+
+			// every border of current is done, report it to its parent
+			stack.pop_back();
+			const int32 up = parent[current];
+			if (up == -1)
+			{
+				continue;
+			}
+			low[up] = std::min(low[up], low[current]);
+			subtreeSize[up] += subtreeSize[current];
+
+			if (low[current] > discovery[up])
+			{
+				MapBorder bridge;
+				bridge.from = std::min(up, current);
+				bridge.to = std::max(up, current);
+				_bridges.push_back(bridge);
+				_flags[up] |= BridgeEnd;
+				_flags[current] |= BridgeEnd;
+			}
+			if (up == root)
+			{
+				rootChildren++;
+				largestRootChild = std::max(largestRootChild, subtreeSize[current]);
+			}
+			else if (low[current] >= discovery[up])
+			{
+				_flags[up] |= Articulation;
+				_separated[up] += subtreeSize[current];
+			}
+		}
+
+		// the root splits its part of the map when the search left it more than once
+		if (rootChildren > 1)
+		{
+			_flags[root] |= Articulation;
+			_separated[root] = subtreeSize[root] - 1 - largestRootChild;
+		}
+	}
+
+	for (int32 i = 0; i < _territoryCount; i++)
+	{
+		if ((_flags[i] & Articulation) != 0)
+		{
+			_articulationPoints.push_back(i);
+		}
+	}
+	std::sort(_bridges.begin(), _bridges.end(), [](const MapBorder& inLHS, const MapBorder& inRHS)
+	{
+		return inLHS.from != inRHS.from ? inLHS.from < inRHS.from : inLHS.to < inRHS.to;
+	});
+
+	// gateways, counted then filled continent by continent in rising territory order
+	const int32 continentCount = inGraph.getContinentCount();
+	_gatewayOffsets.assign(continentCount + 1, 0);
+	for (int32 i = 0; i < _territoryCount; i++)
+	{
+		const int32 continent = inGraph.getContinent(i);
+		if (continent < 0 || continent >= continentCount)
+		{
+			continue;
+		}
+		for (int32 position = offsets[i]; position < offsets[i + 1]; position++)
+		{
+			if (inGraph.getContinent(neighbours[position]) != continent)
+			{
+				_flags[i] |= Gateway;
+				_gatewayOffsets[continent + 1]++;
+				break;
+			}
+		}
+	}
+	for (int32 c = 0; c < continentCount; c++)
+	{
+		_gatewayOffsets[c + 1] += _gatewayOffsets[c];
+	}
+	_gateways.assign(_gatewayOffsets[continentCount], 0);
+	std::vector<int32> next(_gatewayOffsets.begin(), _gatewayOffsets.end() - 1);
+	for (int32 i = 0; i < _territoryCount; i++)
+	{
+		if ((_flags[i] & Gateway) != 0)
+		{
+			_gateways[next[inGraph.getContinent(i)]++] = i;
+		}
+	}
+}
+
+int32 MapChokepointIndex::getTerritoryCount() const
+{
+	return _territoryCount;
+}
+
+bool MapChokepointIndex::isArticulationPoint(int32 inIndex) const
+{
+	return (_flags[inIndex] & Articulation) != 0;
+}
+
+bool MapChokepointIndex::isGateway(int32 inIndex) const
+{
+	return (_flags[inIndex] & Gateway) != 0;
+}
+
+bool MapChokepointIndex::hasBridge(int32 inIndex) const
+{
+	return (_flags[inIndex] & BridgeEnd) != 0;
+}
+
+int32 MapChokepointIndex::getSeparatedCount(int32 inIndex) const
+{
+	return _separated[inIndex];
+}
+
+int32 MapChokepointIndex::getDefensePriority(int32 inIndex) const
+{
+	const uint8 flags = _flags[inIndex];
+	return ((flags & Articulation) != 0 ? 2 : 0) + ((flags & Gateway) != 0 ? 1 : 0) + ((flags & BridgeEnd) != 0 ? 1 : 0);
+}
+
+const std::vector<int32>& MapChokepointIndex::getArticulationPoints() const
+{
+	return _articulationPoints;
+}
+
+const std::vector<MapBorder>& MapChokepointIndex::getBridges() const
+{
+	return _bridges;
+}
+
+NeighbourRange MapChokepointIndex::getGateways(int32 inContinent) const
+{
+	NeighbourRange range;
+	if (inContinent < 0 || inContinent + 1 >= static_cast<int32>(_gatewayOffsets.size()))
+	{
+		return range;
+	}
+	range.first = _gateways.data() + _gatewayOffsets[inContinent];
+	range.last = _gateways.data() + _gatewayOffsets[inContinent + 1];
+	return range;
+}
+
+std::size_t MapChokepointIndex::getMemoryUsage() const
+{
+	return _flags.capacity() * sizeof(uint8)
+		+ (_separated.capacity() + _articulationPoints.capacity() + _gatewayOffsets.capacity() + _gateways.capacity()) * sizeof(int32)
+		+ _bridges.capacity() * sizeof(MapBorder);
+}
+
+void MapChokepointIndex::buildUndirected(const MapGraph& inGraph, std::vector<int32>& outOffsets, std::vector<int32>& outNeighbours)
+{
+	const int32 territoryCount = inGraph.getTerritoryCount();
+	outOffsets.assign(territoryCount + 1, 0);
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		for (int32 neighbour : inGraph.getNeighbours(i))
+		{
+			if (neighbour != i)
+			{
+				outOffsets[i + 1]++;
+				outOffsets[neighbour + 1]++;
+			}
+		}
+	}
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		outOffsets[i + 1] += outOffsets[i];
+	}
+
+	outNeighbours.assign(outOffsets[territoryCount], 0);
+	std::vector<int32> next(outOffsets.begin(), outOffsets.end() - 1);
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		for (int32 neighbour : inGraph.getNeighbours(i))
+		{
+			if (neighbour != i)
+			{
+				outNeighbours[next[i]++] = neighbour;
+				outNeighbours[next[neighbour]++] = i;
+			}
+		}
+	}
+
+	// a border listed both ways or twice appears more than once, the rows are compacted in place
+	int32 write = 0;
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		const int32 rowStart = write;
+		int32* first = outNeighbours.data() + outOffsets[i];
+		int32* last = outNeighbours.data() + outOffsets[i + 1];
+		std::sort(first, last);
+		last = std::unique(first, last);
+		for (int32* entry = first; entry != last; entry++)
+		{
+			outNeighbours[write++] = *entry;
+		}
+		outOffsets[i] = rowStart;
+	}
+	outOffsets[territoryCount] = write;
+	outNeighbours.resize(write);
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "MapGraph.h"
+#include "MapValidator.h"
+
+/*
+	Summary: Chokepoints of a map, built once when a map is loaded.
+	The borders are taken both ways, an articulation point is a territory whose loss splits
+	the map and a bridge is a border whose loss does. Gateways are the territories of a
+	continent bordering another continent, the only ways in and out of it.
+	Everything comes from one iterative depth first search, linear in the size of the map,
+	and every query afterwards is a table read.
+*/
+class MapChokepointIndex {
+public:
+	MapChokepointIndex();
+
+	void build(const MapGraph& inGraph);
+
+	int32 getTerritoryCount() const;
+
+	bool isArticulationPoint(int32 inIndex) const;
+	bool isGateway(int32 inIndex) const;
+	// true when one of the borders of the territory is a bridge
+	bool hasBridge(int32 inIndex) const;
+	// territories cut off from the rest of their part of the map if this one falls, 0 when it is no articulation point
+	int32 getSeparatedCount(int32 inIndex) const;
+	// how much holding the territory matters for the map shape: 2 for an articulation point,
+	// 1 more for a gateway and 1 more for a bridge end. 0 for an ordinary territory.
+	int32 getDefensePriority(int32 inIndex) const;
+
+	const std::vector<int32>& getArticulationPoints() const;
+	// every bridge once, from < to, sorted
+	const std::vector<MapBorder>& getBridges() const;
+	NeighbourRange getGateways(int32 inContinent) const;
+
+	std::size_t getMemoryUsage() const;
+
+private:
+	enum EFlags : uint8
+	{
+		Articulation = 1,
+		Gateway = 2,
+		BridgeEnd = 4
+	};
+
+	// both ways of every border once, so one-way borders count like the others
+	static void buildUndirected(const MapGraph& inGraph, std::vector<int32>& outOffsets, std::vector<int32>& outNeighbours);
+
+	int32 _territoryCount = 0;
+	std::vector<uint8> _flags;
+	std::vector<int32> _separated;
+	std::vector<int32> _articulationPoints;
+	std::vector<MapBorder> _bridges;
+	// gateways of continent c are _gateways[_gatewayOffsets[c] .. _gatewayOffsets[c + 1])
+	std::vector<int32> _gatewayOffsets;
+	std::vector<int32> _gateways;
+};
@@ -0,0 +1,211 @@
+#include "MapDistanceIndex.h"
+#include "MapGraph.h"
+
+#include <algorithm>
+#include <utility>
+
+MapDistanceIndex::MapDistanceIndex()
+{
+}
+
+void MapDistanceIndex::breadthFirst(const std::vector<int32>& inOffsets, const std::vector<int32>& inNeighbours, int32 inSource, uint16* outDistances, std::vector<int32>& outQueue)
+{
+	const int32 territoryCount = static_cast<int32>(inOffsets.size()) - 1;
+	std::fill(outDistances, outDistances + territoryCount, NoPath);
+	outQueue.resize(territoryCount);
+
+	int32 head = 0;
+	int32 tail = 0;
+	outQueue[tail++] = inSource;
+	outDistances[inSource] = 0;
+
+	while (head < tail)
+	{
+		const int32 current = outQueue[head++];
+		// the last value is kept for NoPath, longer routes are clamped below it
+		const uint16 nextDistance = static_cast<uint16>(std::min<int32>(outDistances[current] + 1, NoPath - 1));
+		for (int32 edge = inOffsets[current]; edge < inOffsets[current + 1]; edge++)
+		{
+			const int32 neighbour = inNeighbours[edge];
+			if (outDistances[neighbour] == NoPath)
+			{
+				outDistances[neighbour] = nextDistance;
+				outQueue[tail++] = neighbour;
+			}
+		}
+	}
+}
+
+void MapDistanceIndex::build(std::shared_ptr<const MapGraph> inGraph, int32 inExactLimit, int32 inLandmarkCount)
+{
+	_graph = std::move(inGraph);
+	_territoryCount = _graph ? _graph->getTerritoryCount() : 0;
+	_landmarks.clear();
+	_distances.clear();
+	_distancesTo.clear();
+	bIsExact = _territoryCount <= inExactLimit;
+
+	if (_territoryCount == 0)
+	{
+		return;
+	}
+
+	const std::size_t rowSize = static_cast<std::size_t>(_territoryCount);
+	const std::vector<int32>& offsets = _graph->getOffsets();
+	const std::vector<int32>& neighbours = _graph->getNeighbourIndexes();
+	std::vector<int32> queue;
+
+	if (bIsExact)
+	{
+		_distances.resize(rowSize * rowSize);
+		for (int32 i = 0; i < _territoryCount; i++)
+		{
+			breadthFirst(offsets, neighbours, i, _distances.data() + i * rowSize, queue);
+		}
+		return;
+	}
+
+	// a search over the reversed borders gives the distances to its source
+	const std::vector<int32>& reversedOffsets = _graph->getIncomingOffsets();
+	const std::vector<int32>& reversed = _graph->getIncomingIndexes();
+
+	const int32 landmarkCount = std::max(1, std::min(inLandmarkCount, _territoryCount));
+	_distances.resize(rowSize * landmarkCount);
+	_distancesTo.resize(rowSize * landmarkCount);
+	_landmarks.reserve(landmarkCount);
+
+	// the best connected territory goes first, every next landmark is the territory
+	// furthest from those already picked, unreachable ones first so every region gets one
+	int32 next = 0;
+	for (int32 i = 1; i < _territoryCount; i++)
+	{
+		if (_graph->getDegree(i) > _graph->getDegree(next))
+		{
+			next = i;
+		}
+	}
+
+	std::vector<int32> closestLandmark(_territoryCount, NoPath);
+	for (int32 l = 0; l < landmarkCount; l++)
+	{
+		_landmarks.push_back(next);
+		uint16* row = _distances.data() + l * rowSize;
+		breadthFirst(offsets, neighbours, next, row, queue);
+		breadthFirst(reversedOffsets, reversed, next, _distancesTo.data() + l * rowSize, queue);
+
+		next = -1;
+		int32 furthest = -1;
+		for (int32 i = 0; i < _territoryCount; i++)
+		{
+			closestLandmark[i] = std::min<int32>(closestLandmark[i], row[i]);
+			if (closestLandmark[i] > furthest)
+			{
+				furthest = closestLandmark[i];
+				next = i;
+			}
+		}
+
+		// every territory is a landmark already
+		if (furthest <= 0)
+		{
+			break;
+		}
+	}
+
+	_distances.resize(rowSize * _landmarks.size());
+	_distances.shrink_to_fit();
+	_distancesTo.resize(rowSize * _landmarks.size());
+	_distancesTo.shrink_to_fit();
+}
+
+bool MapDistanceIndex::isExact() const
+{
+	return bIsExact;
+}
+
+int32 MapDistanceIndex::getTerritoryCount() const
+{
+	return _territoryCount;
+}
+
+const std::vector<int32>& MapDistanceIndex::getLandmarks() const
+{
+	return _landmarks;
+}
+
+const uint16* MapDistanceIndex::getRow(int32 inRow) const
+{
+	return _distances.data() + static_cast<std::size_t>(inRow) * _territoryCount;
+}
+
+const uint16* MapDistanceIndex::getRowTo(int32 inLandmark) const
+{
+	return _distancesTo.data() + static_cast<std::size_t>(inLandmark) * _territoryCount;
+}
+
+int32 MapDistanceIndex::distance(int32 inFrom, int32 inTo) const
+{
+	if (bIsExact)
+	{
+		const uint16 hops = getRow(inFrom)[inTo];
+		return hops == NoPath ? Unreachable : hops;
+	}
+
+	if (inFrom == inTo)
+	{
+		return 0;
+	}
+	if (_graph->isAdjacent(inFrom, inTo))
+	{
+		return 1;
+	}
+
+	int32 best = Unreachable;
+	for (std::size_t l = 0; l < _landmarks.size(); l++)
+	{
+		// from inFrom to the landmark, then from the landmark to inTo
+		const uint16 toLandmark = getRowTo(static_cast<int32>(l))[inFrom];
+		const uint16 fromLandmark = getRow(static_cast<int32>(l))[inTo];
+		if (toLandmark == NoPath || fromLandmark == NoPath)
+		{
+			continue;
+		}
+
+		const int32 throughLandmark = toLandmark + fromLandmark;
+		if (best == Unreachable || throughLandmark < best)
+		{
+			best = throughLandmark;
+		}
+	}
+	return best;
+}
+
+int32 MapDistanceIndex::getLowerBound(int32 inFrom, int32 inTo) const
+{
+	if (bIsExact)
+	{
+		return distance(inFrom, inTo);
+	}
+
+	int32 bound = inFrom == inTo ? 0 : 1;
+	for (std::size_t l = 0; l < _landmarks.size(); l++)
+	{
+		// d(l, to) <= d(l, from) + d(from, to) and d(from, l) <= d(from, to) + d(to, l)
+		const uint16* from = getRow(static_cast<int32>(l));
+		if (from[inFrom] != NoPath && from[inTo] != NoPath)
+		{
+			bound = std::max(bound, from[inTo] - from[inFrom]);
+		}
+		const uint16* to = getRowTo(static_cast<int32>(l));
+		if (to[inFrom] != NoPath && to[inTo] != NoPath)
+		{
+			bound = std::max(bound, to[inFrom] - to[inTo]);
+		}
+	}
+	return bound;
+}
+
+std::size_t MapDistanceIndex::getMemoryUsage() const
+{
+	return (_distances.capacity() + _distancesTo.capacity()) * sizeof(uint16) + _landmarks.capacity() * sizeof(int32);
+}
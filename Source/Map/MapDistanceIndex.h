@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+class MapGraph;
+
+/*
+	Summary: Hop distances between territories, built once when a map is loaded.
+	Small maps keep the exact all-pairs table filled by one breadth first search per territory.
+	Larger maps keep the distances from and to a few landmarks picked far apart from each other,
+	a query then returns the shortest route through a landmark: never shorter than the real
+	distance, exact for neighbours and for routes passing by a landmark.
+	Borders may go one way, the distances to a landmark come from a search over the reversed borders.
+*/
+class MapDistanceIndex {
+public:
+	static constexpr int32 Unreachable = -1;
+	// the exact table costs territoryCount^2 * 2 bytes, 8 MB at this size
+	static constexpr int32 DefaultExactLimit = 2048;
+	static constexpr int32 DefaultLandmarkCount = 16;
+
+	MapDistanceIndex();
+
+	void build(std::shared_ptr<const MapGraph> inGraph, int32 inExactLimit = DefaultExactLimit, int32 inLandmarkCount = DefaultLandmarkCount);
+
+	bool isExact() const;
+	int32 getTerritoryCount() const;
+	const std::vector<int32>& getLandmarks() const;
+
+	// number of borders to cross from inFrom to inTo, Unreachable when there is no path.
+	// O(1) with the exact table, O(landmarks) otherwise.
+	int32 distance(int32 inFrom, int32 inTo) const;
+	// the real distance is never below this, equal to distance() on exact indexes
+	int32 getLowerBound(int32 inFrom, int32 inTo) const;
+
+	std::size_t getMemoryUsage() const;
+
+private:
+	static constexpr uint16 NoPath = 0xFFFF;
+
+	// hop distance from inSource to every territory over the CSR adjacency inOffsets/inNeighbours, written to outDistances
+	static void breadthFirst(const std::vector<int32>& inOffsets, const std::vector<int32>& inNeighbours, int32 inSource, uint16* outDistances, std::vector<int32>& outQueue);
+
+	const uint16* getRow(int32 inRow) const;
+	// distances from every territory to landmark inLandmark
+	const uint16* getRowTo(int32 inLandmark) const;
+
+	std::shared_ptr<const MapGraph> _graph;
+	int32 _territoryCount = 0;
+	bool bIsExact = false;
+
+	// exact: row i holds the distances from territory i, landmarks: row l holds the distances from landmark l
+	std::vector<uint16> _distances;
+	// landmarks only: row l holds the distances from every territory to landmark l
+	std::vector<uint16> _distancesTo;
+	std::vector<int32> _landmarks;
+};
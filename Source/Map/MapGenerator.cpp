@@ -0,0 +1,233 @@
+#include "MapGenerator.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <unordered_set>
+
+namespace
+{
+	void appendNumber(std::string& outText, int32 inValue)
+	{
+		char buffer[16];
+		std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), inValue);
+		outText.append(buffer, result.ptr);
+	}
+
+	uint64 makeBorderKey(int32 inFirst, int32 inSecond)
+	{
+		const uint32 low = static_cast<uint32>(std::min(inFirst, inSecond));
+		const uint32 high = static_cast<uint32>(std::max(inFirst, inSecond));
+		return (static_cast<uint64>(low) << 32) | high;
+	}
+}
+
+MapGenerator::MapGenerator(const MapGeneratorOptions& inOptions)
+	: _options(inOptions)
+{
+	_options.territoryCount = std::max(1, _options.territoryCount);
+	_options.continentCount = std::max(1, std::min(_options.continentCount, _options.territoryCount));
+	_options.degreeSkew = std::max(0.0, std::min(1.0, _options.degreeSkew));
+	_options.planarity = std::max(0.0, std::min(1.0, _options.planarity));
+
+	_gridWidth = std::max(1, static_cast<int32>(std::ceil(std::sqrt(static_cast<double>(_options.territoryCount)))));
+}
+
+int32 MapGenerator::getBorderCount() const
+{
+	return static_cast<int32>(_borderFrom.size());
+}
+
+int32 MapGenerator::getCellTerritory(int32 inRow, int32 inColumn) const
+{
+	if (inRow < 0 || inColumn < 0 || inColumn >= _gridWidth)
+	{
+		return -1;
+	}
+
+	// even rows run left to right, odd rows right to left
+	const int32 territory = inRow * _gridWidth + (inRow % 2 == 0 ? inColumn : _gridWidth - 1 - inColumn);
+	return territory < _options.territoryCount ? territory : -1;
+}
+
+void MapGenerator::generateBorders()
+{
+	const int32 territoryCount = _options.territoryCount;
+	_borderFrom.clear();
+	_borderTo.clear();
+
+	std::unordered_set<uint64> knownBorders;
+	auto addBorder = [&](int32 inFirst, int32 inSecond)
+	{
+		if (inFirst == inSecond || inSecond < 0 || !knownBorders.insert(makeBorderKey(inFirst, inSecond)).second)
+		{
+			return false;
+		}
+		_borderFrom.push_back(inFirst);
+		_borderTo.push_back(inSecond);
+		return true;
+	};
+
+	// the snake path keeps every continent and the whole map connected
+	for (int32 i = 0; i + 1 < territoryCount; i++)
+	{
+		addBorder(i, i + 1);
+	}
+
+	const long long targetBorders = static_cast<long long>(territoryCount * _options.averageDegree / 2.0);
+	long long missingBorders = targetBorders - static_cast<long long>(_borderFrom.size());
+	if (missingBorders <= 0)
+	{
+		return;
+	}
+
+	std::mt19937 rng(_options.seed);
+	std::uniform_real_distribution<double> unit(0.0, 1.0);
+	std::uniform_int_distribution<int32> anyTerritory(0, territoryCount - 1);
+	// a skewed source picks low indexes more often, they become the hubs
+	const double skewExponent = 1.0 + 4.0 * _options.degreeSkew;
+
+	// dense graphs run out of free pairs, give up after a bounded number of misses
+	long long remainingAttempts = missingBorders * 8 + 64;
+	while (missingBorders > 0 && remainingAttempts-- > 0)
+	{
+		const int32 source = std::min(territoryCount - 1, static_cast<int32>(territoryCount * std::pow(unit(rng), skewExponent)));
+		int32 target = -1;
+
+		if (unit(rng) < _options.planarity)
+		{
+			const int32 row = source / _gridWidth;
+			const int32 position = source % _gridWidth;
+			const int32 column = row % 2 == 0 ? position : _gridWidth - 1 - position;
+			switch (rng() % 4)
+			{
+			case 0: target = getCellTerritory(row - 1, column); break;
+			case 1: target = getCellTerritory(row + 1, column); break;
+			case 2: target = getCellTerritory(row, column - 1); break;
+			default: target = getCellTerritory(row, column + 1); break;
+			}
+		}
+		else
+		{
+			target = anyTerritory(rng);
+		}
+
+		if (addBorder(source, target))
+		{
+			missingBorders--;
+		}
+	}
+}
+
+std::string MapGenerator::generate()
+{
+	generateBorders();
+
+	const int32 territoryCount = _options.territoryCount;
+	const int32 continentCount = _options.continentCount;
+
+	// group the undirected borders per territory, both directions
+	std::vector<int32> offsets(territoryCount + 1, 0);
+	for (std::size_t i = 0; i < _borderFrom.size(); i++)
+	{
+		offsets[_borderFrom[i] + 1]++;
+		offsets[_borderTo[i] + 1]++;
+	}
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		offsets[i + 1] += offsets[i];
+	}
+
+	std::vector<int32> neighbours(offsets[territoryCount]);
+	std::vector<int32> fill(offsets.begin(), offsets.end() - 1);
+	for (std::size_t i = 0; i < _borderFrom.size(); i++)
+	{
+		neighbours[fill[_borderFrom[i]]++] = _borderTo[i];
+		neighbours[fill[_borderTo[i]]++] = _borderFrom[i];
+	}
+
+	// file id of every grid territory and the grid territory listed under every file id
+	std::vector<int32> fileIds(territoryCount);
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		fileIds[i] = i + 1;
+	}
+	if (_options.bShuffleIds)
+	{
+		std::mt19937 rng(_options.seed ^ 0x5bd1e995u);
+		std::shuffle(fileIds.begin(), fileIds.end(), rng);
+	}
+	std::vector<int32> gridTerritories(territoryCount);
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		gridTerritories[fileIds[i] - 1] = i;
+	}
+
+	std::string text;
+	text.reserve(static_cast<std::size_t>(territoryCount) * 48 + neighbours.size() * 8);
+	text += "; generated map\n\n[continents]\n";
+	for (int32 c = 0; c < continentCount; c++)
+	{
+		text += "Continent_";
+		appendNumber(text, c + 1);
+		text += ' ';
+		// bigger continents are worth more
+		appendNumber(text, 1 + territoryCount / continentCount / 4);
+		text += " #";
+		appendNumber(text, c % 10);
+		text += '\n';
+	}
+
+	text += "\n[countries]\n";
+	for (int32 fileId = 1; fileId <= territoryCount; fileId++)
+	{
+		const int32 i = gridTerritories[fileId - 1];
+		const int32 row = i / _gridWidth;
+		const int32 position = i % _gridWidth;
+		const int32 column = row % 2 == 0 ? position : _gridWidth - 1 - position;
+		// consecutive runs of territories form the continents
+		const int32 continent = static_cast<int32>(static_cast<long long>(i) * continentCount / territoryCount) + 1;
+
+		appendNumber(text, fileId);
+		text += " Territory_";
+		appendNumber(text, i + 1);
+		text += ' ';
+		appendNumber(text, continent);
+		text += ' ';
+		appendNumber(text, column * 10);
+		text += ' ';
+		appendNumber(text, row * 10);
+		text += '\n';
+	}
+
+	text += "\n[borders]\n";
+	for (int32 fileId = 1; fileId <= territoryCount; fileId++)
+	{
+		const int32 i = gridTerritories[fileId - 1];
+		appendNumber(text, fileId);
+		for (int32 position = offsets[i]; position < offsets[i + 1]; position++)
+		{
+			text += ' ';
+			appendNumber(text, fileIds[neighbours[position]]);
+		}
+		text += '\n';
+	}
+
+	return text;
+}
+
+bool MapGenerator::writeFile(const std::string& inPath)
+{
+	const std::string text = generate();
+
+	std::ofstream output(inPath, std::ios::binary | std::ios::trunc);
+	if (!output)
+	{
+		return false;
+	}
+
+	output.write(text.data(), static_cast<std::streamsize>(text.size()));
+	return static_cast<bool>(output);
+}
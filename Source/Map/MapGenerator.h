@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// shape of a generated map
+struct MapGeneratorOptions
+{
+	int32 territoryCount = 1000;
+	int32 continentCount = 10;
+	// average number of borders per territory, 2 is the path that keeps the map connected
+	double averageDegree = 4.0;
+	// 0 spreads the extra borders evenly, towards 1 they gather on a few hub territories
+	double degreeSkew = 0.0;
+	// share of the extra borders joining neighbouring grid cells, the rest join random territories
+	double planarity = 1.0;
+	// file ids follow the grid when false, otherwise they are shuffled so neighbours get unrelated ids
+	bool bShuffleIds = false;
+	uint32 seed = 1;
+};
+
+/*
+	Summary: Writes valid .map files of any size for tests and benchmarks.
+	Territories are laid on a grid in snake order and every one borders the next,
+	so the map and each continent (a run of consecutive territories) are always connected.
+	Extra borders are added up to the requested average degree, every border goes both ways.
+*/
+class MapGenerator {
+public:
+	explicit MapGenerator(const MapGeneratorOptions& inOptions);
+
+	// content of the .map file
+	std::string generate();
+	// writes the generated map to inPath, returns false if the file cannot be written
+	bool writeFile(const std::string& inPath);
+
+	// number of undirected borders of the last generated map
+	int32 getBorderCount() const;
+
+private:
+	void generateBorders();
+	int32 getCellTerritory(int32 inRow, int32 inColumn) const;
+
+	MapGeneratorOptions _options;
+	int32 _gridWidth = 1;
+
+	// undirected borders, each pair is stored once
+	std::vector<int32> _borderFrom;
+	std::vector<int32> _borderTo;
+};
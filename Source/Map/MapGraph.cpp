@@ -0,0 +1,143 @@
+#include "MapGraph.h"
+#include "map.h"
+
+#include <utility>
+
+MapGraph::MapGraph()
+{
+	_offsets.push_back(0);
+	_incomingOffsets.push_back(0);
+}
+
+void MapGraph::build(const std::vector<Territory*>& inTerritories, int32 inContinentCount)
+{
+	const std::size_t territoryCount = inTerritories.size();
+
+	_continentCount = inContinentCount;
+	_offsets.assign(territoryCount + 1, 0);
+	_continents.assign(territoryCount, 0);
+
+	// first pass sizes every row so the neighbour array is allocated once
+	for (std::size_t i = 0; i < territoryCount; i++)
+	{
+		_offsets[i + 1] = _offsets[i] + static_cast<int32>(inTerritories[i]->getBorderList().size());
+		_continents[i] = inTerritories[i]->getContinent() - 1;
+	}
+
+	_neighbours.resize(_offsets[territoryCount]);
+
+	int32 position = 0;
+	for (std::size_t i = 0; i < territoryCount; i++)
+	{
+		for (Territory* neighbour : inTerritories[i]->getBorderList())
+		{
+			_neighbours[position++] = neighbour->getIndex();
+		}
+	}
+	buildIncoming();
+}
+
+void MapGraph::assign(std::vector<int32> inOffsets, std::vector<int32> inNeighbours, std::vector<int32> inContinents, int32 inContinentCount)
+{
+	_offsets = std::move(inOffsets);
+	_neighbours = std::move(inNeighbours);
+	_continents = std::move(inContinents);
+	_continentCount = inContinentCount;
+	buildIncoming();
+}
+
+void MapGraph::buildIncoming()
+{
+	const int32 territoryCount = getTerritoryCount();
+	_incomingOffsets.assign(territoryCount + 1, 0);
+	for (int32 neighbour : _neighbours)
+	{
+		_incomingOffsets[neighbour + 1]++;
+	}
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		_incomingOffsets[i + 1] += _incomingOffsets[i];
+	}
+	_incoming.resize(_neighbours.size());
+	std::vector<int32> fill(_incomingOffsets.begin(), _incomingOffsets.end() - 1);
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		for (int32 position = _offsets[i]; position < _offsets[i + 1]; position++)
+		{
+			_incoming[fill[_neighbours[position]]++] = i;
+		}
+	}
+}
+
+int32 MapGraph::getTerritoryCount() const
+{
+	return static_cast<int32>(_offsets.size()) - 1;
+}
+
+int32 MapGraph::getContinentCount() const
+{
+	return _continentCount;
+}
+
+int32 MapGraph::getEdgeCount() const
+{
+	return static_cast<int32>(_neighbours.size());
+}
+
+NeighbourRange MapGraph::getNeighbours(int32 inIndex) const
+{
+	NeighbourRange range;
+	range.first = _neighbours.data() + _offsets[inIndex];
+	range.last = _neighbours.data() + _offsets[inIndex + 1];
+	return range;
+}
+
+NeighbourRange MapGraph::getIncoming(int32 inIndex) const
+{
+	NeighbourRange range;
+	range.first = _incoming.data() + _incomingOffsets[inIndex];
+	range.last = _incoming.data() + _incomingOffsets[inIndex + 1];
+	return range;
+}
+
+int32 MapGraph::getDegree(int32 inIndex) const
+{
+	return _offsets[inIndex + 1] - _offsets[inIndex];
+}
+
+bool MapGraph::isAdjacent(int32 inFrom, int32 inTo) const
+{
+	for (int32 neighbour : getNeighbours(inFrom))
+	{
+		if (neighbour == inTo)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+int32 MapGraph::getContinent(int32 inIndex) const
+{
+	return _continents[inIndex];
+}
+
+const std::vector<int32>& MapGraph::getOffsets() const
+{
+	return _offsets;
+}
+
+const std::vector<int32>& MapGraph::getNeighbourIndexes() const
+{
+	return _neighbours;
+}
+
+const std::vector<int32>& MapGraph::getIncomingOffsets() const
+{
+	return _incomingOffsets;
+}
+
+const std::vector<int32>& MapGraph::getIncomingIndexes() const
+{
+	return _incoming;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+class Territory;
+
+// contiguous run of neighbour indexes inside a MapGraph
+struct NeighbourRange
+{
+	const int32* first = nullptr;
+	const int32* last = nullptr;
+
+	const int32* begin() const { return first; }
+	const int32* end() const { return last; }
+	std::size_t size() const { return static_cast<std::size_t>(last - first); }
+	bool empty() const { return first == last; }
+	int32 operator[](std::size_t inPosition) const { return first[inPosition]; }
+};
+
+/*
+	Summary: Immutable compressed-sparse-row adjacency of a map.
+	Territories are addressed by their dense index (their position in Map::listTerritory),
+	the neighbours of territory i are neighbours[offsets[i] .. offsets[i + 1]).
+	Borders may go one way, the reversed borders are kept in the same form for the searches
+	and the indexes that need the territories pointing at one.
+	Built once when a map is loaded, the Territory border lists are left untouched.
+*/
+class MapGraph {
+public:
+	MapGraph();
+
+	// builds the graph from the border lists, every territory must already know its dense index
+	void build(const std::vector<Territory*>& inTerritories, int32 inContinentCount);
+	// takes arrays that are already in CSR form, inContinents holds the 0-based continent of every territory
+	void assign(std::vector<int32> inOffsets, std::vector<int32> inNeighbours, std::vector<int32> inContinents, int32 inContinentCount);
+
+	int32 getTerritoryCount() const;
+	int32 getContinentCount() const;
+	// number of directed border entries
+	int32 getEdgeCount() const;
+
+	NeighbourRange getNeighbours(int32 inIndex) const;
+	// territories that list inIndex as a neighbour
+	NeighbourRange getIncoming(int32 inIndex) const;
+	int32 getDegree(int32 inIndex) const;
+	bool isAdjacent(int32 inFrom, int32 inTo) const;
+
+	// 0-based continent of a territory
+	int32 getContinent(int32 inIndex) const;
+
+	const std::vector<int32>& getOffsets() const;
+	const std::vector<int32>& getNeighbourIndexes() const;
+	const std::vector<int32>& getIncomingOffsets() const;
+	const std::vector<int32>& getIncomingIndexes() const;
+
+private:
+	// fills the reversed borders from _offsets and _neighbours
+	void buildIncoming();
+
+	int32 _continentCount = 0;
+	std::vector<int32> _offsets;
+	std::vector<int32> _neighbours;
+	std::vector<int32> _continents;
+	std::vector<int32> _incomingOffsets;
+	std::vector<int32> _incoming;
+};
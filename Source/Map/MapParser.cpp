@@ -0,0 +1,275 @@
+#include "MapParser.h"
+#include "map.h"
+#include "MapTextTokens.h"
+#include "Common/MappedFile.h"
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+MapParser::MapParser()
+{
+}
+
+const std::vector<MapParseError>& MapParser::getErrors() const
+{
+	return _errors;
+}
+
+void MapParser::printErrors(std::ostream& out) const
+{
+	for (const auto& error : _errors)
+	{
+		out << "Line " << error.line << ": " << error.message << std::endl;
+	}
+}
+
+void MapParser::addError(int32 inLine, std::string inMessage)
+{
+	MapParseError error;
+	error.line = inLine;
+	error.message = std::move(inMessage);
+	_errors.push_back(std::move(error));
+}
+
+bool MapParser::parseFile(const std::string& inFilePath, Map& outMap)
+{
+	MappedFile file;
+	if (!file.open(inFilePath))
+	{
+		_errors.clear();
+		addError(0, "cannot open " + inFilePath);
+		outMap.isValidFile = false;
+		return false;
+	}
+
+	return parseBuffer(file.getView(), outMap);
+}
+
+bool MapParser::parseBuffer(std::string_view inContent, Map& outMap)
+{
+	_errors.clear();
+	_currentLine = 0;
+	_territoryIds.clear();
+
+	ESection section = ESection::Preamble;
+	bool bReachedBorders = false;
+
+	std::size_t position = 0;
+	while (position < inContent.size())
+	{
+		std::size_t lineEnd = inContent.find('\n', position);
+		if (lineEnd == std::string_view::npos)
+		{
+			lineEnd = inContent.size();
+		}
+
+		std::string_view line = trimMapLine(inContent.substr(position, lineEnd - position));
+		position = lineEnd + 1;
+		_currentLine++;
+
+		// section headers
+		if (!line.empty() && line.front() == '[')
+		{
+			if (line == "[continents]" && section == ESection::Preamble)
+			{
+				section = ESection::Continents;
+				continue;
+			}
+			if (line == "[countries]" && section == ESection::Continents)
+			{
+				section = ESection::Countries;
+				continue;
+			}
+			if (line == "[borders]" && section == ESection::Countries)
+			{
+				section = ESection::Borders;
+				bReachedBorders = true;
+				// borders are only linked when everything before them is sound
+				if (!outMap.isValidFile)
+				{
+					break;
+				}
+				continue;
+			}
+		}
+
+		// blank lines and comments are allowed in every section
+		if (line.empty() || line.front() == ';')
+		{
+			continue;
+		}
+
+		switch (section)
+		{
+		case ESection::Continents:
+			parseContinentLine(line, outMap);
+			break;
+		case ESection::Countries:
+			parseCountryLine(line, outMap);
+			break;
+		case ESection::Borders:
+			parseBorderLine(line, outMap);
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (!bReachedBorders)
+	{
+		addError(_currentLine, section == ESection::Preamble ? "missing [continents] section"
+			: section == ESection::Continents ? "missing [countries] section" : "missing [borders] section");
+		outMap.isValidFile = false;
+		return false;
+	}
+
+	if (outMap.isValidFile)
+	{
+		for (auto territory : outMap.listTerritory)
+		{
+			outMap.addTerritoryToContinent(territory);
+		}
+	}
+
+	return outMap.isValidFile;
+}
+
+/*
+	Continent line: <name> <army value> <colour>
+*/
+void MapParser::parseContinentLine(std::string_view inLine, Map& outMap)
+{
+	TokenCursor cursor{ inLine };
+	std::string_view tokens[3];
+	std::string_view extra;
+	int count = 0;
+
+	while (count < 3 && cursor.next(tokens[count]))
+	{
+		count++;
+	}
+
+	int armyValue = 0;
+	if (count != 3 || cursor.next(extra))
+	{
+		addError(_currentLine, "a continent needs a name, an army value and a colour");
+		outMap.isValidFile = false;
+		return;
+	}
+	if (!parseMapNumber(tokens[1], armyValue))
+	{
+		addError(_currentLine, "the continent army value is not a number");
+		outMap.isValidFile = false;
+		return;
+	}
+
+	Continent* continentToCreate = new Continent();
+	continentToCreate->setArmyValue(armyValue);
+	continentToCreate->setName(std::string(tokens[0]));
+	continentToCreate->setColour(std::string(tokens[2]));
+	outMap.listContinents.push_back(continentToCreate);
+}
+
+/*
+	Country line: <id> <name> <continent> <x> <y>, extra columns are ignored
+*/
+void MapParser::parseCountryLine(std::string_view inLine, Map& outMap)
+{
+	TokenCursor cursor{ inLine };
+	std::string_view tokens[5];
+	int count = 0;
+
+	while (count < 5 && cursor.next(tokens[count]))
+	{
+		count++;
+	}
+
+	if (count < 5)
+	{
+		addError(_currentLine, "a country needs an id, a name, a continent and a position");
+		outMap.isValidFile = false;
+		return;
+	}
+
+	int id = 0;
+	int continent = 0;
+	int posx = 0;
+	int posy = 0;
+	if (!parseMapNumber(tokens[0], id) || !parseMapNumber(tokens[2], continent) || !parseMapNumber(tokens[3], posx) || !parseMapNumber(tokens[4], posy))
+	{
+		addError(_currentLine, "the country id, continent and position must be numbers");
+		outMap.isValidFile = false;
+		return;
+	}
+
+	if (continent < 1 || continent > static_cast<int>(outMap.listContinents.size()))
+	{
+		addError(_currentLine, "the country refers to continent " + std::to_string(continent) + " which does not exist");
+		outMap.isValidFile = false;
+		return;
+	}
+
+	if (!_territoryIds.insert(id, static_cast<int32>(outMap.listTerritory.size())))
+	{
+		addError(_currentLine, "territory id " + std::to_string(id) + " is used by another country");
+		outMap.isValidFile = false;
+		return;
+	}
+
+	Territory* territoryToCreate = new Territory();
+	territoryToCreate->setId(id);
+	territoryToCreate->setName(std::string(tokens[1]));
+	territoryToCreate->setContinent(continent);
+	territoryToCreate->setPosx(posx);
+	territoryToCreate->setPosy(posy);
+	outMap.listTerritory.push_back(territoryToCreate);
+}
+
+/*
+	Border line: <territory> <neighbour> <neighbour> ..., every entry is the id of a country line
+*/
+void MapParser::parseBorderLine(std::string_view inLine, Map& outMap)
+{
+	TokenCursor cursor{ inLine };
+	std::string_view token;
+	Territory* targetCountry = nullptr;
+
+	while (cursor.next(token))
+	{
+		int value = 0;
+		int32 index = TerritoryIdIndex::NotFound;
+		bool bIsValidEntry = true;
+		if (!parseMapNumber(token, value))
+		{
+			addError(_currentLine, "border entries must be territory numbers");
+			bIsValidEntry = false;
+		}
+		else if ((index = _territoryIds.find(value)) == TerritoryIdIndex::NotFound)
+		{
+			addError(_currentLine, "territory " + std::to_string(value) + " does not exist");
+			bIsValidEntry = false;
+		}
+
+		if (!bIsValidEntry)
+		{
+			outMap.isValidFile = false;
+			// without a valid first entry the rest of the line has no owner
+			if (targetCountry == nullptr)
+			{
+				return;
+			}
+			continue;
+		}
+
+		Territory* territory = outMap.listTerritory[index];
+		if (targetCountry == nullptr)
+		{
+			targetCountry = territory;
+		}
+		else
+		{
+			targetCountry->getBorderList().push_back(territory);
+		}
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "TerritoryIdIndex.h"
+
+class Map;
+
+// an error found while reading a .map file, line is 1-based
+struct MapParseError
+{
+	int32 line = 0;
+	std::string message;
+};
+
+/*
+	Summary: Loader for the text .map format.
+	The file is memory mapped and the [continents], [countries] and [borders]
+	sections are tokenized in place, only the names kept by the graph get copied.
+*/
+class MapParser {
+public:
+	MapParser();
+
+	// maps inFilePath and fills outMap, returns the validity of the result
+	bool parseFile(const std::string& inFilePath, Map& outMap);
+	// fills outMap from the content of a .map file, returns the validity of the result
+	bool parseBuffer(std::string_view inContent, Map& outMap);
+
+	const std::vector<MapParseError>& getErrors() const;
+	void printErrors(std::ostream& out) const;
+
+private:
+	enum class ESection
+	{
+		Preamble,
+		Continents,
+		Countries,
+		Borders
+	};
+
+	void parseContinentLine(std::string_view inLine, Map& outMap);
+	void parseCountryLine(std::string_view inLine, Map& outMap);
+	void parseBorderLine(std::string_view inLine, Map& outMap);
+
+	void addError(int32 inLine, std::string inMessage);
+
+	int32 _currentLine = 0;
+	std::vector<MapParseError> _errors;
+	// the borders name territories by the id of their country line, which may have gaps
+	TerritoryIdIndex _territoryIds;
+};
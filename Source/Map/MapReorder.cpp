@@ -0,0 +1,182 @@
+#include "MapReorder.h"
+#include "MapGraph.h"
+#include "Common/BitSet.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+namespace
+{
+	// side of the grid the positions are scaled to before walking the curve
+	constexpr uint32 HilbertSide = 1u << 16;
+
+	// distance along the Hilbert curve filling a HilbertSide x HilbertSide grid
+	uint64 hilbertDistance(uint32 inX, uint32 inY)
+	{
+		uint64 distance = 0;
+		for (uint32 half = HilbertSide / 2; half > 0; half /= 2)
+		{
+			const uint32 bRight = (inX & half) != 0 ? 1 : 0;
+			const uint32 bUp = (inY & half) != 0 ? 1 : 0;
+			distance += static_cast<uint64>(half) * half * ((3 * bRight) ^ bUp);
+
+			// rotates the quadrant so the curve enters it the right way
+			if (bUp == 0)
+			{
+				if (bRight == 1)
+				{
+					inX = HilbertSide - 1 - inX;
+					inY = HilbertSide - 1 - inY;
+				}
+				std::swap(inX, inY);
+			}
+		}
+		return distance;
+	}
+}
+
+void MapReorder::computeOrder(const MapGraph& inGraph, const std::vector<int32>& inPosx, const std::vector<int32>& inPosy,
+	EMapOrdering inOrdering, std::vector<int32>& outOrder)
+{
+	const int32 territoryCount = inGraph.getTerritoryCount();
+	outOrder.clear();
+	outOrder.reserve(territoryCount);
+
+	switch (inOrdering)
+	{
+	case EMapOrdering::BreadthFirst:
+		breadthFirstOrder(inGraph, false, outOrder);
+		break;
+	case EMapOrdering::ReverseCuthillMcKee:
+		breadthFirstOrder(inGraph, true, outOrder);
+		std::reverse(outOrder.begin(), outOrder.end());
+		break;
+	case EMapOrdering::Hilbert:
+		if (static_cast<int32>(inPosx.size()) == territoryCount && static_cast<int32>(inPosy.size()) == territoryCount)
+		{
+			hilbertOrder(inPosx, inPosy, outOrder);
+			break;
+		}
+		// without positions there is nothing to sort on, the file order is kept
+		[[fallthrough]];
+	case EMapOrdering::File:
+	default:
+		for (int32 i = 0; i < territoryCount; i++)
+		{
+			outOrder.push_back(i);
+		}
+		break;
+	}
+}
+
+const char* MapReorder::getOrderingName(EMapOrdering inOrdering)
+{
+	switch (inOrdering)
+	{
+	case EMapOrdering::BreadthFirst: return "bfs";
+	case EMapOrdering::ReverseCuthillMcKee: return "rcm";
+	case EMapOrdering::Hilbert: return "hilbert";
+	case EMapOrdering::File:
+	default: return "file";
+	}
+}
+
+double MapReorder::getAverageBorderSpan(const MapGraph& inGraph)
+{
+	double totalSpan = 0.0;
+	for (int32 i = 0; i < inGraph.getTerritoryCount(); i++)
+	{
+		for (int32 neighbour : inGraph.getNeighbours(i))
+		{
+			totalSpan += std::abs(neighbour - i);
+		}
+	}
+	return inGraph.getEdgeCount() > 0 ? totalSpan / inGraph.getEdgeCount() : 0.0;
+}
+
+void MapReorder::breadthFirstOrder(const MapGraph& inGraph, bool bInByDegree, std::vector<int32>& outOrder)
+{
+	const int32 territoryCount = inGraph.getTerritoryCount();
+	BitSet visited(territoryCount);
+
+	// Cuthill-McKee starts every group from its least connected territory, seeds are tried by rising degree
+	std::vector<int32> seeds(territoryCount);
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		seeds[i] = i;
+	}
+	if (bInByDegree)
+	{
+		std::stable_sort(seeds.begin(), seeds.end(), [&inGraph](int32 inLHS, int32 inRHS)
+		{
+			return inGraph.getDegree(inLHS) < inGraph.getDegree(inRHS);
+		});
+	}
+
+	std::vector<int32> discovered;
+	for (int32 seed : seeds)
+	{
+		if (visited.test(seed))
+		{
+			continue;
+		}
+
+		// outOrder doubles as the queue, everything behind head is still to expand
+		std::size_t head = outOrder.size();
+		outOrder.push_back(seed);
+		visited.set(seed);
+
+		while (head < outOrder.size())
+		{
+			const int32 current = outOrder[head++];
+			discovered.clear();
+			for (int32 neighbour : inGraph.getNeighbours(current))
+			{
+				if (!visited.test(neighbour))
+				{
+					visited.set(neighbour);
+					discovered.push_back(neighbour);
+				}
+			}
+			if (bInByDegree)
+			{
+				std::stable_sort(discovered.begin(), discovered.end(), [&inGraph](int32 inLHS, int32 inRHS)
+				{
+					return inGraph.getDegree(inLHS) < inGraph.getDegree(inRHS);
+				});
+			}
+			outOrder.insert(outOrder.end(), discovered.begin(), discovered.end());
+		}
+	}
+}
+
+void MapReorder::hilbertOrder(const std::vector<int32>& inPosx, const std::vector<int32>& inPosy, std::vector<int32>& outOrder)
+{
+	const int32 territoryCount = static_cast<int32>(inPosx.size());
+	if (territoryCount == 0)
+	{
+		return;
+	}
+
+	const auto rangeX = std::minmax_element(inPosx.begin(), inPosx.end());
+	const auto rangeY = std::minmax_element(inPosy.begin(), inPosy.end());
+	const double spanX = std::max(1.0, static_cast<double>(*rangeX.second) - *rangeX.first);
+	const double spanY = std::max(1.0, static_cast<double>(*rangeY.second) - *rangeY.first);
+
+	// positions are scaled to the curve grid, territories on the same cell keep their file order
+	std::vector<std::pair<uint64, int32>> keys(territoryCount);
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		const uint32 cellX = static_cast<uint32>((static_cast<double>(inPosx[i]) - *rangeX.first) / spanX * (HilbertSide - 1));
+		const uint32 cellY = static_cast<uint32>((static_cast<double>(inPosy[i]) - *rangeY.first) / spanY * (HilbertSide - 1));
+		keys[i] = std::make_pair(hilbertDistance(cellX, cellY), i);
+	}
+	std::sort(keys.begin(), keys.end());
+
+	for (const auto& key : keys)
+	{
+		outOrder.push_back(key.second);
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+class MapGraph;
+
+// order given to the dense territory indexes of a map
+enum class EMapOrdering
+{
+	// as listed in the [countries] section
+	File,
+	// breadth first from territory 0, every territory lands next to the one that reached it
+	BreadthFirst,
+	// reverse Cuthill-McKee, breadth first from low degree territories with neighbours taken by degree
+	ReverseCuthillMcKee,
+	// territories sorted along a Hilbert curve through their map positions
+	Hilbert
+};
+
+/*
+	Summary: Computes a new order for the territories of a map so that bordering
+	territories get close dense indexes. Traversals then read neighbouring entries
+	of the graph and the state arrays instead of jumping across the whole map.
+	Only the order is computed, the map applies it and keeps the file ids.
+*/
+class MapReorder {
+public:
+	// outOrder[newIndex] is the current index of the territory placed at newIndex.
+	// inPosx and inPosy are only read by the Hilbert ordering.
+	static void computeOrder(const MapGraph& inGraph, const std::vector<int32>& inPosx, const std::vector<int32>& inPosy,
+		EMapOrdering inOrdering, std::vector<int32>& outOrder);
+
+	static const char* getOrderingName(EMapOrdering inOrdering);
+
+	// average distance between the dense indexes of bordering territories, lower is better for the caches
+	static double getAverageBorderSpan(const MapGraph& inGraph);
+
+private:
+	static void breadthFirstOrder(const MapGraph& inGraph, bool bInByDegree, std::vector<int32>& outOrder);
+	static void hilbertOrder(const std::vector<int32>& inPosx, const std::vector<int32>& inPosy, std::vector<int32>& outOrder);
+};
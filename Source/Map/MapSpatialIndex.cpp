@@ -0,0 +1,243 @@
+#include "MapSpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace
+{
+	int64 squaredDistance(int64 inX, int64 inY, int32 inPosX, int32 inPosY)
+	{
+		const int64 dx = inPosX - inX;
+		const int64 dy = inPosY - inY;
+		return dx * dx + dy * dy;
+	}
+}
+
+MapSpatialIndex::MapSpatialIndex()
+{
+}
+
+void MapSpatialIndex::build(const std::vector<int32>& inPosx, const std::vector<int32>& inPosy)
+{
+	_territoryCount = static_cast<int32>(std::min(inPosx.size(), inPosy.size()));
+	_cellStart.assign(1, 0);
+	_territories.clear();
+	_posx.clear();
+	_posy.clear();
+	_columnCount = 0;
+	_rowCount = 0;
+	if (_territoryCount == 0)
+	{
+		return;
+	}
+
+	const auto rangeX = std::minmax_element(inPosx.begin(), inPosx.begin() + _territoryCount);
+	const auto rangeY = std::minmax_element(inPosy.begin(), inPosy.begin() + _territoryCount);
+	_minX = *rangeX.first;
+	_minY = *rangeY.first;
+	const int64 spanX = static_cast<int64>(*rangeX.second) - _minX + 1;
+	const int64 spanY = static_cast<int64>(*rangeY.second) - _minY + 1;
+
+	// the cells follow the shape of the bounding box so a long thin map does not get empty rows
+	const int64 targetCells = std::max(1, _territoryCount / TerritoriesPerCell);
+	int64 columns = std::llround(std::sqrt(static_cast<double>(targetCells) * spanX / spanY));
+	columns = std::max<int64>(1, std::min(columns, std::min(targetCells, spanX)));
+	int64 rows = std::max<int64>(1, std::min(targetCells / columns, spanY));
+
+	_cellWidth = static_cast<int32>((spanX + columns - 1) / columns);
+	_cellHeight = static_cast<int32>((spanY + rows - 1) / rows);
+	_columnCount = static_cast<int32>((spanX + _cellWidth - 1) / _cellWidth);
+	_rowCount = static_cast<int32>((spanY + _cellHeight - 1) / _cellHeight);
+
+	// counting sort of the territories by cell
+	std::vector<int32> cells(_territoryCount);
+	_cellStart.assign(static_cast<std::size_t>(_columnCount) * _rowCount + 1, 0);
+	for (int32 i = 0; i < _territoryCount; i++)
+	{
+		cells[i] = getRow(inPosy[i]) * _columnCount + getColumn(inPosx[i]);
+		_cellStart[cells[i] + 1]++;
+	}
+	for (std::size_t c = 1; c < _cellStart.size(); c++)
+	{
+		_cellStart[c] += _cellStart[c - 1];
+	}
+
+	_territories.resize(_territoryCount);
+	_posx.resize(_territoryCount);
+	_posy.resize(_territoryCount);
+	std::vector<int32> next(_cellStart.begin(), _cellStart.end() - 1);
+	for (int32 i = 0; i < _territoryCount; i++)
+	{
+		const int32 entry = next[cells[i]]++;
+		_territories[entry] = i;
+		_posx[entry] = inPosx[i];
+		_posy[entry] = inPosy[i];
+	}
+}
+
+int32 MapSpatialIndex::getTerritoryCount() const
+{
+	return _territoryCount;
+}
+
+int32 MapSpatialIndex::getColumnCount() const
+{
+	return _columnCount;
+}
+
+int32 MapSpatialIndex::getRowCount() const
+{
+	return _rowCount;
+}
+
+void MapSpatialIndex::findInRect(int32 inMinX, int32 inMinY, int32 inMaxX, int32 inMaxY, std::vector<int32>& outIndexes) const
+{
+	outIndexes.clear();
+	if (_territoryCount == 0 || inMinX > inMaxX || inMinY > inMaxY)
+	{
+		return;
+	}
+
+	const int32 firstColumn = getColumn(inMinX);
+	const int32 lastColumn = getColumn(inMaxX);
+	const int32 firstRow = getRow(inMinY);
+	const int32 lastRow = getRow(inMaxY);
+	for (int32 row = firstRow; row <= lastRow; row++)
+	{
+		// the cells of a row are contiguous, the whole span is scanned in one go
+		const int32 first = _cellStart[row * _columnCount + firstColumn];
+		const int32 last = _cellStart[row * _columnCount + lastColumn + 1];
+		for (int32 entry = first; entry < last; entry++)
+		{
+			if (_posx[entry] >= inMinX && _posx[entry] <= inMaxX && _posy[entry] >= inMinY && _posy[entry] <= inMaxY)
+			{
+				outIndexes.push_back(_territories[entry]);
+			}
+		}
+	}
+	std::sort(outIndexes.begin(), outIndexes.end());
+}
+
+void MapSpatialIndex::findInRadius(int32 inX, int32 inY, int32 inRadius, std::vector<int32>& outIndexes) const
+{
+	outIndexes.clear();
+	if (_territoryCount == 0 || inRadius < 0)
+	{
+		return;
+	}
+
+	const int64 radius = inRadius;
+	const int32 firstColumn = getColumn(static_cast<int32>(std::max<int64>(inX - radius, std::numeric_limits<int32>::min())));
+	const int32 lastColumn = getColumn(static_cast<int32>(std::min<int64>(inX + radius, std::numeric_limits<int32>::max())));
+	const int32 firstRow = getRow(static_cast<int32>(std::max<int64>(inY - radius, std::numeric_limits<int32>::min())));
+	const int32 lastRow = getRow(static_cast<int32>(std::min<int64>(inY + radius, std::numeric_limits<int32>::max())));
+	for (int32 row = firstRow; row <= lastRow; row++)
+	{
+		const int32 first = _cellStart[row * _columnCount + firstColumn];
+		const int32 last = _cellStart[row * _columnCount + lastColumn + 1];
+		for (int32 entry = first; entry < last; entry++)
+		{
+			if (squaredDistance(inX, inY, _posx[entry], _posy[entry]) <= radius * radius)
+			{
+				outIndexes.push_back(_territories[entry]);
+			}
+		}
+	}
+	std::sort(outIndexes.begin(), outIndexes.end());
+}
+
+void MapSpatialIndex::findNearest(int32 inX, int32 inY, int32 inCount, std::vector<int32>& outIndexes) const
+{
+	outIndexes.clear();
+	const int32 count = std::min(inCount, _territoryCount);
+	if (count <= 0)
+	{
+		return;
+	}
+
+	// max-heap of the closest territories found so far, (squared distance, index)
+	std::vector<std::pair<int64, int32>> closest;
+	closest.reserve(count + 1);
+
+	const int32 centerColumn = getColumn(inX);
+	const int32 centerRow = getRow(inY);
+	const int32 ringCount = std::max(_columnCount, _rowCount);
+	for (int32 ring = 0; ring <= ringCount; ring++)
+	{
+		if (ring > 0 && static_cast<int32>(closest.size()) == count)
+		{
+			// anything on this ring lies outside the square of cells already searched,
+			// the search stops once that square holds a circle through the farthest kept territory
+			const int64 noBound = std::numeric_limits<int64>::max();
+			const int64 left = centerColumn - ring + 1 > 0 ? static_cast<int64>(inX) - _minX - static_cast<int64>(centerColumn - ring + 1) * _cellWidth : noBound;
+			const int64 right = centerColumn + ring < _columnCount ? static_cast<int64>(_minX) + static_cast<int64>(centerColumn + ring) * _cellWidth - inX : noBound;
+			const int64 bottom = centerRow - ring + 1 > 0 ? static_cast<int64>(inY) - _minY - static_cast<int64>(centerRow - ring + 1) * _cellHeight : noBound;
+			const int64 top = centerRow + ring < _rowCount ? static_cast<int64>(_minY) + static_cast<int64>(centerRow + ring) * _cellHeight - inY : noBound;
+			const int64 bound = std::max<int64>(0, std::min(std::min(left, right), std::min(bottom, top)));
+			if (bound == noBound || bound * bound > closest.front().first)
+			{
+				break;
+			}
+		}
+
+		for (int32 row = centerRow - ring; row <= centerRow + ring; row++)
+		{
+			if (row < 0 || row >= _rowCount)
+			{
+				continue;
+			}
+			// the first and last rows of the ring are read whole, the others only at both ends
+			const bool bIsEdgeRow = row == centerRow - ring || row == centerRow + ring;
+			const int32 step = bIsEdgeRow || ring == 0 ? 1 : 2 * ring;
+			for (int32 column = centerColumn - ring; column <= centerColumn + ring; column += step)
+			{
+				if (column < 0 || column >= _columnCount)
+				{
+					continue;
+				}
+				const int32 cell = row * _columnCount + column;
+				for (int32 entry = _cellStart[cell]; entry < _cellStart[cell + 1]; entry++)
+				{
+					const std::pair<int64, int32> candidate(squaredDistance(inX, inY, _posx[entry], _posy[entry]), _territories[entry]);
+					if (static_cast<int32>(closest.size()) < count)
+					{
+						closest.push_back(candidate);
+						std::push_heap(closest.begin(), closest.end());
+					}
+					else if (candidate < closest.front())
+					{
+						std::pop_heap(closest.begin(), closest.end());
+						closest.back() = candidate;
+						std::push_heap(closest.begin(), closest.end());
+					}
+				}
+			}
+		}
+	}
+
+	std::sort_heap(closest.begin(), closest.end());
+	outIndexes.reserve(closest.size());
+	for (const auto& found : closest)
+	{
+		outIndexes.push_back(found.second);
+	}
+}
+
+std::size_t MapSpatialIndex::getMemoryUsage() const
+{
+	return (_cellStart.capacity() + _territories.capacity() + _posx.capacity() + _posy.capacity()) * sizeof(int32);
+}
+
+int32 MapSpatialIndex::getColumn(int32 inX) const
+{
+	const int64 column = (static_cast<int64>(inX) - _minX) / _cellWidth;
+	return static_cast<int32>(std::max<int64>(0, std::min<int64>(column, _columnCount - 1)));
+}
+
+int32 MapSpatialIndex::getRow(int32 inY) const
+{
+	const int64 row = (static_cast<int64>(inY) - _minY) / _cellHeight;
+	return static_cast<int32>(std::max<int64>(0, std::min<int64>(row, _rowCount - 1)));
+}
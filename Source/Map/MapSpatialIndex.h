@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+/*
+	Summary: Uniform grid over the map positions of the territories, built once when a map is loaded.
+	The bounding box of the positions is cut in about territoryCount / TerritoriesPerCell cells,
+	every cell lists its territories contiguously with their positions so a query only reads
+	the cells it overlaps. Results are dense territory indexes, like the graph.
+	Squared distances are kept in 64 bits, positions and queries are expected within +-10^9.
+*/
+class MapSpatialIndex {
+public:
+	static constexpr int32 TerritoriesPerCell = 2;
+
+	MapSpatialIndex();
+
+	// inPosx[i] and inPosy[i] are the position of the territory with dense index i
+	void build(const std::vector<int32>& inPosx, const std::vector<int32>& inPosy);
+
+	int32 getTerritoryCount() const;
+	int32 getColumnCount() const;
+	int32 getRowCount() const;
+
+	// territories with inMinX <= x <= inMaxX and inMinY <= y <= inMaxY, in rising index order
+	void findInRect(int32 inMinX, int32 inMinY, int32 inMaxX, int32 inMaxY, std::vector<int32>& outIndexes) const;
+	// territories at most inRadius away from (inX, inY), in rising index order
+	void findInRadius(int32 inX, int32 inY, int32 inRadius, std::vector<int32>& outIndexes) const;
+	// the inCount territories closest to (inX, inY), closest first. Equal distances go by index.
+	void findNearest(int32 inX, int32 inY, int32 inCount, std::vector<int32>& outIndexes) const;
+
+	std::size_t getMemoryUsage() const;
+
+private:
+	int32 getColumn(int32 inX) const;
+	int32 getRow(int32 inY) const;
+
+	int32 _territoryCount = 0;
+	int32 _minX = 0;
+	int32 _minY = 0;
+	int32 _columnCount = 0;
+	int32 _rowCount = 0;
+	int32 _cellWidth = 1;
+	int32 _cellHeight = 1;
+
+	// cell c holds the entries _cellStart[c] to _cellStart[c + 1], cells are stored row by row
+	std::vector<int32> _cellStart;
+	std::vector<int32> _territories;
+	std::vector<int32> _posx;
+	std::vector<int32> _posy;
+};
@@ -0,0 +1,505 @@
+#include "MapStreamLoader.h"
+#include "MapTextTokens.h"
+
+#include <fstream>
+#include <utility>
+
+int32 MapTopology::getTerritoryCount() const
+{
+	return static_cast<int32>(territoryIds.size());
+}
+
+int32 MapTopology::getContinentCount() const
+{
+	return static_cast<int32>(continentArmyValues.size());
+}
+
+std::string_view MapTopology::getTerritoryName(int32 inIndex) const
+{
+	return std::string_view(names).substr(nameOffsets[inIndex], nameOffsets[inIndex + 1] - nameOffsets[inIndex]);
+}
+
+std::size_t MapTopology::getMemoryUsage() const
+{
+	std::size_t bytes = names.capacity();
+	bytes += (territoryIds.capacity() + territoryPosx.capacity() + territoryPosy.capacity()) * sizeof(int32);
+	bytes += nameOffsets.capacity() * sizeof(uint32);
+	if (graph)
+	{
+		bytes += (graph->getOffsets().size() + graph->getNeighbourIndexes().size() + graph->getTerritoryCount()) * sizeof(int32);
+	}
+	return bytes;
+}
+
+MapStreamLoader::MapStreamLoader(std::size_t inChunkSize)
+	: _chunkSize(inChunkSize > 0 ? inChunkSize : DefaultChunkSize)
+{
+}
+
+const std::vector<MapParseError>& MapStreamLoader::getErrors() const
+{
+	return _errors;
+}
+
+void MapStreamLoader::printErrors(std::ostream& out) const
+{
+	for (const auto& error : _errors)
+	{
+		out << "Line " << error.line << ": " << error.message << std::endl;
+	}
+}
+
+void MapStreamLoader::addError(std::string inMessage)
+{
+	if (_errors.size() >= MaxErrors)
+	{
+		bIsDone = true;
+		return;
+	}
+
+	MapParseError error;
+	error.line = _currentLine;
+	error.message = std::move(inMessage);
+	_errors.push_back(std::move(error));
+}
+
+bool MapStreamLoader::hasFailed() const
+{
+	return !_errors.empty();
+}
+
+bool MapStreamLoader::loadFile(const std::string& inFilePath, MapTopology& outTopology)
+{
+	outTopology = MapTopology();
+	_topology = &outTopology;
+	_errors.clear();
+	_fileSize = 0;
+	_territoryCount = 0;
+	_nameBytes = 0;
+	_borderCount = 0;
+	_continentSizes.clear();
+	_territoryIds.clear();
+	_offsets.clear();
+
+	if (!streamFile(inFilePath, EPass::Counting) || hasFailed())
+	{
+		outTopology = MapTopology();
+		_topology = nullptr;
+		return false;
+	}
+
+	// everything is sized now, the borders were counted into _offsets[i + 1]
+	for (int32 i = 0; i < _territoryCount; i++)
+	{
+		_offsets[i + 1] += _offsets[i];
+	}
+	_neighbours.assign(_borderCount, 0);
+	_continents.assign(_territoryCount, 0);
+	outTopology.territoryIds.assign(_territoryCount, 0);
+	outTopology.territoryPosx.assign(_territoryCount, 0);
+	outTopology.territoryPosy.assign(_territoryCount, 0);
+	outTopology.nameOffsets.assign(_territoryCount + 1, 0);
+	outTopology.names.reserve(_nameBytes);
+	_filledTerritories = 0;
+
+	const std::size_t countedSize = _fileSize;
+	const bool bWasFilled = streamFile(inFilePath, EPass::Filling);
+
+	// filling moved every row start to the end of its row, shift them back in place
+	for (int32 i = _territoryCount; i > 0; i--)
+	{
+		_offsets[i] = _offsets[i - 1];
+	}
+	_offsets[0] = 0;
+
+	if (!bWasFilled || _fileSize != countedSize || _filledTerritories != _territoryCount
+		|| _offsets[_territoryCount] != static_cast<int32>(_borderCount))
+	{
+		if (!hasFailed())
+		{
+			addError("the file changed while it was loaded");
+		}
+		outTopology = MapTopology();
+		_topology = nullptr;
+		return false;
+	}
+
+	std::shared_ptr<MapGraph> graph = std::make_shared<MapGraph>();
+	graph->assign(std::move(_offsets), std::move(_neighbours), std::move(_continents), outTopology.getContinentCount());
+	outTopology.graph = graph;
+
+	_offsets = std::vector<int32>();
+	_neighbours = std::vector<int32>();
+	_continents = std::vector<int32>();
+	_continentSizes = std::vector<int32>();
+	_territoryIds.clear();
+	_topology = nullptr;
+	return true;
+}
+
+bool MapStreamLoader::streamFile(const std::string& inFilePath, EPass inPass)
+{
+	std::ifstream input(inFilePath, std::ios::binary);
+	if (!input)
+	{
+		_currentLine = 0;
+		addError("cannot open " + inFilePath);
+		return false;
+	}
+
+	_pass = inPass;
+	_section = ESection::Preamble;
+	_currentLine = 0;
+	_fileSize = 0;
+	bIsDone = false;
+	_pendingLine.clear();
+	_chunk.resize(_chunkSize);
+
+	while (!bIsDone)
+	{
+		input.read(_chunk.data(), static_cast<std::streamsize>(_chunk.size()));
+		const std::size_t readSize = static_cast<std::size_t>(input.gcount());
+		if (readSize == 0)
+		{
+			break;
+		}
+		_fileSize += readSize;
+
+		std::string_view chunk(_chunk.data(), readSize);
+		std::size_t position = 0;
+		while (!bIsDone)
+		{
+			std::size_t lineEnd = chunk.find('\n', position);
+			if (lineEnd == std::string_view::npos)
+			{
+				// the line goes on in the next chunk, only this piece is copied
+				_pendingLine.append(chunk.data() + position, chunk.size() - position);
+				break;
+			}
+
+			if (_pendingLine.empty())
+			{
+				processLine(chunk.substr(position, lineEnd - position));
+			}
+			else
+			{
+				_pendingLine.append(chunk.data() + position, lineEnd - position);
+				processLine(_pendingLine);
+				_pendingLine.clear();
+			}
+			position = lineEnd + 1;
+		}
+	}
+
+	// the last line has no line break
+	if (!bIsDone && !_pendingLine.empty())
+	{
+		processLine(_pendingLine);
+	}
+	_pendingLine = std::string();
+
+	if (_pass == EPass::Counting && !bIsDone && _section != ESection::Borders)
+	{
+		addError(_section == ESection::Preamble ? "missing [continents] section"
+			: _section == ESection::Continents ? "missing [countries] section" : "missing [borders] section");
+	}
+	return true;
+}
+
+void MapStreamLoader::processLine(std::string_view inLine)
+{
+	std::string_view line = trimMapLine(inLine);
+	_currentLine++;
+
+	if (!line.empty() && line.front() == '[' && enterSection(line))
+	{
+		return;
+	}
+
+	// blank lines and comments are allowed in every section
+	if (line.empty() || line.front() == ';')
+	{
+		return;
+	}
+
+	if (_pass == EPass::Counting)
+	{
+		switch (_section)
+		{
+		case ESection::Continents:
+			countContinentLine(line);
+			break;
+		case ESection::Countries:
+			countCountryLine(line);
+			break;
+		case ESection::Borders:
+			countBorderLine(line);
+			break;
+		default:
+			break;
+		}
+	}
+	else
+	{
+		switch (_section)
+		{
+		case ESection::Countries:
+			fillCountryLine(line);
+			break;
+		case ESection::Borders:
+			fillBorderLine(line);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+bool MapStreamLoader::enterSection(std::string_view inLine)
+{
+	ESection next = _section;
+	if (inLine == "[continents]" && _section == ESection::Preamble)
+	{
+		next = ESection::Continents;
+	}
+	else if (inLine == "[countries]" && _section == ESection::Continents)
+	{
+		next = ESection::Countries;
+	}
+	else if (inLine == "[borders]" && _section == ESection::Countries)
+	{
+		next = ESection::Borders;
+	}
+	else
+	{
+		return false;
+	}
+
+	if (_pass == EPass::Counting)
+	{
+		closeSection();
+	}
+	_section = next;
+
+	// the borders refer to territories by position, they mean nothing once a country was dropped
+	if (_pass == EPass::Counting && _section == ESection::Borders)
+	{
+		if (hasFailed())
+		{
+			bIsDone = true;
+			return true;
+		}
+		_offsets.assign(_territoryCount + 1, 0);
+	}
+	return true;
+}
+
+void MapStreamLoader::closeSection()
+{
+	if (_section == ESection::Continents && _topology->continentArmyValues.empty())
+	{
+		addError("the [continents] section is empty");
+	}
+	else if (_section == ESection::Countries)
+	{
+		if (_territoryCount == 0)
+		{
+			addError("the [countries] section is empty");
+		}
+		for (std::size_t c = 0; c < _continentSizes.size(); c++)
+		{
+			if (_continentSizes[c] == 0)
+			{
+				addError("continent " + _topology->continentNames[c] + " has no territory");
+			}
+		}
+	}
+}
+
+/*
+	Continent line: <name> <army value> <colour>
+	The continents are few, they are stored as soon as they are counted.
+*/
+void MapStreamLoader::countContinentLine(std::string_view inLine)
+{
+	TokenCursor cursor{ inLine };
+	std::string_view tokens[3];
+	std::string_view extra;
+	int count = 0;
+
+	while (count < 3 && cursor.next(tokens[count]))
+	{
+		count++;
+	}
+
+	int armyValue = 0;
+	if (count != 3 || cursor.next(extra))
+	{
+		addError("a continent needs a name, an army value and a colour");
+		return;
+	}
+	if (!parseMapNumber(tokens[1], armyValue))
+	{
+		addError("the continent army value is not a number");
+		return;
+	}
+
+	_topology->continentNames.emplace_back(tokens[0]);
+	_topology->continentColours.emplace_back(tokens[2]);
+	_topology->continentArmyValues.push_back(armyValue);
+	_continentSizes.push_back(0);
+}
+
+/*
+	Country line: <id> <name> <continent> <x> <y>, extra columns are ignored
+*/
+void MapStreamLoader::countCountryLine(std::string_view inLine)
+{
+	TokenCursor cursor{ inLine };
+	std::string_view tokens[5];
+	int count = 0;
+
+	while (count < 5 && cursor.next(tokens[count]))
+	{
+		count++;
+	}
+
+	if (count < 5)
+	{
+		addError("a country needs an id, a name, a continent and a position");
+		return;
+	}
+
+	int id = 0;
+	int continent = 0;
+	int posx = 0;
+	int posy = 0;
+	if (!parseMapNumber(tokens[0], id) || !parseMapNumber(tokens[2], continent) || !parseMapNumber(tokens[3], posx) || !parseMapNumber(tokens[4], posy))
+	{
+		addError("the country id, continent and position must be numbers");
+		return;
+	}
+
+	if (continent < 1 || continent > static_cast<int>(_continentSizes.size()))
+	{
+		addError("the country refers to continent " + std::to_string(continent) + " which does not exist");
+		return;
+	}
+
+	if (!_territoryIds.insert(id, _territoryCount))
+	{
+		addError("territory id " + std::to_string(id) + " is used by another country");
+		return;
+	}
+
+	_continentSizes[continent - 1]++;
+	_territoryCount++;
+	_nameBytes += tokens[1].size();
+}
+
+/*
+	Border line: <territory> <neighbour> <neighbour> ...
+*/
+void MapStreamLoader::countBorderLine(std::string_view inLine)
+{
+	TokenCursor cursor{ inLine };
+	std::string_view token;
+	int32 owner = TerritoryIdIndex::NotFound;
+
+	while (cursor.next(token))
+	{
+		int value = 0;
+		int32 index = TerritoryIdIndex::NotFound;
+		if (!parseMapNumber(token, value))
+		{
+			addError("border entries must be territory numbers");
+		}
+		else if ((index = _territoryIds.find(value)) == TerritoryIdIndex::NotFound)
+		{
+			addError("territory " + std::to_string(value) + " does not exist");
+		}
+		else if (owner == TerritoryIdIndex::NotFound)
+		{
+			owner = index;
+		}
+		else
+		{
+			_offsets[owner + 1]++;
+			_borderCount++;
+		}
+
+		// without a valid first entry the rest of the line has no owner
+		if (owner == TerritoryIdIndex::NotFound)
+		{
+			return;
+		}
+	}
+}
+
+// the counting pass already checked the line, it only has to be stored
+void MapStreamLoader::fillCountryLine(std::string_view inLine)
+{
+	if (_filledTerritories >= _territoryCount)
+	{
+		_filledTerritories++;
+		bIsDone = true;
+		return;
+	}
+
+	TokenCursor cursor{ inLine };
+	std::string_view tokens[5];
+	int count = 0;
+	while (count < 5 && cursor.next(tokens[count]))
+	{
+		count++;
+	}
+
+	int id = 0;
+	int continent = 0;
+	int posx = 0;
+	int posy = 0;
+	parseMapNumber(tokens[0], id);
+	parseMapNumber(tokens[2], continent);
+	parseMapNumber(tokens[3], posx);
+	parseMapNumber(tokens[4], posy);
+
+	const int32 index = _filledTerritories++;
+	_topology->territoryIds[index] = id;
+	_topology->territoryPosx[index] = posx;
+	_topology->territoryPosy[index] = posy;
+	_continents[index] = continent - 1;
+
+	_topology->names.append(tokens[1].data(), tokens[1].size());
+	_topology->nameOffsets[index + 1] = static_cast<uint32>(_topology->names.size());
+}
+
+void MapStreamLoader::fillBorderLine(std::string_view inLine)
+{
+	TokenCursor cursor{ inLine };
+	std::string_view token;
+	int32 owner = TerritoryIdIndex::NotFound;
+
+	while (cursor.next(token))
+	{
+		int value = 0;
+		int32 index = TerritoryIdIndex::NotFound;
+		if (!parseMapNumber(token, value) || (index = _territoryIds.find(value)) == TerritoryIdIndex::NotFound)
+		{
+			continue;
+		}
+		if (owner == TerritoryIdIndex::NotFound)
+		{
+			owner = index;
+			continue;
+		}
+
+		// _offsets[owner] is the next free slot of the row while filling
+		int32& slot = _offsets[owner];
+		if (slot >= static_cast<int32>(_borderCount))
+		{
+			bIsDone = true;
+			return;
+		}
+		_neighbours[slot++] = index;
+	}
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "MapGraph.h"
+#include "MapParser.h"
+#include "TerritoryIdIndex.h"
+
+/*
+	Summary: Flat topology of a map loaded by the MapStreamLoader.
+	Territories are addressed by their dense index like in the MapGraph, every table
+	is allocated once with its final size and nothing is stored per Territory object.
+*/
+struct MapTopology
+{
+	std::vector<std::string> continentNames;
+	std::vector<std::string> continentColours;
+	std::vector<int32> continentArmyValues;
+
+	std::vector<int32> territoryIds;
+	std::vector<int32> territoryPosx;
+	std::vector<int32> territoryPosy;
+	// the name of territory i is names[nameOffsets[i] .. nameOffsets[i + 1])
+	std::vector<uint32> nameOffsets;
+	std::string names;
+
+	std::shared_ptr<const MapGraph> graph;
+
+	int32 getTerritoryCount() const;
+	int32 getContinentCount() const;
+	std::string_view getTerritoryName(int32 inIndex) const;
+
+	// bytes held by the tables and the graph
+	std::size_t getMemoryUsage() const;
+};
+
+/*
+	Summary: Loads very large text .map files with a bounded amount of memory.
+	The file is read twice in fixed-size chunks, never mapped or held whole.
+	The counting pass checks every section as it arrives and sizes the tables,
+	so a malformed file is rejected before anything big is allocated.
+	The filling pass then writes the territories and the borders straight into
+	their final arrays, the peak memory stays close to the size of the topology.
+*/
+class MapStreamLoader {
+public:
+	static constexpr std::size_t DefaultChunkSize = 1 << 20;
+	// errors kept after this many, the counting pass stops reading
+	static constexpr std::size_t MaxErrors = 100;
+
+	explicit MapStreamLoader(std::size_t inChunkSize = DefaultChunkSize);
+
+	// fills outTopology from the .map file at inFilePath, returns false if the file cannot be used
+	bool loadFile(const std::string& inFilePath, MapTopology& outTopology);
+
+	const std::vector<MapParseError>& getErrors() const;
+	void printErrors(std::ostream& out) const;
+
+private:
+	enum class EPass
+	{
+		Counting,
+		Filling
+	};
+
+	enum class ESection
+	{
+		Preamble,
+		Continents,
+		Countries,
+		Borders
+	};
+
+	// feeds every line of the file to processLine, a chunk at a time
+	bool streamFile(const std::string& inFilePath, EPass inPass);
+	void processLine(std::string_view inLine);
+	bool enterSection(std::string_view inLine);
+	void closeSection();
+
+	void countContinentLine(std::string_view inLine);
+	void countCountryLine(std::string_view inLine);
+	void countBorderLine(std::string_view inLine);
+	void fillCountryLine(std::string_view inLine);
+	void fillBorderLine(std::string_view inLine);
+
+	void addError(std::string inMessage);
+	bool hasFailed() const;
+
+	std::size_t _chunkSize;
+	std::vector<char> _chunk;
+	// start of a line cut by the end of a chunk
+	std::string _pendingLine;
+
+	EPass _pass = EPass::Counting;
+	ESection _section = ESection::Preamble;
+	int32 _currentLine = 0;
+	bool bIsDone = false;
+	std::vector<MapParseError> _errors;
+
+	// sizes found by the counting pass
+	std::size_t _fileSize = 0;
+	int32 _territoryCount = 0;
+	std::size_t _nameBytes = 0;
+	std::size_t _borderCount = 0;
+	// territories of every continent, checked when the [countries] section ends
+	std::vector<int32> _continentSizes;
+	// dense index of the id of every country line, filled by the counting pass and read by both
+	TerritoryIdIndex _territoryIds;
+
+	// tables being filled
+	MapTopology* _topology = nullptr;
+	std::vector<int32> _offsets;
+	std::vector<int32> _neighbours;
+	std::vector<int32> _continents;
+	int32 _filledTerritories = 0;
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+#include <system_error>
+
+// helpers shared by the readers of the text .map format
+
+// walks the blank separated tokens of a line without copying them
+struct TokenCursor
+{
+	std::string_view rest;
+
+	bool next(std::string_view& outToken)
+	{
+		std::size_t start = rest.find_first_not_of(" \t");
+		if (start == std::string_view::npos)
+		{
+			rest = std::string_view();
+			return false;
+		}
+
+		std::size_t end = rest.find_first_of(" \t", start);
+		if (end == std::string_view::npos)
+		{
+			end = rest.size();
+		}
+
+		outToken = rest.substr(start, end - start);
+		rest.remove_prefix(end);
+		return true;
+	}
+};
+
+// only plain unsigned numbers are accepted, like the original format
+inline bool parseMapNumber(std::string_view inToken, int& outValue)
+{
+	if (inToken.empty() || inToken[0] < '0' || inToken[0] > '9')
+	{
+		return false;
+	}
+
+	const char* last = inToken.data() + inToken.size();
+	std::from_chars_result result = std::from_chars(inToken.data(), last, outValue);
+	return result.ec == std::errc() && result.ptr == last;
+}
+
+inline std::string_view trimMapLine(std::string_view inLine)
+{
+	std::size_t start = inLine.find_first_not_of(" \t\r");
+	if (start == std::string_view::npos)
+	{
+		return std::string_view();
+	}
+
+	std::size_t end = inLine.find_last_not_of(" \t\r");
+	return inLine.substr(start, end - start + 1);
+}
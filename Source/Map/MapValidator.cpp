@@ -0,0 +1,456 @@
+#include "MapValidator.h"
+#include "map.h"
+#include "Common/BitSet.h"
+#include "Common/ThreadPool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+	// the report prints at most this many one-way borders and groups
+	constexpr int32 PrintLimit = 20;
+}
+
+bool MapValidationReport::isConnected() const
+{
+	return componentCount == 1;
+}
+
+bool MapValidationReport::isStronglyConnected() const
+{
+	return strongComponentCount == 1;
+}
+
+bool MapValidationReport::hasValidContinents() const
+{
+	return disconnectedContinents.empty() && emptyContinents.empty();
+}
+
+bool MapValidationReport::hasUniqueMemberships() const
+{
+	return duplicateMemberships.empty() && orphanTerritories.empty();
+}
+
+void MapValidationReport::print(std::ostream& out, const Map& inMap) const
+{
+	// a map without territory has no group to tell about, Map::validate already said it has none
+	const bool bHasTerritories = !inMap.listTerritory.empty();
+	if (bHasTerritories && !isConnected())
+	{
+		out << "The territories form " << componentCount << " separate groups, "
+			<< unreachableTerritories.size() << " are cut off from " << inMap.listTerritory[0]->getNameView() << std::endl;
+	}
+	else if (bHasTerritories && !isStronglyConnected())
+	{
+		// the group of every territory is known, print the first territory met in each one
+		out << "The borders form " << strongComponentCount << " groups that cannot all reach each other" << std::endl;
+		std::vector<int32> groupSizes(strongComponentCount, 0);
+		std::vector<int32> groupFirst(strongComponentCount, -1);
+		for (int32 i = 0; i < static_cast<int32>(strongComponents.size()); i++)
+		{
+			const int32 group = strongComponents[i];
+			if (groupFirst[group] == -1)
+			{
+				groupFirst[group] = i;
+			}
+			groupSizes[group]++;
+		}
+		for (int32 group = 0; group < std::min(strongComponentCount, PrintLimit); group++)
+		{
+			out << "  group of " << groupSizes[group] << " territories with " << inMap.listTerritory[groupFirst[group]]->getNameView() << std::endl;
+		}
+	}
+	for (int32 i = 0; i < std::min(static_cast<int32>(oneWayBorders.size()), PrintLimit); i++)
+	{
+		out << "Border from " << inMap.listTerritory[oneWayBorders[i].from]->getNameView() << " to "
+			<< inMap.listTerritory[oneWayBorders[i].to]->getNameView() << " only goes one way" << std::endl;
+	}
+	if (static_cast<int32>(oneWayBorders.size()) > PrintLimit)
+	{
+		out << "and " << oneWayBorders.size() - PrintLimit << " more one-way borders" << std::endl;
+	}
+	for (int32 continent : emptyContinents)
+	{
+		out << "Continent " << inMap.listContinents[continent]->getNameView() << " has no territory" << std::endl;
+	}
+	for (int32 continent : disconnectedContinents)
+	{
+		out << "Continent " << inMap.listContinents[continent]->getNameView() << " is not a connected sub-graph" << std::endl;
+	}
+	for (int32 territory : duplicateMemberships)
+	{
+		out << "Territory " << inMap.listTerritory[territory]->getNameView() << " belongs to more than one continent" << std::endl;
+	}
+	for (int32 territory : orphanTerritories)
+	{
+		out << "Territory " << inMap.listTerritory[territory]->getNameView() << " refers to a continent that does not exist" << std::endl;
+	}
+}
+
+MapValidator::MapValidator()
+{
+}
+
+void MapValidator::setThreadPool(ThreadPool* inPool)
+{
+	_threadPool = inPool;
+}
+
+MapValidationReport MapValidator::validate(const Map& inMap)
+{
+	// a map without territories or without its graph cannot be played on
+	if (inMap.listTerritory.empty() || !inMap.hasGraph())
+	{
+		MapValidationReport report;
+		report.territoryCount = static_cast<int32>(inMap.listTerritory.size());
+		report.continentCount = static_cast<int32>(inMap.listContinents.size());
+		return report;
+	}
+
+	MapValidationReport report = validate(inMap.getGraph());
+	// the continent lists only exist on maps made of Territory objects
+	if (report.orphanTerritories.empty())
+	{
+		checkMemberships(inMap, report);
+	}
+
+	report.bIsValid = report.isConnected() && report.isStronglyConnected() && report.hasValidContinents() && report.hasUniqueMemberships();
+	return report;
+}
+
+MapValidationReport MapValidator::validate(const MapGraph& inGraph)
+{
+	MapValidationReport report;
+	report.territoryCount = inGraph.getTerritoryCount();
+	report.continentCount = inGraph.getContinentCount();
+
+	if (report.territoryCount == 0)
+	{
+		return report;
+	}
+
+	for (int32 i = 0; i < inGraph.getTerritoryCount(); i++)
+	{
+		if (inGraph.getContinent(i) < 0 || inGraph.getContinent(i) >= inGraph.getContinentCount())
+		{
+			report.orphanTerritories.push_back(i);
+		}
+	}
+
+	checkConnectivity(inGraph, report);
+	checkStrongComponents(inGraph, report);
+	findOneWayBorders(inGraph, report.oneWayBorders);
+	// the continent pass indexes by continent so it needs every territory to have one
+	if (report.orphanTerritories.empty())
+	{
+		checkContinents(inGraph, report);
+	}
+
+	report.bIsValid = report.isConnected() && report.isStronglyConnected() && report.hasValidContinents() && report.hasUniqueMemberships();
+	return report;
+}
+
+void MapValidator::checkConnectivity(const MapGraph& inGraph, MapValidationReport& outReport)
+{
+	const int32 territoryCount = inGraph.getTerritoryCount();
+
+	BitSet visited(territoryCount);
+	_queue.resize(territoryCount);
+
+	// every territory that is still unvisited starts a new group, the borders are followed both ways
+	// so the groups do not depend on which territory starts them
+	for (int32 seed = 0; seed < territoryCount; seed++)
+	{
+		if (visited.test(seed))
+		{
+			continue;
+		}
+
+		outReport.componentCount++;
+		int32 head = 0;
+		int32 tail = 0;
+		_queue[tail++] = seed;
+		visited.set(seed);
+
+		while (head < tail)
+		{
+			const int32 current = _queue[head++];
+			for (int32 neighbour : inGraph.getNeighbours(current))
+			{
+				if (!visited.test(neighbour))
+				{
+					visited.set(neighbour);
+					_queue[tail++] = neighbour;
+				}
+			}
+			for (int32 neighbour : inGraph.getIncoming(current))
+			{
+				if (!visited.test(neighbour))
+				{
+					visited.set(neighbour);
+					_queue[tail++] = neighbour;
+				}
+			}
+		}
+
+		if (seed > 0)
+		{
+			outReport.unreachableTerritories.insert(outReport.unreachableTerritories.end(), _queue.begin(), _queue.begin() + tail);
+		}
+	}
+}
+
+void MapValidator::checkStrongComponents(const MapGraph& inGraph, MapValidationReport& outReport)
+{
+	const int32 territoryCount = inGraph.getTerritoryCount();
+	const std::vector<int32>& offsets = inGraph.getOffsets();
+	const std::vector<int32>& neighbours = inGraph.getNeighbourIndexes();
+
+	// Tarjan: discovery order of every territory and the earliest order reachable from it
+	// through territories whose group is still open, -1 until the territory is reached
+	std::vector<int32> order(territoryCount, -1);
+	std::vector<int32> lowest(territoryCount, 0);
+	BitSet open(territoryCount);
+	std::vector<int32> openTerritories;
+	// explicit call stack, a territory with the position of the next border to follow
+	std::vector<std::pair<int32, int32>> calls;
+
+	outReport.strongComponents.assign(territoryCount, -1);
+	outReport.strongComponentCount = 0;
+	int32 nextOrder = 0;
+
+	auto discover = [&](int32 inTerritory)
+	{
+		order[inTerritory] = nextOrder;
+		lowest[inTerritory] = nextOrder;
+		nextOrder++;
+		open.set(inTerritory);
+		openTerritories.push_back(inTerritory);
+		calls.emplace_back(inTerritory, offsets[inTerritory]);
+	};
+
+	for (int32 root = 0; root < territoryCount; root++)
+	{
+		if (order[root] != -1)
+		{
+			continue;
+		}
+
+		discover(root);
+		while (!calls.empty())
+		{
+			const int32 current = calls.back().first;
+			const int32 position = calls.back().second;
+
+			if (position < offsets[current + 1])
+			{
+				calls.back().second++;
+				const int32 next = neighbours[position];
+				if (order[next] == -1)
+				{
+					discover(next);
+				}
+				else if (open.test(next))
+				{
+					lowest[current] = std::min(lowest[current], order[next]);
+				}
+				continue;
+			}
+
+			// every border followed, nothing above current reaches further back so its group is complete
+			if (lowest[current] == order[current])
+			{
+				int32 member = -1;
+				do
+				{
+					member = openTerritories.back();
+					openTerritories.pop_back();
+					open.reset(member);
+					outReport.strongComponents[member] = outReport.strongComponentCount;
+				} while (member != current);
+				outReport.strongComponentCount++;
+			}
+
+			calls.pop_back();
+			if (!calls.empty())
+			{
+				const int32 caller = calls.back().first;
+				lowest[caller] = std::min(lowest[caller], lowest[current]);
+			}
+		}
+	}
+}
+
+void MapValidator::findOneWayBorders(const MapGraph& inGraph, std::vector<MapBorder>& outBorders)
+{
+	const int32 territoryCount = inGraph.getTerritoryCount();
+	const std::vector<int32>& offsets = inGraph.getOffsets();
+	const std::vector<int32>& neighbours = inGraph.getNeighbourIndexes();
+
+	// reversed borders in CSR form, filled by source so every row comes out sorted
+	std::vector<int32> incomingOffsets(territoryCount + 1, 0);
+	for (int32 neighbour : neighbours)
+	{
+		incomingOffsets[neighbour + 1]++;
+	}
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		incomingOffsets[i + 1] += incomingOffsets[i];
+	}
+	std::vector<int32> incoming(neighbours.size());
+	std::vector<int32> fill(incomingOffsets.begin(), incomingOffsets.end() - 1);
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		for (int32 position = offsets[i]; position < offsets[i + 1]; position++)
+		{
+			incoming[fill[neighbours[position]]++] = i;
+		}
+	}
+
+	// marks the neighbours of i with i, a territory listing i without a mark has no way back
+	const std::size_t firstFound = outBorders.size();
+	std::vector<int32> mark(territoryCount, -1);
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		for (int32 position = offsets[i]; position < offsets[i + 1]; position++)
+		{
+			mark[neighbours[position]] = i;
+		}
+		for (int32 position = incomingOffsets[i]; position < incomingOffsets[i + 1]; position++)
+		{
+			const int32 source = incoming[position];
+			// a border listed twice is reported once
+			if (mark[source] != i && (position == incomingOffsets[i] || incoming[position - 1] != source))
+			{
+				MapBorder border;
+				border.from = source;
+				border.to = i;
+				outBorders.push_back(border);
+			}
+		}
+	}
+
+	std::sort(outBorders.begin() + firstFound, outBorders.end(), [](const MapBorder& inLHS, const MapBorder& inRHS)
+	{
+		return inLHS.from != inRHS.from ? inLHS.from < inRHS.from : inLHS.to < inRHS.to;
+	});
+}
+
+void MapValidator::checkContinents(const MapGraph& inGraph, MapValidationReport& outReport)
+{
+	const int32 territoryCount = inGraph.getTerritoryCount();
+	const int32 continentCount = inGraph.getContinentCount();
+
+	// counting sort of the territories by continent
+	_continentOffsets.assign(continentCount + 1, 0);
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		_continentOffsets[inGraph.getContinent(i) + 1]++;
+	}
+	for (int32 c = 0; c < continentCount; c++)
+	{
+		_continentOffsets[c + 1] += _continentOffsets[c];
+	}
+
+	_continentMembers.resize(territoryCount);
+	_localIndex.resize(territoryCount);
+	std::vector<int32> fill(_continentOffsets.begin(), _continentOffsets.end() - 1);
+	for (int32 i = 0; i < territoryCount; i++)
+	{
+		const int32 continent = inGraph.getContinent(i);
+		_localIndex[i] = fill[continent] - _continentOffsets[continent];
+		_continentMembers[fill[continent]++] = i;
+	}
+
+	// every continent writes its own slot so the merge below does not depend on scheduling
+	std::vector<char> bIsConnected(continentCount, 1);
+	auto checkRange = [&](int32 inBegin, int32 inEnd)
+	{
+		std::vector<int32> queue;
+		for (int32 c = inBegin; c < inEnd; c++)
+		{
+			if (_continentOffsets[c] != _continentOffsets[c + 1])
+			{
+				bIsConnected[c] = isContinentConnected(inGraph, c, queue) ? 1 : 0;
+			}
+		}
+	};
+
+	if (_threadPool != nullptr && continentCount > 1)
+	{
+		// several chunks per worker keep the threads busy when continent sizes vary
+		const int32 chunkSize = continentCount / (_threadPool->getThreadCount() * 8) + 1;
+		_threadPool->parallelFor(continentCount, chunkSize, checkRange);
+	}
+	else
+	{
+		checkRange(0, continentCount);
+	}
+
+	for (int32 c = 0; c < continentCount; c++)
+	{
+		if (_continentOffsets[c] == _continentOffsets[c + 1])
+		{
+			outReport.emptyContinents.push_back(c);
+		}
+		else if (!bIsConnected[c])
+		{
+			outReport.disconnectedContinents.push_back(c);
+		}
+	}
+}
+
+bool MapValidator::isContinentConnected(const MapGraph& inGraph, int32 inContinent, std::vector<int32>& outQueue) const
+{
+	const int32 first = _continentOffsets[inContinent];
+	const int32 memberCount = _continentOffsets[inContinent + 1] - first;
+
+	// visits are indexed by position inside the continent so each check only touches its own members
+	BitSet visited(memberCount);
+	outQueue.resize(memberCount);
+
+	int32 head = 0;
+	int32 tail = 0;
+	outQueue[tail++] = _continentMembers[first];
+	visited.set(0);
+
+	while (head < tail)
+	{
+		const int32 current = outQueue[head++];
+		for (int32 neighbour : inGraph.getNeighbours(current))
+		{
+			if (inGraph.getContinent(neighbour) != inContinent || visited.test(_localIndex[neighbour]))
+			{
+				continue;
+			}
+			visited.set(_localIndex[neighbour]);
+			outQueue[tail++] = neighbour;
+		}
+	}
+
+	return tail == memberCount;
+}
+
+void MapValidator::checkMemberships(const Map& inMap, MapValidationReport& outReport)
+{
+	const MapGraph& graph = inMap.getGraph();
+	BitSet listed(graph.getTerritoryCount());
+	BitSet reported(graph.getTerritoryCount());
+
+	for (int32 c = 0; c < static_cast<int32>(inMap.listContinents.size()); c++)
+	{
+		for (Territory* member : *inMap.listContinents[c]->getCountryList())
+		{
+			const int32 index = member->getIndex();
+			const bool bIsDuplicate = listed.test(index) || graph.getContinent(index) != c;
+			listed.set(index);
+
+			if (bIsDuplicate && !reported.test(index))
+			{
+				reported.set(index);
+				outReport.duplicateMemberships.push_back(index);
+			}
+		}
+	}
+}
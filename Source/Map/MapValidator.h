@@ -0,0 +1,104 @@
+#pragma once
+#include <iostream>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+class Map;
+class MapGraph;
+class ThreadPool;
+
+// how the continent checks of a validation are run
+enum class EMapValidationMode
+{
+	Serial,
+	Parallel
+};
+
+// border listed by inFrom, the dense indexes of both territories
+struct MapBorder
+{
+	int32 from = 0;
+	int32 to = 0;
+};
+
+// outcome of a map validation, every territory and continent is referred to by its dense index
+struct MapValidationReport
+{
+	bool bIsValid = false;
+
+	int32 territoryCount = 0;
+	int32 continentCount = 0;
+
+	// number of groups the territories fall into when following the borders either way, 1 for a connected map.
+	// Unlike the strong groups below it does not depend on the direction of the borders.
+	int32 componentCount = 0;
+	// territories outside the group of the first territory, no border links them to it in any direction
+	std::vector<int32> unreachableTerritories;
+	// groups of territories that can all reach each other following the borders in their direction,
+	// strongComponents holds the group of every territory. A single group means no territory is a trap.
+	int32 strongComponentCount = 0;
+	std::vector<int32> strongComponents;
+	// borders whose destination does not list the way back
+	std::vector<MapBorder> oneWayBorders;
+	// continents whose territories do not form a connected subgraph
+	std::vector<int32> disconnectedContinents;
+	// continents without any territory
+	std::vector<int32> emptyContinents;
+	// territories listed more than once or by a continent they do not belong to
+	std::vector<int32> duplicateMemberships;
+	// territories referring to a continent that does not exist
+	std::vector<int32> orphanTerritories;
+
+	bool isConnected() const;
+	bool isStronglyConnected() const;
+	bool hasValidContinents() const;
+	bool hasUniqueMemberships() const;
+
+	void print(std::ostream& out, const Map& inMap) const;
+};
+
+/*
+	Summary: Checks that a map is a connected graph, that every continent is a
+	connected subgraph and that every territory belongs to a single continent.
+	All passes are iterative breadth first searches over the CSR graph of the map,
+	visits are tracked in bitsets so the whole check is linear in the map size.
+	Borders are directed, an iterative Tarjan pass also requires every territory to
+	be reachable from every other one and the borders without a way back are listed.
+	With a thread pool the continents are checked concurrently, each one writes
+	its own result slot and the report is assembled in continent order.
+*/
+class MapValidator {
+public:
+	MapValidator();
+
+	MapValidationReport validate(const Map& inMap);
+	// checks a bare graph, membership is implied by the continent stored for every territory
+	MapValidationReport validate(const MapGraph& inGraph);
+
+	// continents are checked on inPool when set, nullptr checks them on the calling thread
+	void setThreadPool(ThreadPool* inPool);
+
+	// appends the borders of inGraph whose destination does not border back, sorted by source, in O(territories + borders)
+	static void findOneWayBorders(const MapGraph& inGraph, std::vector<MapBorder>& outBorders);
+
+private:
+	void checkConnectivity(const MapGraph& inGraph, MapValidationReport& outReport);
+	void checkStrongComponents(const MapGraph& inGraph, MapValidationReport& outReport);
+	void checkContinents(const MapGraph& inGraph, MapValidationReport& outReport);
+	void checkMemberships(const Map& inMap, MapValidationReport& outReport);
+
+	// true if the territories of inContinent are all reachable from each other inside the continent
+	bool isContinentConnected(const MapGraph& inGraph, int32 inContinent, std::vector<int32>& outQueue) const;
+
+	ThreadPool* _threadPool = nullptr;
+
+	// territories grouped by continent, the members of continent c are
+	// _continentMembers[_continentOffsets[c] .. _continentOffsets[c + 1])
+	std::vector<int32> _continentOffsets;
+	std::vector<int32> _continentMembers;
+	// position of every territory inside its continent group
+	std::vector<int32> _localIndex;
+
+	std::vector<int32> _queue;
+};
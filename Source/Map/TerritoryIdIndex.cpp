@@ -0,0 +1,110 @@
+#include "TerritoryIdIndex.h"
+
+namespace
+{
+	constexpr uint32 MinCapacity = 16;
+}
+
+TerritoryIdIndex::TerritoryIdIndex()
+{
+}
+
+void TerritoryIdIndex::clear()
+{
+	_slots.clear();
+	_shift = 32;
+	_size = 0;
+}
+
+void TerritoryIdIndex::reserve(int32 inCount)
+{
+	uint32 capacity = MinCapacity;
+	while (capacity < 2u * static_cast<uint32>(inCount > 0 ? inCount : 0))
+	{
+		capacity *= 2;
+	}
+	if (capacity > _slots.size())
+	{
+		rehash(capacity);
+	}
+}
+
+bool TerritoryIdIndex::insert(int32 inId, int32 inIndex)
+{
+	if (2u * static_cast<uint32>(_size + 1) > _slots.size())
+	{
+		rehash(_slots.empty() ? MinCapacity : static_cast<uint32>(_slots.size()) * 2);
+	}
+
+	const uint32 mask = static_cast<uint32>(_slots.size()) - 1;
+	for (uint32 slot = getHome(inId); ; slot = (slot + 1) & mask)
+	{
+		if (_slots[slot].index == NotFound)
+		{
+			_slots[slot].id = inId;
+			_slots[slot].index = inIndex;
+			_size++;
+			return true;
+		}
+		if (_slots[slot].id == inId)
+		{
+			return false;
+		}
+	}
+}
+
+int32 TerritoryIdIndex::find(int32 inId) const
+{
+	if (_slots.empty())
+	{
+		return NotFound;
+	}
+
+	// the table is never full, a free slot always ends the probe
+	const uint32 mask = static_cast<uint32>(_slots.size()) - 1;
+	for (uint32 slot = getHome(inId); ; slot = (slot + 1) & mask)
+	{
+		if (_slots[slot].index == NotFound || _slots[slot].id == inId)
+		{
+			return _slots[slot].index;
+		}
+	}
+}
+
+int32 TerritoryIdIndex::getSize() const
+{
+	return _size;
+}
+
+std::size_t TerritoryIdIndex::getMemoryUsage() const
+{
+	return _slots.capacity() * sizeof(Slot);
+}
+
+uint32 TerritoryIdIndex::getHome(int32 inId) const
+{
+	// Fibonacci hashing, consecutive ids land far apart and the top bits pick the slot
+	return (static_cast<uint32>(inId) * 2654435769u) >> _shift;
+}
+
+void TerritoryIdIndex::rehash(uint32 inCapacity)
+{
+	std::vector<Slot> oldSlots;
+	oldSlots.swap(_slots);
+	_slots.assign(inCapacity, Slot());
+
+	_shift = 32;
+	for (uint32 capacity = inCapacity; capacity > 1; capacity /= 2)
+	{
+		_shift--;
+	}
+
+	_size = 0;
+	for (const Slot& slot : oldSlots)
+	{
+		if (slot.index != NotFound)
+		{
+			insert(slot.id, slot.index);
+		}
+	}
+}
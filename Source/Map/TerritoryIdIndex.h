@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+/*
+	Summary: Hash from the territory ids written in a .map file to the dense indexes 0..N-1
+	the graph and the state arrays are addressed with. The ids of converted maps often have gaps
+	or do not start at 1, only the loaders and the commands typed by a player see them.
+	Open addressing with linear probing in a power of two table kept at most half full,
+	a lookup is a multiply and usually a single probe.
+*/
+class TerritoryIdIndex {
+public:
+	static constexpr int32 NotFound = -1;
+
+	TerritoryIdIndex();
+
+	void clear();
+	// sizes the table for inCount ids so that filling it never rehashes
+	void reserve(int32 inCount);
+	// false if inId is already indexed, the index it was given first is kept
+	bool insert(int32 inId, int32 inIndex);
+	// dense index of inId, NotFound if it is not indexed
+	int32 find(int32 inId) const;
+
+	int32 getSize() const;
+	std::size_t getMemoryUsage() const;
+
+private:
+	struct Slot
+	{
+		int32 id = 0;
+		// NotFound marks a free slot
+		int32 index = NotFound;
+	};
+
+	uint32 getHome(int32 inId) const;
+	void rehash(uint32 inCapacity);
+
+	std::vector<Slot> _slots;
+	uint32 _shift = 32;
+	int32 _size = 0;
+};
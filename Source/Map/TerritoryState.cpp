@@ -0,0 +1,262 @@
+#include "TerritoryState.h"
+#include "MapGraph.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+TerritoryState::TerritoryState()
+{
+}
+
+void TerritoryState::resize(int32 inTerritoryCount)
+{
+	_owners.assign(inTerritoryCount, NoOwner);
+	_armies.assign(inTerritoryCount, 0);
+	_values.assign(inTerritoryCount, 0);
+	_continents.assign(inTerritoryCount, -1);
+	_continentCount = 0;
+	_continentSizes.clear();
+	_ownedPerContinent.clear();
+	_frontier.reset(nullptr, _owners, 0);
+}
+
+void TerritoryState::assignContinents(std::vector<int32> inContinents, int32 inContinentCount)
+{
+	_continents = std::move(inContinents);
+	_continents.resize(_owners.size(), -1);
+	_continentCount = inContinentCount;
+	_continentSizes.assign(inContinentCount, 0);
+	_ownedPerContinent.assign(_players.size() * inContinentCount, 0);
+
+	for (std::size_t i = 0; i < _continents.size(); i++)
+	{
+		const int32 continent = _continents[i];
+		if (continent < 0 || continent >= _continentCount)
+		{
+			_continents[i] = -1;
+			continue;
+		}
+
+		_continentSizes[continent]++;
+		if (_owners[i] != NoOwner)
+		{
+			_ownedPerContinent[_owners[i] * _continentCount + continent]++;
+		}
+	}
+}
+
+int32 TerritoryState::getContinentCount() const
+{
+	return _continentCount;
+}
+
+int32 TerritoryState::getContinentSize(int32 inContinent) const
+{
+	return _continentSizes[inContinent];
+}
+
+int32 TerritoryState::getOwnedInContinent(int32 inPlayerIndex, int32 inContinent) const
+{
+	if (inPlayerIndex < 0 || inPlayerIndex >= static_cast<int32>(_players.size()))
+	{
+		return 0;
+	}
+	return _ownedPerContinent[inPlayerIndex * _continentCount + inContinent];
+}
+
+bool TerritoryState::ownsContinent(int32 inPlayerIndex, int32 inContinent) const
+{
+	return _continentSizes[inContinent] > 0 && getOwnedInContinent(inPlayerIndex, inContinent) == _continentSizes[inContinent];
+}
+
+void TerritoryState::attachGraph(std::shared_ptr<const MapGraph> inGraph)
+{
+	if (inGraph != nullptr && inGraph->getTerritoryCount() != getTerritoryCount())
+	{
+		inGraph = nullptr;
+	}
+	_frontier.reset(std::move(inGraph), _owners, getPlayerCount());
+}
+
+const FrontierIndex& TerritoryState::getFrontierIndex() const
+{
+	return _frontier;
+}
+
+void TerritoryState::saveSnapshot(TerritoryStateSnapshot& outSnapshot) const
+{
+	outSnapshot.owners.assign(_owners.begin(), _owners.end());
+	outSnapshot.armies.assign(_armies.begin(), _armies.end());
+	outSnapshot.values.assign(_values.begin(), _values.end());
+	outSnapshot.players.assign(_players.begin(), _players.end());
+	_frontier.saveOrder(outSnapshot.frontierOrder);
+}
+
+bool TerritoryState::restoreSnapshot(const TerritoryStateSnapshot& inSnapshot)
+{
+	const std::size_t territoryCount = _owners.size();
+	if (inSnapshot.owners.size() != territoryCount || inSnapshot.armies.size() != territoryCount || inSnapshot.values.size() != territoryCount)
+	{
+		return false;
+	}
+
+	if (territoryCount > 0)
+	{
+		std::memcpy(_owners.data(), inSnapshot.owners.data(), territoryCount * sizeof(int32));
+		std::memcpy(_armies.data(), inSnapshot.armies.data(), territoryCount * sizeof(int32));
+		std::memcpy(_values.data(), inSnapshot.values.data(), territoryCount * sizeof(int32));
+	}
+	_players.assign(inSnapshot.players.begin(), inSnapshot.players.end());
+
+	// the counters are recounted instead of saved, they follow from the owners
+	std::fill(_ownedPerContinent.begin(), _ownedPerContinent.end(), 0);
+	_ownedPerContinent.resize(_players.size() * _continentCount, 0);
+	for (std::size_t i = 0; i < territoryCount; i++)
+	{
+		if (_owners[i] != NoOwner && _continents[i] >= 0)
+		{
+			_ownedPerContinent[_owners[i] * _continentCount + _continents[i]]++;
+		}
+	}
+
+	_frontier.recount(_owners, getPlayerCount());
+	// the strategies walk the sets in order, a game goes on the same only with the order it had
+	if (!inSnapshot.frontierOrder.empty() && !_frontier.restoreOrder(inSnapshot.frontierOrder))
+	{
+		_frontier.recount(_owners, getPlayerCount());
+		return false;
+	}
+	return true;
+}
+
+int32 TerritoryState::getTerritoryCount() const
+{
+	return static_cast<int32>(_owners.size());
+}
+
+int32 TerritoryState::getOwner(int32 inIndex) const
+{
+	return _owners[inIndex];
+}
+
+void TerritoryState::setOwner(int32 inIndex, int32 inPlayerIndex)
+{
+	const int32 previousOwner = _owners[inIndex];
+	if (previousOwner == inPlayerIndex)
+	{
+		return;
+	}
+	_owners[inIndex] = inPlayerIndex;
+
+	// every change of hands goes through here, the counters and the frontier follow it
+	const int32 continent = _continents[inIndex];
+	if (continent >= 0 && previousOwner != NoOwner)
+	{
+		_ownedPerContinent[previousOwner * _continentCount + continent]--;
+	}
+	if (continent >= 0 && inPlayerIndex != NoOwner)
+	{
+		_ownedPerContinent[inPlayerIndex * _continentCount + continent]++;
+	}
+	_frontier.onOwnerChanged(inIndex, previousOwner, _owners);
+	if (_ownerJournal != nullptr)
+	{
+		_ownerJournal->push_back(inIndex);
+	}
+}
+
+void TerritoryState::setOwnerJournal(std::vector<int32>* outJournal)
+{
+	_ownerJournal = outJournal;
+}
+
+Player* TerritoryState::getOwnerPlayer(int32 inIndex) const
+{
+	return getPlayerByIndex(_owners[inIndex]);
+}
+
+void TerritoryState::setOwnerPlayer(int32 inIndex, Player* inPlayer)
+{
+	setOwner(inIndex, getPlayerIndex(inPlayer));
+}
+
+int32 TerritoryState::getArmies(int32 inIndex) const
+{
+	return _armies[inIndex];
+}
+
+void TerritoryState::setArmies(int32 inIndex, int32 inArmies)
+{
+	_armies[inIndex] = inArmies;
+}
+
+int32 TerritoryState::getValue(int32 inIndex) const
+{
+	return _values[inIndex];
+}
+
+void TerritoryState::setValue(int32 inIndex, int32 inValue)
+{
+	_values[inIndex] = inValue;
+}
+
+int32 TerritoryState::getPlayerIndex(Player* inPlayer)
+{
+	if (inPlayer == nullptr)
+	{
+		return NoOwner;
+	}
+
+	int32 playerIndex = findPlayerIndex(inPlayer);
+	if (playerIndex == NoOwner)
+	{
+		playerIndex = static_cast<int32>(_players.size());
+		_players.push_back(inPlayer);
+		_ownedPerContinent.resize(_players.size() * _continentCount, 0);
+		_frontier.addPlayer();
+	}
+	return playerIndex;
+}
+
+int32 TerritoryState::findPlayerIndex(const Player* inPlayer) const
+{
+	// a game only has a handful of players
+	for (std::size_t i = 0; i < _players.size(); i++)
+	{
+		if (_players[i] == inPlayer)
+		{
+			return static_cast<int32>(i);
+		}
+	}
+	return NoOwner;
+}
+
+Player* TerritoryState::getPlayerByIndex(int32 inPlayerIndex) const
+{
+	if (inPlayerIndex < 0 || inPlayerIndex >= static_cast<int32>(_players.size()))
+	{
+		return nullptr;
+	}
+	return _players[inPlayerIndex];
+}
+
+int32 TerritoryState::getPlayerCount() const
+{
+	return static_cast<int32>(_players.size());
+}
+
+const std::vector<int32>& TerritoryState::getOwners() const
+{
+	return _owners;
+}
+
+const std::vector<int32>& TerritoryState::getArmies() const
+{
+	return _armies;
+}
+
+const std::vector<int32>& TerritoryState::getValues() const
+{
+	return _values;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "FrontierIndex.h"
+
+class MapGraph;
+class Player;
+
+// copy of the mutable arrays of a TerritoryState, the topology it describes is not part of it
+struct TerritoryStateSnapshot
+{
+	std::vector<int32> owners;
+	std::vector<int32> armies;
+	std::vector<int32> values;
+	std::vector<Player*> players;
+	// sets of the frontier index in the order they were in, empty to rebuild them in index order
+	std::vector<int32> frontierOrder;
+};
+
+/*
+	Summary: Mutable per-game territory state stored as parallel arrays.
+	Owner, army count and value of the territory with dense index i live at
+	position i of their own array, so loops over the whole map read them linearly.
+	Owners are kept as dense player indexes into a small player registry.
+	Every owner change also updates a player x continent counter of owned territories,
+	so continent control is known without walking the territories.
+	Once the graph is attached the frontier index follows the owner changes as well.
+*/
+class TerritoryState {
+public:
+	static constexpr int32 NoOwner = -1;
+
+	TerritoryState();
+
+	// resets every territory to unowned, no armies and no value
+	void resize(int32 inTerritoryCount);
+	int32 getTerritoryCount() const;
+
+	// 0-based continent of every territory, set before the first owner so the counters start from zero.
+	// Territories outside [0, inContinentCount) are not counted.
+	void assignContinents(std::vector<int32> inContinents, int32 inContinentCount);
+	int32 getContinentCount() const;
+	int32 getContinentSize(int32 inContinent) const;
+	// territories of inContinent owned by the player with index inPlayerIndex
+	int32 getOwnedInContinent(int32 inPlayerIndex, int32 inContinent) const;
+	// true if the player owns every territory of a continent that has some
+	bool ownsContinent(int32 inPlayerIndex, int32 inContinent) const;
+
+	// builds the frontier index from the current owners, inGraph must describe the same territories
+	void attachGraph(std::shared_ptr<const MapGraph> inGraph);
+	// frontier, interior and adjacent enemies of every player, empty until a graph is attached
+	const FrontierIndex& getFrontierIndex() const;
+
+	// copies owners, armies, values and the player registry, outSnapshot keeps its storage when it is reused
+	void saveSnapshot(TerritoryStateSnapshot& outSnapshot) const;
+	// puts back a snapshot of a state with as many territories, false leaves the state untouched.
+	// The arrays are copied in place and the counters and frontier recounted in O(territories + borders),
+	// nothing is allocated once the state has held as many players before. A frontier order that does not
+	// fit the owners is dropped, the sets stay in index order and false is returned with the rest restored.
+	bool restoreSnapshot(const TerritoryStateSnapshot& inSnapshot);
+
+	int32 getOwner(int32 inIndex) const;
+	void setOwner(int32 inIndex, int32 inPlayerIndex);
+	// while set, the index of every territory changing hands is appended to outJournal, nullptr stops it
+	void setOwnerJournal(std::vector<int32>* outJournal);
+	Player* getOwnerPlayer(int32 inIndex) const;
+	void setOwnerPlayer(int32 inIndex, Player* inPlayer);
+
+	int32 getArmies(int32 inIndex) const;
+	void setArmies(int32 inIndex, int32 inArmies);
+
+	int32 getValue(int32 inIndex) const;
+	void setValue(int32 inIndex, int32 inValue);
+
+	// dense index of inPlayer, the player is registered on first use
+	int32 getPlayerIndex(Player* inPlayer);
+	// dense index of inPlayer or NoOwner if it never owned a territory
+	int32 findPlayerIndex(const Player* inPlayer) const;
+	Player* getPlayerByIndex(int32 inPlayerIndex) const;
+	int32 getPlayerCount() const;
+
+	const std::vector<int32>& getOwners() const;
+	const std::vector<int32>& getArmies() const;
+	const std::vector<int32>& getValues() const;
+
+private:
+	std::vector<int32> _owners;
+	std::vector<int32> _armies;
+	std::vector<int32> _values;
+
+	std::vector<Player*> _players;
+
+	int32 _continentCount = 0;
+	std::vector<int32> _continents;
+	std::vector<int32> _continentSizes;
+	// owned territories of player p in continent c at p * _continentCount + c
+	std::vector<int32> _ownedPerContinent;
+
+	FrontierIndex _frontier;
+	std::vector<int32>* _ownerJournal = nullptr;
+};
@@ -1,8 +1,15 @@
 #pragma once
 #include <iostream>
 #include "map.h"
-#include <fstream>
+#include "MapParser.h"
+#include "MapBinary.h"
+#include "MapCache.h"
+#include "Common/Hash.h"
+#include "Common/ThreadPool.h"
+#include <algorithm>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Player/Player.h"
@@ -10,60 +17,10 @@
 using namespace std;
 
 
-vector<string> removeDupWord(string str) 
-{
-    string word = "";
-    vector<string> splitstring;
-    for (auto x : str)
-    {
-        if (x == ' ')
-        {
-            //cout << word << endl;
-            splitstring.push_back(word);
-            word = "";
-        }
-        else {
-            word = word + x;
-        }
-    }
-    splitstring.push_back(word);
-    return splitstring;
-}
-//https://www.geeksforgeeks.org/split-a-sentence-into-words-in-cpp/
-
-bool isNumber(const string& str)
-{
-    for (char const& c : str) {
-        if (std::isdigit(c) == 0) return false;
-    }
-    return true;
-}
-//https://www.delftstack.com/fr/howto/cpp/how-to-determine-if-a-string-is-number-cpp/
-
-//Run trought a vactor of bool and check if all of  them are ste to true;
-bool checkVectorForTrue(vector<bool>* vectorToCheck) {
-
-    for (auto x : *vectorToCheck) {
-        if (x == false) {
-            return false;
-        }
-    }
-    return true;
-}
-
-// Run trought a vector of string and check if all element of the vector have a value != ""
-bool checkVectorForString(vector<string>* vectorToCheck) {
-    for (auto x : *vectorToCheck) {
-        if (x == "") {
-            return false;
-        }
-    }
-    return true;
-}
-
 //Defaut constructor may be usefull later
 MapLoader::MapLoader() {
     size = 0;
+    cache = &MapCache::getShared();
 }
 
 
@@ -71,35 +28,214 @@ MapLoader::MapLoader() {
 MapLoader::MapLoader(const MapLoader& ml) {
     this->listMap = ml.listMap;
     this->size = ml.size;
+    this->validationThreadCount = ml.validationThreadCount;
+    this->cache = ml.cache;
+    this->bSymmetrizeBorders = ml.bSymmetrizeBorders;
+    this->territoryOrdering = ml.territoryOrdering;
 }
 
 // Parameter constructer
 MapLoader::MapLoader(std::vector<Map*> pLisMap, int psize) {
     this->listMap = pLisMap;
     this->size = psize;
+    this->cache = &MapCache::getShared();
+}
+
+bool MapLoader::loadMap(std::string fileName, EMapValidationMode inMode) {
+    EMapLoadStatus status;
+    std::shared_ptr<const Map> prototype = loadPrototype(fileName, inMode, status, cout);
+    return addInstance(fileName, *prototype) != nullptr;
 }
 
-bool MapLoader::loadMap(std::string fileName) {
+/*
+// Load every file of inFileNames at once, one task per distinct file on the loader's thread pool.
+// The instances are added to the list and outResults is filled in the order of inFileNames,
+// so a map that fails does not shift the ones after it.
+*/
+bool MapLoader::loadMaps(const std::vector<std::string>& inFileNames, std::vector<MapLoadResult>& outResults) {
+    vector<string> files;                                       //A file asked for twice is loaded once
+    vector<int32> fileOfRequest(inFileNames.size());
+    std::unordered_map<string, int32> fileIndexes;
+    for (std::size_t i = 0; i < inFileNames.size(); i++) {
+        auto inserted = fileIndexes.emplace(inFileNames[i], static_cast<int32>(files.size()));
+        if (inserted.second) {
+            files.push_back(inFileNames[i]);
+        }
+        fileOfRequest[i] = inserted.first->second;
+    }
+
+    if (validationPool == nullptr) {
+        validationPool.reset(new ThreadPool(validationThreadCount));
+    }
+    vector<std::shared_ptr<const Map>> prototypes(files.size());
+    vector<EMapLoadStatus> statuses(files.size(), EMapLoadStatus::Missing);
+    vector<string> logs(files.size());
+    for (std::size_t f = 0; f < files.size(); f++) {
+        validationPool->submit([this, &files, &prototypes, &statuses, &logs, f]() {
+            //Serial validation, the workers of the pool are busy loading
+            std::ostringstream log;                             //Kept apart so the files do not narrate over each other
+            prototypes[f] = loadPrototype(files[f], EMapValidationMode::Serial, statuses[f], log);
+            logs[f] = log.str();
+        });
+    }
+    validationPool->wait();
+
+    bool bAllValid = true;
+    outResults.clear();
+    outResults.resize(inFileNames.size());
+    for (std::size_t i = 0; i < inFileNames.size(); i++) {
+        MapLoadResult& result = outResults[i];
+        result.fileName = inFileNames[i];
+        result.status = statuses[fileOfRequest[i]];
+        if (!logs[fileOfRequest[i]].empty()) {                  //Printed with the first request of the file
+            result.log.swap(logs[fileOfRequest[i]]);
+            cout << result.log;
+        }
+        result.map = addInstance(inFileNames[i], *prototypes[fileOfRequest[i]]);
+        bAllValid = bAllValid && result.map != nullptr;
+    }
+    return bAllValid;
+}
+
+const char* MapLoader::getLoadStatusName(EMapLoadStatus inStatus) {
+    switch (inStatus) {
+    case EMapLoadStatus::Valid: return "valid";
+    case EMapLoadStatus::Invalid: return "invalid";
+    case EMapLoadStatus::Missing:
+    default: return "missing";
+    }
+}
+
+/*
+// Parse and validate fileName, or take it from the cache. Nothing is added to the list of maps,
+// so several files can be loaded at the same time.
+*/
+std::shared_ptr<const Map> MapLoader::loadPrototype(const std::string& fileName, EMapValidationMode inMode, EMapLoadStatus& outStatus, std::ostream& out) {
 
-    Map* map = new Map();
     std::string file = "map/"+ fileName + ".map";               //Concatenation of the file name 
-    map->creatGraph(file);                                      //Creat the graph even if file is invalid
-    cout << "Checking " << fileName << ".map" << endl;
-    if (map->validate()) {                                      //add valid map to the list and destroy  invalide one       
+    std::string binaryFile = "map/" + fileName + ".wzmap";
+
+    //The content hash keys the cache and tells if a precompiled .wzmap is still up to date
+    std::string cacheKey = file;
+    uint64 contentHash = 0;
+    bool bHasSource = Hash::hashFile(file, contentHash);
+    if (!bHasSource && Hash::hashFile(binaryFile, contentHash)) {
+        cacheKey = binaryFile;
+    }
+    bool bIsCacheable = bHasSource || cacheKey == binaryFile;
+    if (bSymmetrizeBorders) {
+        cacheKey += "#symmetric";                               //The same file loaded as-is is another prototype
+    }
+    if (territoryOrdering != EMapOrdering::File) {
+        cacheKey += std::string("#") + MapReorder::getOrderingName(territoryOrdering);
+    }
+
+    out << "Checking " << fileName << ".map" << endl;
+    std::shared_ptr<const Map> prototype;
+    if (cache != nullptr) {
+        prototype = cache->find(cacheKey, contentHash);
+    }
+
+    if (prototype != nullptr) {
+        out << "Reusing the already validated " << fileName << endl;
+    }
+    else {
+        Map* loadedMap = new Map();
+        MapBinaryLoader binaryLoader;
+        if (binaryLoader.loadFile(binaryFile, *loadedMap, bHasSource ? contentHash : 0)) {
+            out << "Loaded the precompiled " << fileName << ".wzmap" << endl;
+        }
+        else {
+            delete loadedMap;
+            loadedMap = new Map();
+            loadedMap->creatGraph(file, out);                   //Creat the graph even if file is invalid
+        }
+
+        if (bSymmetrizeBorders) {
+            int32 addedBorders = loadedMap->symmetrizeBorders();
+            if (addedBorders > 0) {
+                out << "Added the way back to " << addedBorders << " one-way borders" << endl;
+            }
+        }
+        loadedMap->reorderTerritories(territoryOrdering);
+
+        ThreadPool* pool = nullptr;
+        if (inMode == EMapValidationMode::Parallel) {           //The pool is kept for the next maps of this loader
+            if (validationPool == nullptr) {
+                validationPool.reset(new ThreadPool(validationThreadCount));
+            }
+            pool = validationPool.get();
+        }
+
+        if (loadedMap->validate(pool, out)) {
+            loadedMap->buildDistanceIndex();                    //Built once, every game on this map shares it
+            loadedMap->buildSpatialIndex();
+            loadedMap->buildChokepointIndex();
+        }
+        prototype.reset(loadedMap);
+
+        //Invalid maps are remembered too, a file that cannot be read has nothing to key on
+        if (cache != nullptr && bIsCacheable) {
+            cache->insert(cacheKey, contentHash, prototype);
+        }
+    }
+
+    if (prototype->getValidity()) {
+        outStatus = EMapLoadStatus::Valid;
+    }
+    else {
+        outStatus = bIsCacheable ? EMapLoadStatus::Invalid : EMapLoadStatus::Missing;
+    }
+    return prototype;
+}
+
+Map* MapLoader::addInstance(const std::string& fileName, const Map& inPrototype) {
+    if (inPrototype.getValidity()) {                            //add valid map to the list, the game gets its own instance
         cout << "\n==>"<<fileName<<".map is a valid file\n\n";
-        this->getListMap()->push_back(map);
+        this->getListMap()->push_back(inPrototype.instantiate());
         size++;
+        return listMap.back();
     }
     else
     {
         cout << "\n==>" << fileName << ".map is an invalid file\n\n";
-        delete map;
-        return false;
+        return nullptr;
     }
+}
 
-    map = NULL;
-    delete map;
-    return true;
+void MapLoader::setCache(MapCache* inCache) {
+    cache = inCache;
+}
+
+MapCache* MapLoader::getCache() const {
+    return cache;
+}
+
+void MapLoader::setSymmetrizeBorders(bool bInSymmetrize) {
+    bSymmetrizeBorders = bInSymmetrize;
+}
+
+bool MapLoader::getSymmetrizeBorders() const {
+    return bSymmetrizeBorders;
+}
+
+void MapLoader::setTerritoryOrdering(EMapOrdering inOrdering) {
+    territoryOrdering = inOrdering;
+}
+
+EMapOrdering MapLoader::getTerritoryOrdering() const {
+    return territoryOrdering;
+}
+
+void MapLoader::setValidationThreadCount(int32 inThreadCount) {
+    if (inThreadCount != validationThreadCount) {
+        validationPool.reset();                                 //Rebuilt with the new size on the next parallel load
+    }
+    validationThreadCount = inThreadCount;
+}
+
+int32 MapLoader::getValidationThreadCount() const {
+    return validationThreadCount;
 }
 
 std::vector<Map*>* MapLoader::getListMap() {
@@ -115,13 +251,12 @@ int MapLoader::getSize() {
 Map::Map() {
 
     this->isValidFile = true;                   //Set the vlidity of the file to true.    
+    symbols = std::make_shared<SymbolTable>();
 }
 
-//Copy constructor for Map
+//Copy constructor for Map, the copy gets its own territories and continents and a copy of the state
 Map::Map(const Map&  m) {
-    listContinents = m.listContinents;
-    listTerritory = m.listTerritory;
-    isValidFile = m.isValidFile;                   //Set the vlidity of the file to true.    
+    copyFrom(m, true);
 }
 
  // Valu constructor  for Map 
@@ -129,358 +264,572 @@ Map::Map(vector<Territory*> territory, vector<Continent*> continent, bool valid)
     listTerritory = territory;
     listContinents = continent;
     isValidFile = valid;
+    symbols = std::make_shared<SymbolTable>();
+    if (isValidFile) {
+        buildGraph();
+    }
 }
 
-bool Map::getValidity() {
+bool Map::getValidity() const {
     return this->isValidFile;
 }
 
 
 /*
 // Function to check and creat all The territory and continent bases from the file passed as a parameter.
+// The file is memory mapped and tokenized in place by the MapParser.
 */
-bool Map::creatGraph(std::string fileName){
-    string valueLine;
-    ifstream inputFile(fileName);
-    inputFile >> valueLine;                     //Value line will have the value of a string that will be sure to identify the section, or contain some info
-    while (valueLine != ("[continents]")) {     //Loop until we get reache the continents section
-        inputFile >> valueLine;
-        if (inputFile.peek() == EOF) {          //Check if the loop reach End of file without findind the [continent] line.
-            this->isValidFile = false;
-            return false;
-           
-        }
+bool Map::creatGraph(std::string fileName, std::ostream& out){
+    MapParser parser;
+    bool result = parser.parseFile(fileName, *this);
+
+    if (!parser.getErrors().empty()) {
+        out << "The value in this file are not valid please folow the document structure" << endl;
+        parser.printErrors(out);
+    }
+
+    if (result) {
+        buildGraph();                                       //Flatten the borders once they are all linked
     }
+
+    return result;
+};
+
+
+void Map::addTerritoryToContinent(Territory* toAdd) {
     
-    std::getline(inputFile, valueLine);
-    //Loop to initialise all the country 
-    while (valueLine != ("[countries]"))                                       //Loop until you reach the country section.
-    {
-                                                                               //loop to creat a continents from extacting data frome the file 
-        Continent* continentsToCreate = new Continent();                       //Creat an empty continent to be filled later.
+    int targetContinent = toAdd->getContinent();
+    if (targetContinent > listContinents.size() || targetContinent < 1) {      //check if the continent of the territory is valid , if not , the map is invalid. 
+        this->isValidFile = false;
+    }
+    else {
+        listContinents.at(targetContinent - 1)->getCountryList()->push_back(toAdd);
+    }
+}
+
+/*
+// Add the missing way back of every one-way border, the graph is rebuilt when one is found.
+// Linear in the map size, the one-way borders are found with a reversed copy of the graph.
+*/
+int32 Map::symmetrizeBorders() {
+    if (graph == nullptr) {
+        return 0;
+    }
 
-        vector<string> splitString;
-        splitString = removeDupWord(valueLine);                                //split the string in word.
-                             
-        if (splitString.size() == 3) {                                         //Validate if  the string have exactly 3 element
+    vector<MapBorder> oneWayBorders;
+    MapValidator::findOneWayBorders(*graph, oneWayBorders);
+    if (oneWayBorders.empty()) {
+        return 0;
+    }
 
+    for (const MapBorder& border : oneWayBorders) {
+        listTerritory[border.to]->getBorderList().push_back(listTerritory[border.from]);
+    }
+    buildGraph();
+    return static_cast<int32>(oneWayBorders.size());
+}
 
-            if (isNumber(splitString.at(1))) {                                //check if the second element of the string is an int (for casting safety)
-                continentsToCreate->setArmyValue(stoi(splitString.at(1)));    //change all the valus for the element of the continent
-                continentsToCreate->setName(splitString.at(0));
-                continentsToCreate->setColour(splitString.at(2));
-                listContinents.push_back(continentsToCreate);
-            }
-            else {                                                              
-                this->isValidFile = false;
-            }
+/*
+// Put the territories in the order computed by MapReorder and rebuild the graph on the new indexes.
+// The border lists hold pointers so they stay valid, the ids read from the file are untouched.
+*/
+bool Map::reorderTerritories(EMapOrdering inOrdering) {
+    if (graph == nullptr) {
+        return false;
+    }
+    if (inOrdering == EMapOrdering::File) {
+        return true;
+    }
+
+    vector<int32> posx(listTerritory.size());
+    vector<int32> posy(listTerritory.size());
+    for (std::size_t i = 0; i < listTerritory.size(); i++) {
+        posx[i] = listTerritory[i]->getPosx();
+        posy[i] = listTerritory[i]->getPosy();
+    }
+
+    vector<int32> order;
+    MapReorder::computeOrder(*graph, posx, posy, inOrdering, order);
+    vector<Territory*> reordered(listTerritory.size());
+    for (std::size_t i = 0; i < order.size(); i++) {
+        reordered[i] = listTerritory[order[i]];
+    }
+    listTerritory.swap(reordered);
+
+    buildGraph();
+    return true;
+}
+
+/*
+// Funtion that check it the map is a valid graph , if every continent are valid subgraph, and if every territory are only member of a single continent.
+*/
+bool Map::validate(ThreadPool* inPool, std::ostream& out) {
+    if (!this->getValidity()) {
+        out << "This file is not valid at all,";
+        return false;
+    }
+
+    MapValidator validator;
+    validator.setThreadPool(inPool);
+    validationReport = validator.validate(*this);               //One iterative pass over the graph for every check
+
+    if (validationReport.territoryCount == 0) {
+        out << "This map does not have any territory." << endl;
+    }
+    else if (!validationReport.isConnected()) {
+        out << "This map is not a valid graph." << endl;
+    }
+    else if (!validationReport.isStronglyConnected()) {
+        out << "This map is not a valid graph, some territories cannot be reached back." << endl;
+    }
+    else {
+        out << "This map is a valid graph" << endl;
+        if (!validationReport.hasValidContinents()) {
+            out << "This Map does not have valid sub-graph." << endl;
         }
         else {
-            if (splitString.at(0) != "") {                                  //Handle empty string in the texte file.
-                this->isValidFile = false;
+            out << "This Map have valid Continent as sub-graph." << endl;
+            if (!validationReport.hasUniqueMemberships()) {
+                out << "This map does not have valid continent." << endl;
+            }
+            else {
+                out << "This Map have valid continent." << endl;
             }
         }
+    }
 
-        //check for End of file
-        if (inputFile.peek() == EOF) {                                      
-            this->isValidFile = false;
-            return false;
-            //exit;
-        }
-        getline(inputFile, valueLine);
+    if (!validationReport.bIsValid) {
+        validationReport.print(out, *this);
+        this->isValidFile = false;
+    }
+    return validationReport.bIsValid;
+}
 
+const MapValidationReport& Map::getValidationReport() const {
+    return validationReport;
+}
 
-    };
+/*
+* Retreives territory ids
+* This function will help facilitating the retrieval of
+* territory objects by searching a territory by its id.
+*/
+std::vector<int> Map::getTerritoryIds() {
+    vector<int> territoryIds;
+    for (Territory* t : this->listTerritory) {
+        territoryIds.push_back(t->getID());
+    }
+    return territoryIds;
+}
 
+/*
+// Assign every territory its dense index and flatten the border lists into the shared CSR graph.
+*/
+void Map::buildGraph() {
+    attachTerritories();
+    buildLookups();
+
+    std::shared_ptr<MapGraph> newGraph = std::make_shared<MapGraph>();
+    newGraph->build(listTerritory, static_cast<int32>(listContinents.size()));
+    graph = newGraph;
+    state.attachGraph(graph);
+    distanceIndex.reset();                                  //Distances of the old graph are meaningless now
+    spatialIndex.reset();                                   //So are the indexes held by the grid
+    chokepointIndex.reset();
+}
 
-    getline(inputFile, valueLine);
+/*
+// Creat a new map for a game from this already validated one. The graph is shared, the game only
+// gets its own territory and continent objects and a fresh state.
+*/
+Map* Map::instantiate() const {
+    Map* instance = new Map();
+    instance->copyFrom(*this, false);
+    return instance;
+}
 
-    /*
-    // Loop trought the text file and creat territory object with the info form the file.
-    */
-    while (valueLine != ("[borders]"))                                      //Loop until the border section is reached. 
-    {
-                                                                                
-        Territory* territoryToCreat = new Territory;                        //Creat the new territtory That will be filled up.
-
-        vector<string> splitString;
-        splitString = removeDupWord(valueLine);                             //split the string in word.
-
-        if (splitString.size() >= 5) {                                      //Check if the string have the good amount of element.
-            if (isNumber(splitString.at(0)) && isNumber(splitString.at(2)) && isNumber(splitString.at(3)) && isNumber(splitString.at(4))) {     //Check if the necesary number are int (for casting safety).
-                territoryToCreat->setId(stoi(splitString.at(0)));
-                territoryToCreat->setName(splitString.at(1));
-                territoryToCreat->setContinent(stoi(splitString.at(2)));
-                territoryToCreat->setPosx(stoi(splitString.at(3)));
-                territoryToCreat->setPosy(stoi(splitString.at(4)));
-                listTerritory.push_back(territoryToCreat);
-            }
-            else {
-                this->isValidFile = false;
-            }
+Map* Map::clone() const {
+    return new Map(*this);
+}
 
+/*
+// Give this empty map its own territories and continents built after inSource. The graph, the names
+// and the distances are shared, only the mutable state is copied when bInCopyState is set.
+*/
+void Map::copyFrom(const Map& inSource, bool bInCopyState) {
+    isValidFile = inSource.isValidFile;
+    validationReport = inSource.validationReport;
+    symbols = inSource.symbols;                             //Names are shared, no string is copied per game
+
+    listContinents.reserve(inSource.listContinents.size());
+    for (Continent* continent : inSource.listContinents) {
+        Continent* copy = new Continent(continent->getArmyValu(), string(), continent->getColour(), vector<Territory*>());
+        if (inSource.graph != nullptr) {
+            copy->setNameSymbol(continent->getNameSymbol());
         }
         else {
+            copy->setName(continent->getName());
+        }
+        listContinents.push_back(copy);
+    }
 
-            if (splitString.at(0) != "") {
-
-                this->isValidFile = false;
+    listTerritory.reserve(inSource.listTerritory.size());
+    for (Territory* territory : inSource.listTerritory) {
+        Territory* copy = new Territory();
+        copy->setId(territory->getID());
+        copy->setContinent(territory->getContinent());
+        copy->setPosx(territory->getPosx());
+        copy->setPosy(territory->getPosy());
+        if (inSource.graph != nullptr) {
+            copy->setNameSymbol(territory->getNameSymbol());
+        }
+        else {                                              //Never attached, the values are still in the territory
+            copy->setName(territory->getName());
+            if (bInCopyState) {
+                copy->setPlayer(territory->getPlayer());
+                copy->setNbArmy(territory->getNbArmy());
+                copy->setValue(territory->getValue());
             }
         }
+        listTerritory.push_back(copy);
+    }
 
-        if (inputFile.peek() == EOF) {
-            this->isValidFile = false;
-            return false;
+    if (inSource.graph != nullptr) {
+        for (int32 i = 0; i < static_cast<int32>(listTerritory.size()); i++) {
+            vector<Territory*>& borders = listTerritory[i]->getBorderList();
+            borders.reserve(inSource.graph->getDegree(i));
+            for (int32 neighbour : inSource.graph->getNeighbours(i)) {
+                borders.push_back(listTerritory[neighbour]);
+            }
         }
-        getline(inputFile, valueLine);     //get the next line in the text file.
-
-    };
-
-    if (this->isValidFile == true) {                    //check if the text file is valid , if it is, finalise the graph.
-        while (std::getline(inputFile, valueLine)) {
-            this->addBorderToTerritory(valueLine);      // call the function to  add the border the the good territory. Value got from the text file.
-          
+    }
+    else {
+        std::unordered_map<const Territory*, Territory*> copies;        //No dense index yet, borders are found by address
+        copies.reserve(listTerritory.size());
+        for (std::size_t i = 0; i < listTerritory.size(); i++) {
+            copies[inSource.listTerritory[i]] = listTerritory[i];
         }
+        for (std::size_t i = 0; i < listTerritory.size(); i++) {
+            for (Territory* border : inSource.listTerritory[i]->getBorderList()) {
+                auto found = copies.find(border);
+                if (found != copies.end()) {
+                    listTerritory[i]->getBorderList().push_back(found->second);
+                }
+            }
+        }
+    }
 
-        for (auto i : listTerritory) {                  // Add the nececary Territory to every continents
-            addTerritoryToContinent(i);
-
+    for (Territory* copy : listTerritory) {
+        if (copy->getContinent() >= 1 && copy->getContinent() <= static_cast<int>(listContinents.size())) {
+            addTerritoryToContinent(copy);
         }
+    }
 
+    if (inSource.graph != nullptr) {
+        attachTerritories();
+        lookups = inSource.lookups;                         //Same positions as the source, its lookups hold here too
+        graph = inSource.graph;
+        state.attachGraph(graph);
+        distanceIndex = inSource.distanceIndex;
+        spatialIndex = inSource.spatialIndex;
+        chokepointIndex = inSource.chokepointIndex;
+        if (bInCopyState) {
+            TerritoryStateSnapshot snapshot;
+            inSource.state.saveSnapshot(snapshot);
+            state.restoreSnapshot(snapshot);
+        }
     }
-    else {
-        cout << "The value in this file are not valid please folow the document structure" << endl;
+    isValidFile = inSource.isValidFile;                     //Adding the territories may not change it
+}
+
+void Map::setGraph(std::shared_ptr<const MapGraph> inGraph) {
+    attachTerritories();
+    buildLookups();
+    graph = inGraph;
+    state.attachGraph(graph);
+    distanceIndex.reset();
+    spatialIndex.reset();
+    chokepointIndex.reset();
+}
+
+void Map::buildDistanceIndex() {
+    if (graph == nullptr) {
+        return;
     }
 
-    return true;
-};
+    std::shared_ptr<MapDistanceIndex> newIndex = std::make_shared<MapDistanceIndex>();
+    newIndex->build(graph);
+    distanceIndex = newIndex;
+}
 
-/*
-    Recive a string of number representing the border. Add poiter to country object in the "listBorder" of a country object 
-*/
-void Map::addBorderToTerritory(string line) {
-    vector<string> splitString;
-    splitString = removeDupWord(line);      //split the string in word.
-    Territory* targetCountry = nullptr;
-    Territory* toAddCountry = nullptr;
-                    
-    int a = 0;                              //Us to identify target that will recive the folowing territory
-   
-    for (string i : splitString) {
-        if (i == "") {                      //check for an empty string after [border]
+bool Map::hasDistanceIndex() const {
+    return distanceIndex != nullptr;
+}
 
-        }
-        else if(isNumber(i)){
-            if (stoi(i) > listTerritory.size() || stoi(i)<0) {              //check if the number in the border transition point to a real Territory
-                this->isValidFile = false;
-            }
-            else if (a == 0) {                                              //check if its the first element of the vector. The first element indicate what territory will get the next border value.  
-                
-                    targetCountry = listTerritory.at(stoi(i) - 1);          //get a poiter to the contry that will get is border added
-            }
-            else {
+const MapDistanceIndex& Map::getDistanceIndex() const {
+    return *distanceIndex;
+}
 
-                toAddCountry = listTerritory.at(stoi(i) - 1);               //get a poiter to the coutry to add
-                targetCountry->getBorderList().push_back(toAddCountry);    //add the coutry to the vector list of border
+int32 Map::distance(int32 inFrom, int32 inTo) const {
+    if (distanceIndex != nullptr) {
+        return distanceIndex->distance(inFrom, inTo);
+    }
+    if (graph == nullptr) {
+        return MapDistanceIndex::Unreachable;
+    }
+
+    //No index, search from inFrom until inTo is reached
+    vector<int32> hops(graph->getTerritoryCount(), MapDistanceIndex::Unreachable);
+    vector<int32> queue;
+    queue.reserve(graph->getTerritoryCount());
+    queue.push_back(inFrom);
+    hops[inFrom] = 0;
+    for (std::size_t head = 0; head < queue.size() && hops[inTo] == MapDistanceIndex::Unreachable; head++) {
+        const int32 current = queue[head];
+        for (int32 neighbour : graph->getNeighbours(current)) {
+            if (hops[neighbour] == MapDistanceIndex::Unreachable) {
+                hops[neighbour] = hops[current] + 1;
+                queue.push_back(neighbour);
             }
-            a++;
-        }
-        else {
-            this->isValidFile = false;
         }
     }
-  
+    return hops[inTo];
 }
 
-void Map::addTerritoryToContinent(Territory* toAdd) {
-    
-    int targetContinent = toAdd->getContinent();
-    if (targetContinent > listContinents.size() || targetContinent < 0) {      //check if the continent of the territory is valid , if not , the map is invalid. 
-        this->isValidFile = false;
+int32 Map::distance(Territory* inFrom, Territory* inTo) const {
+    return distance(inFrom->getIndex(), inTo->getIndex());
+}
+
+void Map::buildChokepointIndex() {
+    if (graph == nullptr) {
+        return;
     }
-    else {
-        listContinents.at(targetContinent - 1)->getCountryList()->push_back(toAdd);
+
+    std::shared_ptr<MapChokepointIndex> newIndex = std::make_shared<MapChokepointIndex>();
+    newIndex->build(*graph);
+    chokepointIndex = newIndex;
+}
+
+bool Map::hasChokepointIndex() const {
+    return chokepointIndex != nullptr;
+}
+
+const MapChokepointIndex& Map::getChokepointIndex() const {
+    return *chokepointIndex;
+}
+
+void Map::buildSpatialIndex() {
+    vector<int32> posx(listTerritory.size());
+    vector<int32> posy(listTerritory.size());
+    for (std::size_t i = 0; i < listTerritory.size(); i++) {
+        posx[i] = listTerritory[i]->getPosx();
+        posy[i] = listTerritory[i]->getPosy();
     }
+
+    std::shared_ptr<MapSpatialIndex> newIndex = std::make_shared<MapSpatialIndex>();
+    newIndex->build(posx, posy);
+    spatialIndex = newIndex;
 }
 
-bool Map::checkValidSubgraph() {
-    //for every continent
-    vector<bool>* listContinentCheck = new vector<bool>;            //creat an empty vecto that will represent every continent.
-    int targetContinent = 0;                                            
-    for (auto x : listContinents) {                                 //Loop trought all the continent.
-        listContinentCheck->push_back(false);                       //Fill the vector the get an entry for every continent.
-        vector<string>* grapContinentCheck = new vector<string>;    //Creat an empty vector of string 
+bool Map::hasSpatialIndex() const {
+    return spatialIndex != nullptr;
+}
 
-        for (Territory* y : *x->getCountryList()) {          
-            grapContinentCheck->push_back("");                      //Fill the string vector to represent every terrtory who is a member of the continent.
-        };
+const MapSpatialIndex& Map::getSpatialIndex() const {
+    return *spatialIndex;
+}
 
-        x->traverseTerritory(x->getCountryList()->at(0),grapContinentCheck,x->getCountryList()->at(0)->getContinent());     //Call the function to traverse the subgraph.
-        cout << "Done checking for continent : " << x->getName() << endl;
+void Map::findTerritoriesInRect(int32 inMinX, int32 inMinY, int32 inMaxX, int32 inMaxY, vector<int32>& outIndexes) const {
+    if (spatialIndex != nullptr) {
+        spatialIndex->findInRect(inMinX, inMinY, inMaxX, inMaxY, outIndexes);
+        return;
+    }
 
-        if (checkVectorForString(grapContinentCheck)) {             //Call the function to check if every member of the territory could be reached.
-            listContinentCheck->at(targetContinent) = true;         //indicate that this subgraph is valid
+    outIndexes.clear();                                     //No index, every territory is checked
+    for (int32 i = 0; i < static_cast<int32>(listTerritory.size()); i++) {
+        const int32 x = listTerritory[i]->getPosx();
+        const int32 y = listTerritory[i]->getPosy();
+        if (x >= inMinX && x <= inMaxX && y >= inMinY && y <= inMaxY) {
+            outIndexes.push_back(i);
         }
-        targetContinent++;
-        delete grapContinentCheck;
-            
     }
+}
 
-    if (checkVectorForTrue(listContinentCheck)) {                   //Check that every subgraph are valid.
-        return true;
+void Map::findTerritoriesInRadius(int32 inX, int32 inY, int32 inRadius, vector<int32>& outIndexes) const {
+    if (spatialIndex != nullptr) {
+        spatialIndex->findInRadius(inX, inY, inRadius, outIndexes);
+        return;
     }
-    else {
-        return false;
+
+    outIndexes.clear();
+    if (inRadius < 0) {
+        return;
+    }
+    const int64 radius = inRadius;
+    for (int32 i = 0; i < static_cast<int32>(listTerritory.size()); i++) {
+        const int64 dx = static_cast<int64>(listTerritory[i]->getPosx()) - inX;
+        const int64 dy = static_cast<int64>(listTerritory[i]->getPosy()) - inY;
+        if (dx * dx + dy * dy <= radius * radius) {
+            outIndexes.push_back(i);
+        }
     }
-   
 }
 
-bool Map::checkValidGraph() {
-    vector<bool>* testGraph = new vector<bool>;                     //Empty bool vector that will represent every territory of the map.
-    for (auto x : listTerritory) {                                  //demo loop to creat a vector of the size of the number of territory
-        testGraph->push_back(false);
+void Map::findNearestTerritories(int32 inX, int32 inY, int32 inCount, vector<int32>& outIndexes) const {
+    if (spatialIndex != nullptr) {
+        spatialIndex->findNearest(inX, inY, inCount, outIndexes);
+        return;
     }
-    this->traverseTerritory(listTerritory.at(0), testGraph);        //Call the recusive traversal algorythm to check if the graph is valid 
-    if (checkVectorForTrue(testGraph))                              //Check if the graph is valid.
-    {
-        return true;
+
+    outIndexes.clear();
+    vector<std::pair<int64, int32>> candidates(listTerritory.size());      //Squared distance and index of every territory
+    for (int32 i = 0; i < static_cast<int32>(listTerritory.size()); i++) {
+        const int64 dx = static_cast<int64>(listTerritory[i]->getPosx()) - inX;
+        const int64 dy = static_cast<int64>(listTerritory[i]->getPosy()) - inY;
+        candidates[i] = std::make_pair(dx * dx + dy * dy, i);
     }
-    else {
-        this->isValidFile = false;
-        return false;
+    const std::size_t count = static_cast<std::size_t>(std::max(0, std::min(inCount, static_cast<int32>(candidates.size()))));
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end());
+    for (std::size_t i = 0; i < count; i++) {
+        outIndexes.push_back(candidates[i].second);
     }
-    
-    delete testGraph;
 }
 
-/*
-// Will loop trought every territory and check if they are only member of one continent.
-*/
-bool Map::checkContinents() {
-    for (auto x : listTerritory) {                              //Loop trought every Territory.
-       
-        bool* found = new bool;                                 //bool to keep track if the territory was found in a continent.
-        *found = false;
-        for (auto w : listContinents) {                         //Loop trought every continent of the map and check if the territory is found in their list.
-            if (!w->checkTerritory(x->getID(), found)) {        //If the territory is member of multiple continent, it will retrun false.
-                return false;
-            }
-            
-        }
+void Map::attachTerritories() {
+    state.resize(static_cast<int32>(listTerritory.size()));
+
+    vector<int32> continents(listTerritory.size());             //Known before any owner so the continent counters start empty
+    for (std::size_t i = 0; i < listTerritory.size(); i++) {
+        continents[i] = listTerritory[i]->getContinent() - 1;
+    }
+    state.assignContinents(std::move(continents), static_cast<int32>(listContinents.size()));
+
+    for (int32 i = 0; i < static_cast<int32>(listTerritory.size()); i++) {
+        listTerritory[i]->attachToMap(this, i);
+    }
+    for (int32 i = 0; i < static_cast<int32>(listContinents.size()); i++) {
+        listContinents[i]->attachToMap(this, i);
     }
-    return true;
 }
 
-/*
-// check if the territory is found in multiple continent 
-*/
-bool Continent::checkTerritory(int id , bool* found) {
-    for (auto y : listMemberTerritory) {
-        if (y->getID() == id) {
-            if (*found == false) {
-                *found = true;
-            }
-            else {
-                return false;
-            }
-        }
+int32 Map::internSymbol(std::string_view inName) {
+    int32 symbol = symbols->find(inName);
+    if (symbol != SymbolTable::NoSymbol) {
+        return symbol;
     }
-    return true;
+    if (symbols.use_count() > 1) {                               //Other games read the shared table, this map gets its own
+        symbols = std::make_shared<SymbolTable>(*symbols);
+    }
+    return symbols->intern(inName);
 }
 
-/*
-// Funtion that check it the map is a valid graph , if every continent are valid subgraph, and if every territory are only member of a single continent.
-*/
-bool Map::validate() {
-    if (this->getValidity()) {
-        if (this->checkValidGraph()) {
-            cout << "This map is a valid graph" << endl;
-            if (this->checkValidSubgraph()) {
-                cout << "This Map have valid Continent as sub-graph." << endl;
-                if (checkContinents()) {
-                    cout << "This Map have valid continent." << endl;
-                    return true;
-                }
-                else {
-                    cout << "This map does not have valid continent.";
-                    return false;
-                }
-            }
-            else {
-                cout << "This Map does not have valid sub-graph." << endl;
-                return false;
-            }
-        }
-        else {
-            cout << "This map is not a valid graph." << endl;
-            return false;
-        }
+void Map::buildLookups() {
+    std::shared_ptr<MapLookups> built = std::make_shared<MapLookups>();
+    built->territoryIds.reserve(static_cast<int32>(listTerritory.size()));     //File ids back to the dense indexes, they may have gaps or been reordered
+    for (int32 i = 0; i < static_cast<int32>(listTerritory.size()); i++) {
+        built->territoryIds.insert(listTerritory[i]->getID(), i);
     }
-    else {
-        cout << "This file is not valid at all,";
-        return false;
+
+    built->territoryBySymbol.assign(symbols->getSize(), -1);                   //Reverse lookup of the names, rebuilt with the positions
+    built->continentBySymbol.assign(symbols->getSize(), -1);
+    for (int32 i = 0; i < static_cast<int32>(listTerritory.size()); i++) {
+        indexName(built->territoryBySymbol, listTerritory[i]->getNameSymbol(), i);
     }
-    
+    for (int32 i = 0; i < static_cast<int32>(listContinents.size()); i++) {
+        indexName(built->continentBySymbol, listContinents[i]->getNameSymbol(), i);
+    }
+    lookups = built;
 }
 
-/*
-//  Function to travese all the adjacent node of a territory. 
-*/
-bool Map::traverseTerritory(Territory* territory, vector<bool>* visitedTerritory) {
-    for (auto T : territory->getBorderList()) {                //Loop trought all the adjacent territory of the current territory
-        if (visitedTerritory->at(T->getID() - 1) == false) {    //check if the territory was already visited
-            visitedTerritory->at(T->getID() - 1) = true;        //if not , mark it ass visited and call the recursive function on it 
-            traverseTerritory(T, visitedTerritory);
-        }        
+MapLookups& Map::editLookups() {
+    if (lookups == nullptr) {
+        lookups = std::make_shared<MapLookups>();
     }
-    return true;
+    else if (lookups.use_count() > 1) {                          //Other instances read the shared lookups, this map gets its own
+        lookups = std::make_shared<MapLookups>(*lookups);
+    }
+    return *lookups;
 }
 
-/*
-* Retreives territory ids
-* This function will help facilitating the retrieval of
-* territory objects by searching a territory by its id.
-*/
-std::vector<int> Map::getTerritoryIds() {
-    vector<int> territoryIds;
-    for (Territory* t : this->listTerritory) {
-        territoryIds.push_back(t->getID());
+void Map::indexName(std::vector<int32>& outLookup, int32 inSymbol, int32 inPosition) {
+    if (inSymbol == SymbolTable::NoSymbol) {
+        return;
+    }
+    if (inSymbol >= static_cast<int32>(outLookup.size())) {
+        outLookup.resize(inSymbol + 1, -1);
+    }
+    if (outLookup[inSymbol] == -1) {
+        outLookup[inSymbol] = inPosition;
     }
-    return territoryIds;
 }
 
-/*
-//Recusive function to only check the subgraph of a continent
-*/
-bool Continent::traverseTerritory(Territory* territory, vector<string>* visitedTerritory,int continent) {
-    int size = visitedTerritory->size();                        //saving the size of the numbr of territory that are suppose to be in the continent.
-    bool finishCheck = false;
-    for (int i = 0; i < size && finishCheck== false; i++ ) {    //Loop trought the vector containing the name of every terrtory visited.
-        if (visitedTerritory->at(i) == "") {                    //if en empty space is found, ad the name the territory getting check in the vector.
-            visitedTerritory->at(i) = territory->getName();
-            finishCheck = true;
-        }
-        else if (visitedTerritory->at(i) == territory->getName()) { //if the territory was already inside , do nothing
-            finishCheck = true;
-        }   
-    }
-        
-    for (auto T: territory->getBorderList()) {                    //Will loop trough all the territory of the adgecency list.
-        if (T->getContinent() == continent) {                      // Check if the territory is member of the good continent. 
-            bool innerFinishCheck = false;
-            for (int i = 0; i < size && innerFinishCheck == false; i++) { //loop trough all the adgecent territory and call the function resursively if needed
-                if (visitedTerritory->at(i) == "") {
-                    traverseTerritory(T, visitedTerritory, continent);
-                    innerFinishCheck = true;
-                }
-                else if (visitedTerritory->at(i) == T->getName()) {
-                    innerFinishCheck = true;
-                }
-            } 
+Territory* Map::findTerritory(std::string_view inName) const {
+    const int32 symbol = symbols->find(inName);
+    if (lookups == nullptr || symbol == SymbolTable::NoSymbol) {
+        return nullptr;
+    }
+    const std::vector<int32>& bySymbol = lookups->territoryBySymbol;
+    if (symbol >= static_cast<int32>(bySymbol.size()) || bySymbol[symbol] == -1) {
+        return nullptr;
+    }
+    Territory* territory = listTerritory[bySymbol[symbol]];
+    return territory->getNameSymbol() == symbol ? territory : nullptr;      //It may have been renamed since
+}
+
+Continent* Map::findContinent(std::string_view inName) const {
+    const int32 symbol = symbols->find(inName);
+    if (lookups == nullptr || symbol == SymbolTable::NoSymbol) {
+        return nullptr;
+    }
+    const std::vector<int32>& bySymbol = lookups->continentBySymbol;
+    if (symbol >= static_cast<int32>(bySymbol.size()) || bySymbol[symbol] == -1) {
+        return nullptr;
+    }
+    Continent* continent = listContinents[bySymbol[symbol]];
+    return continent->getNameSymbol() == symbol ? continent : nullptr;
+}
+
+const SymbolTable& Map::getSymbols() const {
+    return *symbols;
+}
+
+bool Map::hasGraph() const {
+    return graph != nullptr;
+}
+
+const MapGraph& Map::getGraph() const {
+    return *graph;
+}
+
+Territory* Map::getTerritoryByIndex(int32 inIndex) const {
+    return listTerritory[inIndex];
+}
+
+Territory* Map::getTerritoryById(int32 inId) const {
+    const int32 index = getTerritoryIndexById(inId);
+    return index == TerritoryIdIndex::NotFound ? nullptr : listTerritory[index];
+}
+
+int32 Map::getTerritoryIndexById(int32 inId) const {
+    if (lookups != nullptr && lookups->territoryIds.getSize() == static_cast<int32>(listTerritory.size())) {
+        return lookups->territoryIds.find(inId);
+    }
+    for (int32 i = 0; i < static_cast<int32>(listTerritory.size()); i++) {     //Not indexed yet, or an id is used twice
+        if (listTerritory[i]->getID() == inId) {
+            return i;
         }
     }
-    return true;
+    return TerritoryIdIndex::NotFound;
+}
+
+TerritoryState& Map::getState() {
+    return state;
+}
+
+const TerritoryState& Map::getState() const {
+    return state;
 }
+
 //continent constructor
 Continent::Continent() {
     armyValue = 0;
@@ -488,11 +837,11 @@ Continent::Continent() {
     string colour;
 }
 
-//Continent copy constructor 
+//Continent copy constructor, the copy is not attached and holds its name itself
 Continent::Continent(const Continent& c ) {
     armyValue = c.armyValue;
-    string name = c.name;
-    string colour = c.colour;
+    name = string(c.getNameView());
+    colour = c.colour;
     listMemberTerritory = c.listMemberTerritory;
 }
 
@@ -509,7 +858,13 @@ void Continent::setArmyValue(int value) {
 }
 
 void Continent::setName(string name) {    
+    if (map != nullptr) {
+        nameSymbol = map->internSymbol(name);
+        map->indexName(map->editLookups().continentBySymbol, nameSymbol, index);
+        return;
+    }
     this->name = name;
+    nameSymbol = SymbolTable::NoSymbol;
 }
 
 void Continent::setColour(string value) {
@@ -519,8 +874,36 @@ void Continent::setColour(string value) {
 
 
 string Continent::getName() {
-    string toReturn = this->name;
-    return toReturn;
+    return string(getNameView());
+}
+
+std::string_view Continent::getNameView() const {
+    if (map != nullptr && nameSymbol != SymbolTable::NoSymbol) {
+        return map->getSymbols().getName(nameSymbol);
+    }
+    return name;
+}
+
+void Continent::attachToMap(Map* inMap, int32 inIndex) {
+    if (map != nullptr && map != inMap && nameSymbol != SymbolTable::NoSymbol) {
+        name = string(getNameView());                       //The symbol belongs to the other map
+        nameSymbol = SymbolTable::NoSymbol;
+    }
+    this->map = inMap;
+    this->index = inIndex;
+    if (nameSymbol == SymbolTable::NoSymbol) {
+        nameSymbol = inMap->internSymbol(name);
+        name = string();
+    }
+}
+
+int32 Continent::getNameSymbol() const {
+    return nameSymbol;
+}
+
+void Continent::setNameSymbol(int32 inSymbol) {
+    nameSymbol = inSymbol;
+    name = string();
 }
 
 int Continent::getArmyValu() {
@@ -528,8 +911,11 @@ int Continent::getArmyValu() {
 }
 
 string Continent::getColour() {
-    string toReturn = this->colour;
-    return toReturn;
+    return string(getColourView());
+}
+
+std::string_view Continent::getColourView() const {
+    return colour;
 }
 
 vector<Territory*>* Continent::getCountryList(){
@@ -551,10 +937,11 @@ Territory::Territory() {
 //Territory  copy constructor
 Territory::Territory(const Territory &t) {
     id = t.id;
-    name = t.name;
+    name = string(t.getNameView());                         //The copy is not attached, it holds its name itself
     continent = t.continent;
-    player = t.player;
-    nbArmy = t.nbArmy;
+    player = t.getPlayer();
+    nbArmy = t.getNbArmy();
+    value = t.getValue();
     posx = t.posx;
     posy = t.posy;
     listBorder = t.listBorder;
@@ -593,7 +980,13 @@ void Territory::setId(int id) {
 }
 
 void Territory::setName(string name) {
+    if (map != nullptr) {
+        nameSymbol = map->internSymbol(name);
+        map->indexName(map->editLookups().territoryBySymbol, nameSymbol, index);
+        return;
+    }
     this->name = name;
+    nameSymbol = SymbolTable::NoSymbol;
 }
 
 void Territory::setPosx(int posx) {
@@ -610,23 +1003,73 @@ int Territory::getID() const
 }
 
 void Territory::setPlayer(Player* newPlayer) {
+    if (map != nullptr) {
+        map->getState().setOwnerPlayer(index, newPlayer);
+        return;
+    }
     this->player = newPlayer;
 }
 
 void Territory::setNbArmy(int newNbArmy) {
+    if (map != nullptr) {
+        map->getState().setArmies(index, newNbArmy);
+        return;
+    }
     this->nbArmy = newNbArmy;
 }
 
 int Territory::getContinent() { return continent; };
 int Territory::getPosx() { return posx; };
 int Territory::getPosy() { return posy; };
-std::string Territory::getName() { return name; };
-Player* Territory::getPlayer() { return player; };
-int Territory::getNbArmy() const { return nbArmy; };
+std::string Territory::getName() { return string(getNameView()); };
+
+std::string_view Territory::getNameView() const {
+    if (map != nullptr && nameSymbol != SymbolTable::NoSymbol) {
+        return map->getSymbols().getName(nameSymbol);
+    }
+    return name;
+}
+Player* Territory::getPlayer() const { return map != nullptr ? map->getState().getOwnerPlayer(index) : player; };
+int Territory::getNbArmy() const { return map != nullptr ? map->getState().getArmies(index) : nbArmy; };
 std::vector<Territory*>& Territory::getBorderList() { return this->listBorder; };
 
-void Territory::setValue(int inValue) { this->value = inValue; }
-int Territory::getValue() const { return this->value; }
+void Territory::attachToMap(Map* inMap, int32 inIndex) {
+    if (map != nullptr && map != inMap && nameSymbol != SymbolTable::NoSymbol) {
+        name = string(getNameView());                       //The symbol belongs to the other map
+        nameSymbol = SymbolTable::NoSymbol;
+    }
+    this->map = inMap;
+    this->index = inIndex;
+    if (nameSymbol == SymbolTable::NoSymbol) {
+        nameSymbol = inMap->internSymbol(name);
+        name = string();
+    }
+
+    //From now on the map state is the only copy of the mutable values
+    TerritoryState& mapState = inMap->getState();
+    mapState.setOwnerPlayer(inIndex, player);
+    mapState.setArmies(inIndex, nbArmy);
+    mapState.setValue(inIndex, value);
+}
+
+Map* Territory::getMap() const { return map; }
+int32 Territory::getIndex() const { return index; }
+int32 Territory::getNameSymbol() const { return nameSymbol; }
+
+void Territory::setNameSymbol(int32 inSymbol) {
+    nameSymbol = inSymbol;
+    name = string();
+}
+
+void Territory::setValue(int inValue) {
+    if (map != nullptr) {
+        map->getState().setValue(index, inValue);
+        return;
+    }
+    this->value = inValue;
+}
+
+int Territory::getValue() const { return map != nullptr ? map->getState().getValue(index) : value; }
 
 // the value or the level of interest of a territory is determined by the current number of 
 // armies present and the surrounding number of hostile armies that could attack it.
@@ -635,8 +1078,8 @@ int Territory::getValue() const { return this->value; }
 int Territory::CalculateValue(bool& bIsEnemyAdjacent)
 {
     int _value = getNbArmy();
-    
-    for (auto& adjacentTerritory : this->getBorderList())
+
+    auto addThreat = [&](Territory* adjacentTerritory)
     {
         if (adjacentTerritory->getPlayer() == nullptr || getPlayer() == nullptr)
         {
@@ -648,6 +1091,21 @@ int Territory::CalculateValue(bool& bIsEnemyAdjacent)
             bIsEnemyAdjacent = true;
             _value += adjacentTerritory->getNbArmy();
         }
+    };
+
+    if (map != nullptr && map->hasGraph())
+    {
+        for (int32 adjacentIndex : map->getGraph().getNeighbours(index))
+        {
+            addThreat(map->getTerritoryByIndex(adjacentIndex));
+        }
+    }
+    else
+    {
+        for (auto& adjacentTerritory : this->getBorderList())
+        {
+            addThreat(adjacentTerritory);
+        }
     }
 
     setValue(_value);
@@ -658,13 +1116,9 @@ int Territory::CalculateValue(bool& bIsEnemyAdjacent)
 //================= Start of the section for the destructor =============================\\
 
 Continent::~Continent() {
-
-    listMemberTerritory.~vector();
 }
 
 Territory::~Territory() {
-    listBorder.~vector();
-    
 }
 
 bool Territory::operator==(const Territory& inRHS) const
@@ -680,15 +1134,12 @@ Map::~Map() {
     for (auto x : listTerritory) {
         delete x;
     }
-    listContinents.~vector();
-    listTerritory.~vector();
 }
 
 MapLoader::~MapLoader() {
     for (auto y : listMap) {
         delete y;
     }
-    listMap.~vector();
 }
 
 
@@ -703,7 +1154,7 @@ std::ostream& operator << (std::ostream& out, Map& m) {
 }
 
 std::ostream& operator << (std::ostream& out, Continent& c) {
-    std::cout <<  "\nThe continent have the following value:\n Name:"<<c.name<<"\n Colour :"<<c.colour<<"\n Army value: "<<c.armyValue<<endl;
+    std::cout <<  "\nThe continent have the following value:\n Name:"<<c.getNameView()<<"\n Colour :"<<c.colour<<"\n Army value: "<<c.armyValue<<endl;
     for (auto x : c.listMemberTerritory) {
         cout << *x;
     }
@@ -711,11 +1162,11 @@ std::ostream& operator << (std::ostream& out, Continent& c) {
 }
 
 std::ostream& operator << (std::ostream& out, Territory& t) {
-    std::cout << "\nThis territory have the following value:\n Name:" << t.getName()<< "\n Id: " << t.getID() << "\n Player:  " << t.getPlayer() << endl;
+    std::cout << "\nThis territory have the following value:\n Name:" << t.getNameView()<< "\n Id: " << t.getID() << "\n Player:  " << t.getPlayer() << endl;
     std::cout<<" Nb Army :"<<t.getNbArmy() << "\n Pos X : " << t.getPosx() << "\n Pos Y : " << t.getPosy() << endl;
     std::cout << "The folowing territory are connected to it :\n";
     for (auto x : t.getBorderList()) {
-        cout <<" "<< x->getName()<<endl;
+        cout <<" "<< x->getNameView()<<endl;
     }
     return out;
 }
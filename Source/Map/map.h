@@ -1,8 +1,25 @@
 #pragma once
 #include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "Player/Player.h"
+#include "Common/CommonTypes.h"
+#include "Common/SymbolTable.h"
+#include "MapGraph.h"
+#include "TerritoryState.h"
+#include "MapValidator.h"
+#include "MapDistanceIndex.h"
+#include "MapSpatialIndex.h"
+#include "MapChokepointIndex.h"
+#include "MapReorder.h"
+#include "TerritoryIdIndex.h"
+
+class Map;
+class ThreadPool;
+class MapCache;
 
 class Territory {
 private:
@@ -10,12 +27,20 @@ private:
 	int continent;
 	int posx;
 	int posy;
+	// owner, armies and value are only used by territories that are not attached to a map,
+	// attached ones read and write the TerritoryState of their map
 	Player* player = nullptr;
 	int nbArmy;
+	// name of a territory that is not attached, attached ones keep nameSymbol in the symbols of their map
 	std::string name;
+	int32 nameSymbol = SymbolTable::NoSymbol;
 	
 	std::vector<Territory*> listBorder;
-	int value;
+	int value = 0;
+
+	// owning map and position in its graph, unset for territories built outside a map
+	Map* map = nullptr;
+	int32 index = -1;
 public:
 	void setId(int inID);
 	void setContinent(int inContinentID);
@@ -30,10 +55,21 @@ public:
 	int getPosx();
 	int getPosy();
 	std::string getName();
-	Player* getPlayer();
+	// valid until the territory is renamed or its map is destroyed
+	std::string_view getNameView() const;
+	Player* getPlayer() const;
 	int getNbArmy() const;
 	std::vector<Territory*>& getBorderList();
 
+	// links the territory to the graph of the map that owns it
+	void attachToMap(Map* inMap, int32 inIndex);
+	Map* getMap() const;
+	int32 getIndex() const;
+	// id of the name in the symbols of the map, NoSymbol while the name is held by the territory
+	int32 getNameSymbol() const;
+	// names the territory after a symbol of the map it is about to be attached to
+	void setNameSymbol(int32 inSymbol);
+
 	// sets the value or probable interest the territory holds
 	void setValue(int inValue);
 	// gets the value or probable level of interest of the territory
@@ -67,26 +103,36 @@ class Continent {
 private:
 
 	int armyValue;
+	// held here until the continent is attached, like the territory names
 	std::string name;
+	int32 nameSymbol = SymbolTable::NoSymbol;
 	std::string colour;
 	std::vector<Territory*> listMemberTerritory;
 
-public:
-	bool checkTerritory(int, bool*);
+	Map* map = nullptr;
+	int32 index = -1;
 
+public:
 	void setArmyValue(int);
 	void setName(std::string);
 	void setColour(std::string);
-	bool traverseTerritory(Territory*, std::vector<std::string>*, int);	//int is for the continent ID
 
 	friend std::ostream& operator << (std::ostream& out, Continent& c);
 	friend std::istream& operator >> (std::istream& in, Continent& c);
 	
 	int getArmyValu();
 	std::string getColour();
+	// the colour without a copy, valid while the continent is not changed
+	std::string_view getColourView() const;
 	std::string getName();
+	std::string_view getNameView() const;
 	std::vector<Territory*>* getCountryList();
 
+	// done by the map for each of its continents, inIndex is the position in listContinents
+	void attachToMap(Map* inMap, int32 inIndex);
+	int32 getNameSymbol() const;
+	void setNameSymbol(int32 inSymbol);
+
 	Continent();
 	Continent(const Continent &);
 	Continent(int, std::string, std::string, std::vector<Territory*>);
@@ -97,24 +143,89 @@ public:
 
 
 
+// file ids and names back to the positions in Map::listTerritory and Map::listContinents
+struct MapLookups
+{
+	// dense index of every file id
+	TerritoryIdIndex territoryIds;
+	// position of the first holder of every symbol, -1 for none
+	std::vector<int32> territoryBySymbol;
+	std::vector<int32> continentBySymbol;
+};
+
 class Map {
 public:
 	std::vector<Continent*> listContinents;
 	std::vector<Territory*> listTerritory;
 
-	bool creatGraph(std::string);
-	void addBorderToTerritory(std::string);
+	// parse problems are reported to out
+	bool creatGraph(std::string, std::ostream& out = std::cout);
 	void addTerritoryToContinent(Territory*);
 	
-	bool validate();
-	bool checkValidGraph();				//check if the the map is a graph
-	bool checkValidSubgraph();			//check if the continents are valid subgraph
-	bool checkContinents();				//check if every contri only belong to a sigle continents.
-	bool traverseTerritory(Territory*,std::vector<bool>*);
+	// checks the continents on inPool when one is given, the verdict and the report are written to out
+	bool validate(ThreadPool* inPool = nullptr, std::ostream& out = std::cout);
+	// borders are directed, adds the way back to every border that lacks one and returns how many were added
+	int32 symmetrizeBorders();
+	// gives the territories new dense indexes in inOrdering and rebuilds the graph, before any game is played.
+	// File ids are kept, getTerritoryById maps them back. False if the map has no graph.
+	bool reorderTerritories(EMapOrdering inOrdering);
+	// connectivity, continent and membership problems found by the last validate
+	const MapValidationReport& getValidationReport() const;
 
-	bool getValidity();
+	bool getValidity() const;
 
 	std::vector<int> getTerritoryIds(); //Retrieve territory ids
+
+	// builds the CSR adjacency once the territories and their borders are in place
+	void buildGraph();
+	// uses an already built graph, it must describe listTerritory in the same order
+	void setGraph(std::shared_ptr<const MapGraph> inGraph);
+	// new map for a game, it shares this map's graph and gets its own territories and state
+	Map* instantiate() const;
+	// same as instantiate, but the owners, armies and values are copied too
+	Map* clone() const;
+	bool hasGraph() const;
+	const MapGraph& getGraph() const;
+	Territory* getTerritoryByIndex(int32 inIndex) const;
+	// territory with the id it has in the file, nullptr if there is none. The ids may have gaps and any order.
+	Territory* getTerritoryById(int32 inId) const;
+	// dense index of the territory with that file id, TerritoryIdIndex::NotFound if there is none
+	int32 getTerritoryIndexById(int32 inId) const;
+
+	// precomputes the hop distances between territories, the MapLoader does it for every valid map
+	void buildDistanceIndex();
+	bool hasDistanceIndex() const;
+	const MapDistanceIndex& getDistanceIndex() const;
+	// borders to cross between two territories, MapDistanceIndex::Unreachable when there is no path.
+	// Without a distance index every call runs a breadth first search.
+	int32 distance(int32 inFrom, int32 inTo) const;
+	int32 distance(Territory* inFrom, Territory* inTo) const;
+
+	// articulation points, bridges and continent gateways, the MapLoader builds it for every valid map
+	void buildChokepointIndex();
+	bool hasChokepointIndex() const;
+	const MapChokepointIndex& getChokepointIndex() const;
+
+	// grid over the map positions of the territories, the MapLoader builds it for every map it loads
+	void buildSpatialIndex();
+	bool hasSpatialIndex() const;
+	const MapSpatialIndex& getSpatialIndex() const;
+	// dense indexes of the territories placed in the rectangle or the circle, edges included, in rising order.
+	// Without a spatial index every call scans all the territories.
+	void findTerritoriesInRect(int32 inMinX, int32 inMinY, int32 inMaxX, int32 inMaxY, std::vector<int32>& outIndexes) const;
+	void findTerritoriesInRadius(int32 inX, int32 inY, int32 inRadius, std::vector<int32>& outIndexes) const;
+	// dense indexes of the inCount territories placed closest to (inX, inY), closest first. Equal distances go by index.
+	void findNearestTerritories(int32 inX, int32 inY, int32 inCount, std::vector<int32>& outIndexes) const;
+
+	// territory or continent called inName, nullptr if there is none. When names repeat the first one is found.
+	Territory* findTerritory(std::string_view inName) const;
+	Continent* findContinent(std::string_view inName) const;
+	// names of the territories and continents, shared with the game instances
+	const SymbolTable& getSymbols() const;
+
+	// owner, army and value arrays of the territories, indexed like the graph
+	TerritoryState& getState();
+	const TerritoryState& getState() const;
 	
 	friend std::ostream& operator << (std::ostream& out, Map& m);
 	friend std::istream& operator >> (std::istream& in, Map& m);
@@ -126,25 +237,112 @@ public:
 	~Map();
 
 private:
+	friend class MapParser;
+	friend class MapBinaryLoader;
+	friend class Territory;
+	friend class Continent;
+
+	// builds the territories and continents of an empty map after inSource, see instantiate and clone
+	void copyFrom(const Map& inSource, bool bInCopyState);
+	// gives every territory its dense index and moves its mutable values into the state,
+	// the names of the territories and continents move into the symbols
+	void attachTerritories();
+	// file ids and names of the attached territories and continents back to their positions
+	void buildLookups();
+	// the lookups to change, copied first when another map still shares them
+	MapLookups& editLookups();
+	// id of inName, the symbols are copied first when another map still shares them
+	int32 internSymbol(std::string_view inName);
+	// inLookup maps a symbol to a position in listTerritory or listContinents, the first holder of a name keeps it
+	void indexName(std::vector<int32>& outLookup, int32 inSymbol, int32 inPosition);
+
 	bool isValidFile;
+
+	std::shared_ptr<const MapGraph> graph;
+	// shared with the game instances like the graph
+	std::shared_ptr<const MapDistanceIndex> distanceIndex;
+	std::shared_ptr<const MapSpatialIndex> spatialIndex;
+	std::shared_ptr<const MapChokepointIndex> chokepointIndex;
+	// never null, shared with the game instances until one of them renames something
+	std::shared_ptr<SymbolTable> symbols;
+	// built when the territories are attached, the instances of a map share it like the graph
+	// until one of them renames something
+	std::shared_ptr<MapLookups> lookups;
+	TerritoryState state;
+	MapValidationReport validationReport;
 	
 	//Continent* arrayContinent[];
 };
 
 
+// what became of one file given to MapLoader::loadMaps
+enum class EMapLoadStatus
+{
+	Valid,
+	// read but rejected by the parser or the validation
+	Invalid,
+	// neither the .map nor a precompiled .wzmap could be read
+	Missing
+};
+
+struct MapLoadResult
+{
+	std::string fileName;
+	EMapLoadStatus status = EMapLoadStatus::Missing;
+	// the instance added to the list of the loader, nullptr unless the map is valid
+	Map* map = nullptr;
+	// what checking the file narrated, printed by loadMaps before the result of the file.
+	// A file asked for twice shares its log with the first request, which is the one printed.
+	std::string log;
+};
+
 class MapLoader {
 public:
-	bool loadMap(std::string);
+	bool loadMap(std::string, EMapValidationMode inMode = EMapValidationMode::Serial);
+	// loads all the files at the same time on the thread pool of the loader, every valid one is added to the list.
+	// outResults[i] is the outcome of inFileNames[i]. False if any of them is not valid.
+	// What each file narrates is kept apart while they load and printed in the order of inFileNames.
+	bool loadMaps(const std::vector<std::string>& inFileNames, std::vector<MapLoadResult>& outResults);
+	static const char* getLoadStatusName(EMapLoadStatus inStatus);
 	int getSize();
 	std::vector<Map*>* getListMap();
 
+	// number of threads used by parallel validation and by loadMaps, 0 uses one per core
+	void setValidationThreadCount(int32 inThreadCount);
+	int32 getValidationThreadCount() const;
+
+	// maps already parsed and validated are taken from inCache, nullptr always loads from disk
+	void setCache(MapCache* inCache);
+	MapCache* getCache() const;
+
+	// off by default, a map with a territory that cannot be reached back fails validation.
+	// On, one-way borders get their way back before validation.
+	void setSymmetrizeBorders(bool bInSymmetrize);
+	bool getSymmetrizeBorders() const;
+
+	// order of the dense territory indexes of the loaded maps, the file order by default
+	void setTerritoryOrdering(EMapOrdering inOrdering);
+	EMapOrdering getTerritoryOrdering() const;
+
 	MapLoader();
 	MapLoader(std::vector<Map*>, int);
 	MapLoader(const MapLoader&);
 	~MapLoader();
 private:
+	// parses and validates one file or takes it from the cache, safe to run for several files at once
+	std::shared_ptr<const Map> loadPrototype(const std::string& fileName, EMapValidationMode inMode, EMapLoadStatus& outStatus, std::ostream& out);
+	// the instance added to the list, nullptr if inPrototype is not valid
+	Map* addInstance(const std::string& fileName, const Map& inPrototype);
+
 	std::vector<Map*> listMap;
 	int size;
+
+	int32 validationThreadCount = 0;
+	MapCache* cache = nullptr;
+	bool bSymmetrizeBorders = false;
+	EMapOrdering territoryOrdering = EMapOrdering::File;
+	// created by the first parallel validation or loadMaps
+	std::unique_ptr<ThreadPool> validationPool;
 };
 
 
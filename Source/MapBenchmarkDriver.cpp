@@ -0,0 +1,150 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Map/map.h"
+#include "Map/MapGenerator.h"
+#include "Map/MapStreamLoader.h"
+#include "Map/MapValidator.h"
+#include "Common/ThreadPool.h"
+#include "Engine/GameEngine.h"
+#include "Engine/GameContext.h"
+#include "Player/Player.h"
+#include "Strategy/PlayerStrategies.h"
+
+#ifdef MAPBENCHMARKDRIVER
+namespace
+{
+	double elapsedMilliseconds(std::chrono::steady_clock::time_point inStart)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inStart).count();
+	}
+
+	// plays one full turn of an aggressive and a benevolent player sharing the map
+	double timeAiTurn(Map* inMap)
+	{
+		GameEngine engine;
+		std::vector<Player*> players;
+		players.push_back(new Player(new AggressivePlayerStrategy(), "aggressive"));
+		players.push_back(new Player(new BenevolentPlayerStrategy(), "benevolent"));
+
+		for (std::size_t i = 0; i < inMap->listTerritory.size(); i++)
+		{
+			Player* owner = players[i % players.size()];
+			inMap->listTerritory[i]->setPlayer(owner);
+			inMap->listTerritory[i]->setNbArmy(1);
+			owner->getTerritoriesOwned().push_back(inMap->listTerritory[i]);
+		}
+		for (auto& player : players)
+		{
+			player->setReinforcementPool(50);
+			engine.getGameContext().registerPlayer(player);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		engine.mainGameLoop(players, inMap, 1);
+		return elapsedMilliseconds(start);
+	}
+}
+
+/*
+	Generates maps from 100 to 1M territories (or up to the size given as first argument),
+	times parsing, validation, streamed loading and one AI turn on each of them and writes the results
+	as CSV to the second argument (map_benchmark.csv by default) and to the console.
+	The AI turn grows much faster than the map, it is only timed up to the size given
+	as third argument (10000 by default) and left empty in the CSV above it.
+*/
+int main(int argc, char** argv)
+{
+	int32 maxTerritories = argc > 1 ? std::stoi(argv[1]) : 1000000;
+	std::string csvPath = argc > 2 ? argv[2] : "map_benchmark.csv";
+	int32 maxTurnTerritories = argc > 3 ? std::stoi(argv[3]) : 10000;
+
+	std::ostringstream csv;
+	csv << "territories,continents,borders,generate_ms,parse_ms,validate_ms,validate_parallel_ms,stream_ms,stream_validate_ms,stream_mb,ai_turn_ms\n";
+
+	ThreadPool pool;
+	for (int32 territoryCount = 100; territoryCount <= maxTerritories; territoryCount *= 10)
+	{
+		MapGeneratorOptions options;
+		options.territoryCount = territoryCount;
+		options.continentCount = territoryCount / 50 + 1;
+		options.averageDegree = 4.0;
+		options.degreeSkew = 0.2;
+		options.planarity = 0.9;
+
+		const std::string path = "benchmark_" + std::to_string(territoryCount) + ".map";
+		MapGenerator generator(options);
+
+		auto start = std::chrono::steady_clock::now();
+		generator.writeFile(path);
+		double generateTime = elapsedMilliseconds(start);
+
+		// the game and the map code are chatty, keep the console for the results
+		std::streambuf* consoleBuffer = std::cout.rdbuf();
+		std::ostringstream discarded;
+		std::cout.rdbuf(discarded.rdbuf());
+
+		Map* map = new Map();
+		start = std::chrono::steady_clock::now();
+		map->creatGraph(path);
+		double parseTime = elapsedMilliseconds(start);
+
+		start = std::chrono::steady_clock::now();
+		bool bIsValid = map->validate();
+		double validateTime = elapsedMilliseconds(start);
+
+		start = std::chrono::steady_clock::now();
+		map->validate(&pool);
+		double parallelValidateTime = elapsedMilliseconds(start);
+
+		// the streaming loader never builds Territory objects
+		MapTopology topology;
+		MapStreamLoader streamLoader;
+		start = std::chrono::steady_clock::now();
+		bool bIsStreamed = streamLoader.loadFile(path, topology);
+		double streamTime = elapsedMilliseconds(start);
+
+		MapValidator validator;
+		start = std::chrono::steady_clock::now();
+		bool bIsStreamValid = bIsStreamed && validator.validate(*topology.graph).bIsValid;
+		double streamValidateTime = elapsedMilliseconds(start);
+		double streamMegabytes = topology.getMemoryUsage() / (1024.0 * 1024.0);
+		topology = MapTopology();
+
+		const bool bTimeTurn = bIsValid && territoryCount <= maxTurnTerritories;
+		double turnTime = bTimeTurn ? timeAiTurn(map) : 0.0;
+
+		std::cout.rdbuf(consoleBuffer);
+		std::remove(path.c_str());
+
+		csv << territoryCount << ',' << options.continentCount << ',' << generator.getBorderCount() << ','
+			<< generateTime << ',' << parseTime << ',' << validateTime << ',' << parallelValidateTime << ','
+			<< streamTime << ',' << streamValidateTime << ',' << streamMegabytes << ',';
+		if (bTimeTurn)
+		{
+			csv << turnTime;
+		}
+		csv << '\n';
+
+		std::cout << territoryCount << " territories: parse " << parseTime << " ms, validate " << validateTime
+			<< " ms, streamed " << streamTime << " ms";
+		if (bTimeTurn)
+		{
+			std::cout << ", AI turn " << turnTime << " ms";
+		}
+		std::cout << (bIsValid ? "" : " (INVALID MAP)") << (bIsStreamValid == bIsValid ? "" : " (STREAMED MAP DIFFERS)") << std::endl;
+
+		delete map;
+	}
+
+	std::ofstream output(csvPath);
+	output << csv.str();
+	std::cout << std::endl << csv.str();
+	return 0;
+}
+#endif
@@ -0,0 +1,36 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Map/MapBinary.h"
+
+#ifdef MAPCONVERTERDRIVER
+// converts the maps named on the command line (or the bundled ones) from map/<name>.map to map/<name>.wzmap
+int main(int argc, char** argv)
+{
+	std::vector<std::string> mapNames;
+	for (int i = 1; i < argc; i++)
+	{
+		mapNames.push_back(argv[i]);
+	}
+	if (mapNames.empty())
+	{
+		mapNames = { "canada", "caribbean", "chutes", "simpsons_world", "startrek", "myImortal" };
+	}
+
+	MapBinaryWriter writer;
+	for (const auto& name : mapNames)
+	{
+		if (writer.convertFile("map/" + name + ".map", "map/" + name + ".wzmap"))
+		{
+			std::cout << name << ".map converted to " << name << ".wzmap" << std::endl;
+		}
+		else
+		{
+			std::cout << name << ".map was not converted: " << writer.getError() << std::endl;
+		}
+	}
+
+	return 0;
+}
+#endif
@@ -0,0 +1,188 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Map/map.h"
+#include "Map/MapGenerator.h"
+#include "Map/MapReorder.h"
+#include "Map/MapValidator.h"
+#include "Common/BitSet.h"
+#include "Player/Player.h"
+
+#ifdef MAPREORDERBENCHMARKDRIVER
+namespace
+{
+	double elapsedMilliseconds(std::chrono::steady_clock::time_point inStart)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inStart).count();
+	}
+
+	// breadth first sweep from every unvisited territory reading the armies on the way, like the
+	// validation and the strategy scans do. Returns the sum so the reads cannot be optimised away.
+	long long sweep(const MapGraph& inGraph, const TerritoryState& inState, std::vector<int32>& outQueue)
+	{
+		const int32 territoryCount = inGraph.getTerritoryCount();
+		BitSet visited(territoryCount);
+		outQueue.resize(territoryCount);
+		long long armies = 0;
+
+		for (int32 seed = 0; seed < territoryCount; seed++)
+		{
+			if (visited.test(seed))
+			{
+				continue;
+			}
+			int32 head = 0;
+			int32 tail = 0;
+			outQueue[tail++] = seed;
+			visited.set(seed);
+			while (head < tail)
+			{
+				const int32 current = outQueue[head++];
+				for (int32 neighbour : inGraph.getNeighbours(current))
+				{
+					armies += inState.getArmies(neighbour);
+					if (!visited.test(neighbour))
+					{
+						visited.set(neighbour);
+						outQueue[tail++] = neighbour;
+					}
+				}
+			}
+		}
+		return armies;
+	}
+
+	// armies bordering the frontier of every player, what an AI reads to pick its targets
+	long long scanFrontiers(const Map& inMap)
+	{
+		const TerritoryState& state = inMap.getState();
+		const MapGraph& graph = inMap.getGraph();
+		long long armies = 0;
+		for (int32 p = 0; p < state.getPlayerCount(); p++)
+		{
+			for (int32 territory : state.getFrontierIndex().getFrontier(p))
+			{
+				for (int32 neighbour : graph.getNeighbours(territory))
+				{
+					armies += state.getOwner(neighbour) != p ? state.getArmies(neighbour) : 0;
+				}
+			}
+		}
+		return armies;
+	}
+}
+
+/*
+	Generates a map whose file ids are shuffled (100000 territories or the size given as first argument),
+	then loads it once per territory ordering and times the reordering, breadth first sweeps,
+	validation, the frontier recount of a snapshot restore and a frontier scan on the reordered indexes.
+	Owners and armies are given by file id so every ordering plays the same position.
+	Results go to the console and as CSV to the second argument (map_reorder_benchmark.csv by default).
+*/
+int main(int argc, char** argv)
+{
+	int32 territoryCount = argc > 1 ? std::stoi(argv[1]) : 100000;
+	std::string csvPath = argc > 2 ? argv[2] : "map_reorder_benchmark.csv";
+	const int32 sweepCount = 5;
+	const int32 playerCount = 4;
+
+	MapGeneratorOptions options;
+	options.territoryCount = territoryCount;
+	options.continentCount = territoryCount / 50 + 1;
+	options.averageDegree = 4.0;
+	options.planarity = 0.95;
+	options.bShuffleIds = true;
+
+	const std::string path = "reorder_benchmark_" + std::to_string(territoryCount) + ".map";
+	MapGenerator generator(options);
+	generator.writeFile(path);
+
+	std::vector<Player*> players;
+	for (int32 p = 0; p < playerCount; p++)
+	{
+		players.push_back(new Player("player " + std::to_string(p)));
+	}
+
+	std::ostringstream csv;
+	csv << "ordering,territories,borders,border_span,reorder_ms,sweep_ms,sweep_medges_per_s,validate_ms,frontier_recount_ms,frontier_scan_ms\n";
+
+	const EMapOrdering orderings[] = { EMapOrdering::File, EMapOrdering::BreadthFirst, EMapOrdering::ReverseCuthillMcKee, EMapOrdering::Hilbert };
+	for (EMapOrdering ordering : orderings)
+	{
+		// the map code is chatty, keep the console for the results
+		std::streambuf* consoleBuffer = std::cout.rdbuf();
+		std::ostringstream discarded;
+		std::cout.rdbuf(discarded.rdbuf());
+
+		Map* map = new Map();
+		map->creatGraph(path);
+
+		auto start = std::chrono::steady_clock::now();
+		map->reorderTerritories(ordering);
+		double reorderTime = elapsedMilliseconds(start);
+
+		for (Territory* territory : map->listTerritory)
+		{
+			territory->setPlayer(players[(territory->getID() / 64) % playerCount]);
+			territory->setNbArmy(territory->getID() % 7 + 1);
+		}
+
+		const MapGraph& graph = map->getGraph();
+		std::vector<int32> queue;
+		long long checksum = 0;
+		start = std::chrono::steady_clock::now();
+		for (int32 i = 0; i < sweepCount; i++)
+		{
+			checksum += sweep(graph, map->getState(), queue);
+		}
+		double sweepTime = elapsedMilliseconds(start) / sweepCount;
+
+		MapValidator validator;
+		start = std::chrono::steady_clock::now();
+		bool bIsValid = validator.validate(*map).bIsValid;
+		double validateTime = elapsedMilliseconds(start);
+
+		// restoring a snapshot recounts the continent counters and the frontier sets from the owners
+		TerritoryStateSnapshot snapshot;
+		map->getState().saveSnapshot(snapshot);
+		start = std::chrono::steady_clock::now();
+		map->getState().restoreSnapshot(snapshot);
+		double frontierBuildTime = elapsedMilliseconds(start);
+
+		start = std::chrono::steady_clock::now();
+		checksum += scanFrontiers(*map);
+		double frontierScanTime = elapsedMilliseconds(start);
+
+		std::cout.rdbuf(consoleBuffer);
+
+		const double span = MapReorder::getAverageBorderSpan(map->getGraph());
+		const double edgesPerSecond = graph.getEdgeCount() / (sweepTime / 1000.0) / 1.0e6;
+		csv << MapReorder::getOrderingName(ordering) << ',' << territoryCount << ',' << map->getGraph().getEdgeCount() << ','
+			<< span << ',' << reorderTime << ',' << sweepTime << ',' << edgesPerSecond << ',' << validateTime << ','
+			<< frontierBuildTime << ',' << frontierScanTime << '\n';
+
+		std::cout << MapReorder::getOrderingName(ordering) << ": border span " << span << ", reorder " << reorderTime
+			<< " ms, sweep " << sweepTime << " ms (" << edgesPerSecond << " M borders/s), validate " << validateTime
+			<< " ms, frontier scan " << frontierScanTime << " ms" << (bIsValid ? "" : " (INVALID MAP)")
+			<< " [" << checksum % 1000 << "]" << std::endl;
+
+		delete map;
+	}
+
+	std::remove(path.c_str());
+	for (Player* player : players)
+	{
+		delete player;
+	}
+
+	std::ofstream output(csvPath);
+	output << csv.str();
+	std::cout << std::endl << csv.str();
+	return 0;
+}
+#endif
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Map/map.h"
+#include "Map/MapGenerator.h"
+#include "Map/MapSpatialIndex.h"
+
+#ifdef MAPSPATIALBENCHMARKDRIVER
+namespace
+{
+	double elapsedMilliseconds(std::chrono::steady_clock::time_point inStart)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inStart).count();
+	}
+
+	enum class EQueryKind
+	{
+		Rect,
+		Radius,
+		Nearest
+	};
+
+	struct Query
+	{
+		int32 x;
+		int32 y;
+		// half side of the rectangle, radius of the circle or number of territories
+		int32 size;
+	};
+
+	// runs every query and keeps the results to compare the two runs
+	double runQueries(const Map& inMap, EQueryKind inKind, const std::vector<Query>& inQueries, std::vector<std::vector<int32>>& outResults)
+	{
+		outResults.resize(inQueries.size());
+		auto start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < inQueries.size(); i++)
+		{
+			const Query& query = inQueries[i];
+			switch (inKind)
+			{
+			case EQueryKind::Rect:
+				inMap.findTerritoriesInRect(query.x - query.size, query.y - query.size, query.x + query.size, query.y + query.size, outResults[i]);
+				break;
+			case EQueryKind::Radius:
+				inMap.findTerritoriesInRadius(query.x, query.y, query.size, outResults[i]);
+				break;
+			case EQueryKind::Nearest:
+				inMap.findNearestTerritories(query.x, query.y, query.size, outResults[i]);
+				break;
+			}
+		}
+		return elapsedMilliseconds(start);
+	}
+}
+
+/*
+	Generates a map of 100000 territories (or the size given as first argument) and runs the same
+	random rectangle, radius and nearest territory queries on it, first scanning every territory
+	then through the spatial index, and checks both give the same territories.
+	The second argument is the number of queries of each kind (1000 by default), results go to the
+	console and as CSV to the third argument (map_spatial_benchmark.csv by default).
+*/
+int main(int argc, char** argv)
+{
+	int32 territoryCount = argc > 1 ? std::stoi(argv[1]) : 100000;
+	int32 queryCount = argc > 2 ? std::stoi(argv[2]) : 1000;
+	std::string csvPath = argc > 3 ? argv[3] : "map_spatial_benchmark.csv";
+	const int32 nearestCount = 8;
+
+	MapGeneratorOptions options;
+	options.territoryCount = territoryCount;
+	options.continentCount = territoryCount / 50 + 1;
+
+	const std::string path = "spatial_benchmark_" + std::to_string(territoryCount) + ".map";
+	MapGenerator generator(options);
+	generator.writeFile(path);
+
+	// the map code is chatty, keep the console for the results
+	std::streambuf* consoleBuffer = std::cout.rdbuf();
+	std::ostringstream discarded;
+	std::cout.rdbuf(discarded.rdbuf());
+	Map map;
+	map.creatGraph(path);
+	std::cout.rdbuf(consoleBuffer);
+	std::remove(path.c_str());
+
+	int32 maxX = 0;
+	int32 maxY = 0;
+	for (Territory* territory : map.listTerritory)
+	{
+		maxX = std::max(maxX, territory->getPosx());
+		maxY = std::max(maxY, territory->getPosy());
+	}
+
+	// a rectangle or circle holds about 100 territories whatever the size of the map
+	std::mt19937 random(7);
+	const double spacing = std::sqrt(static_cast<double>(maxX + 1) * (maxY + 1) / std::max(1, territoryCount));
+	const int32 regionSize = std::max(1, static_cast<int32>(spacing * 5));
+	std::vector<Query> queries(queryCount);
+	for (Query& query : queries)
+	{
+		query.x = std::uniform_int_distribution<int32>(0, maxX)(random);
+		query.y = std::uniform_int_distribution<int32>(0, maxY)(random);
+	}
+
+	std::ostringstream csv;
+	csv << "query,territories,queries,linear_ms,index_ms,speedup,average_results,mismatches\n";
+
+	// copied before the index is built, this one answers by scanning every territory
+	Map unindexed(map);
+
+	auto start = std::chrono::steady_clock::now();
+	map.buildSpatialIndex();
+	const double buildTime = elapsedMilliseconds(start);
+	std::cout << "spatial index of " << territoryCount << " territories: " << map.getSpatialIndex().getColumnCount() << " x "
+		<< map.getSpatialIndex().getRowCount() << " cells, built in " << buildTime << " ms, "
+		<< map.getSpatialIndex().getMemoryUsage() / 1024 << " KB" << std::endl;
+
+	const EQueryKind kinds[] = { EQueryKind::Rect, EQueryKind::Radius, EQueryKind::Nearest };
+	const char* kindNames[] = { "rect", "radius", "nearest" };
+	for (int32 k = 0; k < 3; k++)
+	{
+		for (Query& query : queries)
+		{
+			query.size = kinds[k] == EQueryKind::Nearest ? nearestCount : regionSize;
+		}
+
+		std::vector<std::vector<int32>> linearResults;
+		std::vector<std::vector<int32>> indexResults;
+		const double linearTime = runQueries(unindexed, kinds[k], queries, linearResults);
+		const double indexTime = runQueries(map, kinds[k], queries, indexResults);
+
+		int32 mismatches = 0;
+		std::size_t resultCount = 0;
+		for (std::size_t i = 0; i < queries.size(); i++)
+		{
+			mismatches += linearResults[i] != indexResults[i] ? 1 : 0;
+			resultCount += indexResults[i].size();
+		}
+		const double averageResults = queryCount > 0 ? static_cast<double>(resultCount) / queryCount : 0.0;
+		const double speedup = indexTime > 0.0 ? linearTime / indexTime : 0.0;
+
+		csv << kindNames[k] << ',' << territoryCount << ',' << queryCount << ',' << linearTime << ',' << indexTime << ','
+			<< speedup << ',' << averageResults << ',' << mismatches << '\n';
+		std::cout << kindNames[k] << ": linear scan " << linearTime << " ms, spatial index " << indexTime << " ms (x"
+			<< speedup << "), " << averageResults << " territories per query"
+			<< (mismatches == 0 ? "" : ", RESULTS DIFFER on " + std::to_string(mismatches) + " queries") << std::endl;
+	}
+
+	std::ofstream output(csvPath);
+	output << csv.str();
+	std::cout << std::endl << csv.str();
+	return 0;
+}
+#endif
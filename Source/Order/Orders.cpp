@@ -11,13 +11,39 @@
 #include <iterator>
 #include <list>
 #include <string>
-#include <random>
 
 #include "Orders.h"
 #include "Map/map.h"
 #include "Player/Player.h"
-#include "Engine/GameEngine.h"
+#include "Engine/GameContext.h"
 #include "Common/localization.h"
+#include "Common/GameRandom.h"
+
+namespace
+{
+    // id of the player in its game, -1 for none
+    int32 recordPlayer(const Player *inPlayer)
+    {
+        return inPlayer != nullptr ? static_cast<int32>(inPlayer->getPlayerID()) : -1;
+    }
+
+    // dense index of the territory in its map, -1 for none
+    int32 recordTerritory(const Territory *inTerritory)
+    {
+        return inTerritory != nullptr ? inTerritory->getIndex() : -1;
+    }
+
+    // territory of the map of inGame at inIndex, nullptr when the index is outside it
+    Territory *findTerritory(GameContext &inGame, int32 inIndex)
+    {
+        Map *map = inGame.getMap();
+        if (map == nullptr || inIndex < 0 || inIndex >= static_cast<int32>(map->listTerritory.size()))
+        {
+            return nullptr;
+        }
+        return map->getTerritoryByIndex(inIndex);
+    }
+}
 
 /********************************************************************
  * Order class function definitions
@@ -184,6 +210,45 @@ std::string Order::stringToLog() {
     std::string  toLog = "Temporary info : order executed name : " + this->getTypeName() + " , order description : " + this->getDescription();
     return toLog;
 }
+
+/**
+ * Builds the order described by a record
+ *
+ * @param inRecord the order, players by id and territories by dense index
+ * @param inGame the game the ids and indexes refer to
+ * @return a new order owned by the caller, nullptr if the record does not fit the game
+ */
+Order *Order::createFromRecord(const OrderRecord &inRecord, GameContext &inGame)
+{
+    Player *owner = inGame.findPlayerByID(inRecord.owner);
+    if (owner == nullptr || inRecord.armies < 0)
+    {
+        return nullptr;
+    }
+
+    Territory *source = findTerritory(inGame, inRecord.source);
+    Territory *target = findTerritory(inGame, inRecord.target);
+    switch (inRecord.type)
+    {
+        case EOrderType::Deploy:
+            return target != nullptr ? new Deploy(owner, inRecord.armies, target) : nullptr;
+        case EOrderType::Advance:
+            return source != nullptr && target != nullptr ? new Advance(owner, source, target, inRecord.armies) : nullptr;
+        case EOrderType::Bomb:
+            return target != nullptr ? new Bomb(owner, target) : nullptr;
+        case EOrderType::Blockade:
+            return target != nullptr ? new Blockade(&inGame, owner, target) : nullptr;
+        case EOrderType::Airlift:
+            return source != nullptr && target != nullptr ? new Airlift(owner, source, target, inRecord.armies) : nullptr;
+        case EOrderType::Negotiate:
+        {
+            Player *other = inGame.findPlayerByID(inRecord.target);
+            return other != nullptr ? new Negotiate(owner, other) : nullptr;
+        }
+        default:
+            return nullptr;
+    }
+}
 /********************************************************************
  * Deploy class function definitions
  ********************************************************************/
@@ -252,8 +317,8 @@ void Deploy::execute()
 
         targetTerritory->setNbArmy(armies);
 
-        std::cout << owner->getPlayerName() << " placed " << std::to_string(armies)
-            << " units on " << targetTerritory->getName() << "." << std::endl;
+        owner->getOutput() << owner->getPlayerNameView() << " placed " << std::to_string(armies)
+            << " units on " << targetTerritory->getNameView() << ".\n";
     }
     // Pizza  
     // call notify at the end of the execute function
@@ -285,6 +350,15 @@ bool Deploy::validate()
 
 
 
+void Deploy::getRecord(OrderRecord &outRecord) const
+{
+    outRecord = OrderRecord();
+    outRecord.type = EOrderType::Deploy;
+    outRecord.owner = recordPlayer(owner);
+    outRecord.target = recordTerritory(targetTerritory);
+    outRecord.armies = static_cast<int32>(armiesToDeploy);
+}
+
 /********************************************************************
  * Advance class function definitions
  ********************************************************************/
@@ -351,37 +425,34 @@ void Advance::execute()
             dest->setNbArmy(remainingAdvancingArmies + dest->getNbArmy());
             src->setNbArmy(src->getNbArmy() - remainingAdvancingArmies);
 
-            std::cout << owner->getPlayerName() << " moved " << std::to_string(remainingAdvancingArmies)
-                << " units from " << src->getName() << " to " << dest->getName() << "!" << std::endl;
+            owner->getOutput() << owner->getPlayerNameView() << " moved " << std::to_string(remainingAdvancingArmies)
+                << " units from " << src->getNameView() << " to " << dest->getNameView() << "!\n";
         }
         else
         {
             Player* defender = dest->getPlayer();
 
-            std::cout << owner->getPlayerName() << " is attacking " << dest->getName() << " owned by "
-                << dest->getPlayer()->getPlayerName() << " with " << std::to_string(remainingAdvancingArmies)
-                << " units from " << src->getName() << "!" << std::endl;
+            owner->getOutput() << owner->getPlayerNameView() << " is attacking " << dest->getNameView() << " owned by "
+                << dest->getPlayer()->getPlayerNameView() << " with " << std::to_string(remainingAdvancingArmies)
+                << " units from " << src->getNameView() << "!\n";
 
             // WAAAAAGH!!!! The enemy territory has defenders! o7
             if (dest->getNbArmy() > 0)
             {
-                // initial our random number generator, this is a better and more secure
-                // than the typical default rng method
-                std::random_device dev;
-                std::mt19937 rng(dev());
-                std::uniform_int_distribution<std::mt19937::result_type> dist100(1, 100);
+                // every battle of the game draws from its combat stream, the same seed fights the same battles
+                RandomStream& combatRandom = owner->getRandom().getStream(ERandomStream::Combat);
                 for (int i = 0; i < initialAdvancingArmies; ++i)
                 {
                     if (dest->getNbArmy() > 0)
                     {
-                        int attackResult = dist100(rng);
+                        int attackResult = combatRandom.nextInRange(1, 100);
                         // 60% chance to eliminate a defending unit
                         if (attackResult <= ATTACKER_CHANCE)
                         {
                             dest->setNbArmy(std::max(0, dest->getNbArmy() - 1));
                         }
 
-                        int defendResult = dist100(rng);
+                        int defendResult = combatRandom.nextInRange(1, 100);
 
                         // 70% chance a defending unit can eliminate an 
                         // attacking unit
@@ -401,25 +472,25 @@ void Advance::execute()
                     dest->setNbArmy(remainingAdvancingArmies);
                     owner->setCapturedTerritoryFlag(true);
 
-                    std::cout << src->getPlayer()->getPlayerName() << " took " << dest->getName()
-                        << " from " << defender->getPlayerName() << "!" << std::endl;
+                    owner->getOutput() << src->getPlayer()->getPlayerNameView() << " took " << dest->getNameView()
+                        << " from " << defender->getPlayerNameView() << "!\n";
                 }
                 else
                 {
-                    std::cout << src->getPlayer()->getPlayerName() << " failed to take " << dest->getName()
-                        << " from " << defender->getPlayerName() << "!" << std::endl;
+                    owner->getOutput() << src->getPlayer()->getPlayerNameView() << " failed to take " << dest->getNameView()
+                        << " from " << defender->getPlayerNameView() << "!\n";
 
-                    std::cout << defender->getPlayerName() << " has "
+                    owner->getOutput() << defender->getPlayerNameView() << " has "
                         << std::to_string(dest->getNbArmy())
-                        << " troops remaining. " << std::endl;
+                        << " troops remaining. \n";
                 }
 
                 // happens either way
                 src->setNbArmy(src->getNbArmy() - initialAdvancingArmies);
 
-                std::cout << src->getPlayer()->getPlayerName() << " lost "
+                owner->getOutput() << src->getPlayer()->getPlayerNameView() << " lost "
                     << std::to_string(initialAdvancingArmies - remainingAdvancingArmies)
-                    << " troops. " << std::endl;
+                    << " troops. \n";
             }
             else
             {
@@ -434,12 +505,12 @@ void Advance::execute()
                     src->setNbArmy(src->getNbArmy() - initialAdvancingArmies);
                     owner->getTerritoriesOwned().push_back(dest);
 
-                    std::cout << src->getPlayer()->getPlayerName() << " took " << dest->getName()
-                        << " from " << defender->getPlayerName() << "!" << std::endl;
+                    owner->getOutput() << src->getPlayer()->getPlayerNameView() << " took " << dest->getNameView()
+                        << " from " << defender->getPlayerNameView() << "!\n";
                 }
                 else
                 {
-                    std::cout << "error, territory not found to remove" << std::endl;
+                    owner->getOutput() << "error, territory not found to remove\n";
                 }
             }
 
@@ -485,6 +556,16 @@ bool Advance::validate()
     return true;
 }
 
+void Advance::getRecord(OrderRecord &outRecord) const
+{
+    outRecord = OrderRecord();
+    outRecord.type = EOrderType::Advance;
+    outRecord.owner = recordPlayer(owner);
+    outRecord.source = recordTerritory(src);
+    outRecord.target = recordTerritory(dest);
+    outRecord.armies = static_cast<int32>(armiesToAdvance);
+}
+
 /********************************************************************
  * Bomb class function definitions
  ********************************************************************/
@@ -494,7 +575,7 @@ Bomb::Bomb() : Order(EOrderType::Bomb, BOMB_DESC)
 
 }
 
-Bomb::Bomb(Player* inOwner, Territory* inTarget)
+Bomb::Bomb(Player* inOwner, Territory* inTarget) : Order(EOrderType::Bomb, BOMB_DESC)
 {
     this->owner = inOwner;
     this->target = inTarget;
@@ -530,9 +611,9 @@ void Bomb::execute()
     {
         target->setNbArmy(target->getNbArmy() / 2);
 
-        std::cout << owner->getPlayerName() << " bombed " << target->getName()
-            << " owned by " << target->getPlayer()->getPlayerName() << " destroying " 
-            << std::to_string(target->getNbArmy()) << " units!" << std::endl;
+        owner->getOutput() << owner->getPlayerNameView() << " bombed " << target->getNameView()
+            << " owned by " << target->getPlayer()->getPlayerNameView() << " destroying " 
+            << std::to_string(target->getNbArmy()) << " units!\n";
     }
 }
 
@@ -585,41 +666,49 @@ bool Bomb::validate()
     return true;
 }
 
+void Bomb::getRecord(OrderRecord &outRecord) const
+{
+    outRecord = OrderRecord();
+    outRecord.type = EOrderType::Bomb;
+    outRecord.owner = recordPlayer(owner);
+    outRecord.target = recordTerritory(target);
+}
+
 /********************************************************************
  * Blockade class function definitions
  ********************************************************************/
 
 Blockade::Blockade() : Order(EOrderType::Blockade, BLOCKADE_DESC)
 {
-    this->currentInstance = nullptr;
+    this->currentGame = nullptr;
 }
 
-Blockade::Blockade(GameEngine* inCurrentInstance, Player* inOwner, Territory* inTarget)
+Blockade::Blockade(GameContext* inGame, Player* inOwner, Territory* inTarget) : Order(EOrderType::Blockade, BLOCKADE_DESC)
 {
     this->owner = inOwner;
     this->target = inTarget;
-    this->currentInstance = inCurrentInstance;
+    this->currentGame = inGame;
 }
 
 Blockade::~Blockade() 
 {
     this->owner = nullptr;
     this->target = nullptr;
-    this->currentInstance = nullptr;
+    this->currentGame = nullptr;
 }
 
 Blockade::Blockade(const Blockade &blo) : Order(blo)
 {
     this->owner = blo.owner;
     this->target = blo.target;
-    this->currentInstance = blo.currentInstance;
+    this->currentGame = blo.currentGame;
 }
 
 Blockade &Blockade::operator=(const Blockade &blo)
 {
     Order::operator=(blo);
     this->target = blo.target;
-    this->currentInstance = blo.currentInstance;
+    this->currentGame = blo.currentGame;
     return *this;
 }
 
@@ -635,20 +724,21 @@ void Blockade::execute()
     {
         // add the target territory to the neutral player and double the number of troops
         Player* neutralPlayer = nullptr;
-        if (currentInstance != nullptr)
+        if (currentGame != nullptr)
         {
-            neutralPlayer = currentInstance->getNeutralPlayer();
+            neutralPlayer = currentGame->getNeutralPlayer();
             if (neutralPlayer == nullptr)
             {
-                currentInstance->setNeutralPlayer("cpu");
-                neutralPlayer = currentInstance->getNeutralPlayer();
-                currentInstance->getPlayerList().push_back(neutralPlayer);
+                // registering the neutral player already lists it with the players of the game
+                currentGame->setNeutralPlayer("cpu");
+                neutralPlayer = currentGame->getNeutralPlayer();
             }
         }
 
         if (neutralPlayer != nullptr)
         {
             neutralPlayer->getTerritoriesOwned().push_back(target);
+            target->setPlayer(neutralPlayer);
             owner->getTerritoriesOwned().erase
             (
                 std::remove
@@ -662,7 +752,7 @@ void Blockade::execute()
 
             target->setNbArmy(target->getNbArmy() * 2);
 
-            std::cout << owner->getPlayerName() << " blockaded " << target->getName() << std::endl;
+            owner->getOutput() << owner->getPlayerNameView() << " blockaded " << target->getNameView() << '\n';
         }
     }
 }
@@ -670,7 +760,7 @@ void Blockade::execute()
 bool Blockade::validate()
 {
     // check to make sure interactable objects exist
-    if (owner == nullptr || target == nullptr || currentInstance == nullptr)
+    if (owner == nullptr || target == nullptr || currentGame == nullptr)
     {
         return false;
     }
@@ -684,6 +774,14 @@ bool Blockade::validate()
     return true;
 }
 
+void Blockade::getRecord(OrderRecord &outRecord) const
+{
+    outRecord = OrderRecord();
+    outRecord.type = EOrderType::Blockade;
+    outRecord.owner = recordPlayer(owner);
+    outRecord.target = recordTerritory(target);
+}
+
 /********************************************************************
  * Airlift class function definitions
  ********************************************************************/
@@ -692,7 +790,7 @@ Airlift::Airlift() : Order(EOrderType::Airlift, AIRLIFT_DESC)
 {
 }
 
-Airlift::Airlift(Player* inOwner, Territory* inSrc, Territory* inDest, std::size_t inArmiesToAirlift)
+Airlift::Airlift(Player* inOwner, Territory* inSrc, Territory* inDest, std::size_t inArmiesToAirlift) : Order(EOrderType::Airlift, AIRLIFT_DESC)
 {
     this->owner = inOwner;
     this->src = inSrc;
@@ -736,11 +834,11 @@ void Airlift::execute()
         src->setNbArmy(src->getNbArmy() - initialArmiesToAirlift);
         dest->setNbArmy(dest->getNbArmy() + initialArmiesToAirlift);
 
-        std::cout << owner->getPlayerName() << " airlifted " << std::to_string(initialArmiesToAirlift) 
-            << " units from " << src->getName() << " to " << dest->getName() << std::endl;
+        owner->getOutput() << owner->getPlayerNameView() << " airlifted " << std::to_string(initialArmiesToAirlift) 
+            << " units from " << src->getNameView() << " to " << dest->getNameView() << '\n';
 
-        std::cout << src->getName() << " now has " << src->getNbArmy() << " units." << std::endl;
-        std::cout << dest->getName() << " now has " << dest->getNbArmy() << " units." << std::endl;
+        owner->getOutput() << src->getNameView() << " now has " << src->getNbArmy() << " units.\n";
+        owner->getOutput() << dest->getNameView() << " now has " << dest->getNbArmy() << " units.\n";
     }
 }
 
@@ -762,6 +860,16 @@ bool Airlift::validate()
     return false;
 }
 
+void Airlift::getRecord(OrderRecord &outRecord) const
+{
+    outRecord = OrderRecord();
+    outRecord.type = EOrderType::Airlift;
+    outRecord.owner = recordPlayer(owner);
+    outRecord.source = recordTerritory(src);
+    outRecord.target = recordTerritory(dest);
+    outRecord.armies = static_cast<int32>(armiesToAirlift);
+}
+
 /********************************************************************
  * Negotiate class function definitions
  ********************************************************************/
@@ -770,7 +878,7 @@ Negotiate::Negotiate() : Order(EOrderType::Negotiate, NEGOTIATE_DESC)
 {
 }
 
-Negotiate::Negotiate(Player* inOwner, Player* inTarget)
+Negotiate::Negotiate(Player* inOwner, Player* inTarget) : Order(EOrderType::Negotiate, NEGOTIATE_DESC)
 {
     this->owner = inOwner;
     this->target = inTarget;
@@ -808,7 +916,7 @@ void Negotiate::execute()
         if (std::find(targetPlayerNegotiatees.begin(), targetPlayerNegotiatees.end(), owner) == targetPlayerNegotiatees.end())
         {
             target->getNotAttackablePlayers().push_back(owner);
-            std::cout << owner->getPlayerName() << " now has a NAP with " << target->getPlayerName() << "!" << std::endl;
+            owner->getOutput() << owner->getPlayerNameView() << " now has a NAP with " << target->getPlayerNameView() << "!\n";
         }
     }
 }
@@ -828,6 +936,14 @@ bool Negotiate::validate()
     return true;
 }
 
+void Negotiate::getRecord(OrderRecord &outRecord) const
+{
+    outRecord = OrderRecord();
+    outRecord.type = EOrderType::Negotiate;
+    outRecord.owner = recordPlayer(owner);
+    outRecord.target = recordPlayer(target);
+}
+
 /********************************************************************
  * OrdersList class function definitions
  ********************************************************************/
@@ -922,8 +1038,10 @@ void OrdersList::move(int oldIndex, int newIndex)
  */
 void OrdersList::remove(int index)
 {
-    Order *o = get(index);
-    oList.remove(o);
+    auto it = oList.begin();
+    std::advance(it, index); //Erased where it is, the list is not searched for it
+    Order *o = *it;
+    oList.erase(it);
     delete o; //Remove order from memory
 }
 
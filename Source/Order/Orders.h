@@ -17,10 +17,11 @@
 #include <list>
 
 #include"GameLog/LoggingObserver.h"
+#include "Common/CommonTypes.h"
 
 class Territory;
 class Player;
-class GameEngine;
+class GameContext;
 
 enum class EOrderType
 {
@@ -32,6 +33,22 @@ enum class EOrderType
     Negotiate
 };
 
+/**
+ * What an order acts on, players given by id and territories by dense index,
+ * so the order can be written out and built again in a game on the same map
+ */
+struct OrderRecord
+{
+    EOrderType type = EOrderType::Deploy;
+    // id of the player giving the order
+    int32 owner = -1;
+    // territory the armies leave, -1 for orders without one
+    int32 source = -1;
+    // territory acted on, the id of the other player for a Negotiate
+    int32 target = -1;
+    int32 armies = 0;
+};
+
 /**
  * The function and member declarations of the Order class 
  */
@@ -53,6 +70,9 @@ public:
     void setDescrption(std::string inOrderEffect);
     virtual std::string stringToLog();  //use to send the effect of the order as a string 
 
+    virtual void getRecord(OrderRecord &outRecord) const = 0; //Fills the record describing the order
+    // builds the order a record describes in inGame, nullptr if it names a player or territory the game does not have
+    static Order *createFromRecord(const OrderRecord &inRecord, GameContext &inGame);
     
 private:
     EOrderType oType;        //The order type
@@ -76,6 +96,7 @@ public:
 
     virtual void execute() override;
     virtual bool validate() override;
+    virtual void getRecord(OrderRecord &outRecord) const override;
 
     friend std::ostream &operator<<(std::ostream &out, Deploy &dep); //Stream insertion operator
 private:
@@ -101,6 +122,7 @@ public:
 
     virtual void execute() override;
     virtual bool validate() override;
+    virtual void getRecord(OrderRecord &outRecord) const override;
 
     friend std::ostream &operator<<(std::ostream &out, Advance &adv); //Stream insertion operator
 private:
@@ -124,6 +146,7 @@ public:
 
     virtual void execute() override;
     virtual bool validate() override;
+    virtual void getRecord(OrderRecord &outRecord) const override;
 
     friend std::ostream &operator<<(std::ostream &out, Bomb &bom); //Stream insertion operator
 private:
@@ -139,7 +162,7 @@ class Blockade : public Order
 public:
     /* ctors */
     Blockade();
-    Blockade(GameEngine* inCurrentInstance, Player* inOwner, Territory* inTarget);
+    Blockade(GameContext* inGame, Player* inOwner, Territory* inTarget);
     ~Blockade();
     Blockade(const Blockade &blo);
     /* operators */
@@ -147,12 +170,13 @@ public:
 
     virtual void execute() override;
     virtual bool validate() override;
+    virtual void getRecord(OrderRecord &outRecord) const override;
 
     friend std::ostream &operator<<(std::ostream &out, Blockade &blo); //Stream insertion operator
 private:
     Player* owner = nullptr;
     Territory* target = nullptr;
-    GameEngine* currentInstance;
+    GameContext* currentGame;
 };
 
 /**
@@ -169,6 +193,7 @@ public:
 
     virtual void execute() override;
     virtual bool validate() override;
+    virtual void getRecord(OrderRecord &outRecord) const override;
 
     friend std::ostream &operator<<(std::ostream &out, Airlift &air); //Stream insertion operator
 private:
@@ -192,6 +217,7 @@ public:
 
     virtual void execute() override;
     virtual bool validate() override;
+    virtual void getRecord(OrderRecord &outRecord) const override;
 
     friend std::ostream &operator<<(std::ostream &out, Negotiate &ngo); //Stream insertion operator
 private:
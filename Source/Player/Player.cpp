@@ -2,9 +2,10 @@
 #include "Order/Orders.h"
 #include "Cards/Cards.h"
 #include "Map/map.h"
-#include "Engine/GameEngine.h"
+#include "Engine/GameContext.h"
 #include "Strategy/PlayerStrategies.h"
 #include "Common/CommonTypes.h"
+#include "Common/GameRandom.h"
 #include "Common/localization.h"
 #include "CommandProcessor/CommandProcessor.h"
 
@@ -14,13 +15,20 @@
 #include <vector>
 #include <algorithm>
 
-// SIZE_MAX should mean it will auto increment and overflow back to 0
-std::size_t Player::_globalID = SIZE_MAX;
+namespace
+{
+	// ids of players not in a game yet, a game gives its players ids of its own when they join
+	std::size_t takeProvisionalID()
+	{
+		thread_local std::size_t nextID = 0;
+		return nextID++;
+	}
+}
 
 Player::Player()
 {
-	this->_id = ++_globalID;
-	this->currentGameInstance = nullptr;
+	this->_id = takeProvisionalID();
+	this->currentGame = nullptr;
 	this->_playerStrategy = nullptr;
 	this->_hand = new Hand();
 	this->_orders = new OrdersList();
@@ -29,9 +37,11 @@ Player::Player()
 }
 
 Player::Player(PlayerStrategies* ps, std::string playerName) {
-	this->_id = ++_globalID;
+	this->_id = takeProvisionalID();
 	this->_hand = new Hand();
 	this->_orders = new OrdersList();
+	this->_currentPhase = EPlayerTurnPhase::DeployingArmies;
+	this->commandProcess = nullptr;
 	this->setPlayerStrategy(ps);
 	this->setPlayerName(playerName);
 };
@@ -39,8 +49,8 @@ Player::Player(PlayerStrategies* ps, std::string playerName) {
 Player::Player(std::string inPlayerName)
 	: _playerName(inPlayerName)
 {
-	this->_id = ++_globalID;
-	this->currentGameInstance = nullptr;
+	this->_id = takeProvisionalID();
+	this->currentGame = nullptr;
 	this->_playerStrategy = nullptr;
 	this->_hand = new Hand();
 	this->_orders = new OrdersList();
@@ -51,8 +61,8 @@ Player::Player(std::string inPlayerName)
 Player::Player(std::string inPlayerName, PlayerStrategies* inPS)
 	: _playerName(inPlayerName)
 {
-	this->_id = ++_globalID;
-	this->currentGameInstance = nullptr;
+	this->_id = takeProvisionalID();
+	this->currentGame = nullptr;
 	this->_playerStrategy = inPS;
 	this->_hand = new Hand();
 	this->_orders = new OrdersList();
@@ -62,9 +72,9 @@ Player::Player(std::string inPlayerName, PlayerStrategies* inPS)
 
 Player::Player(PlayerStrategies* inPS)
 {
-	this->_id = ++_globalID;
+	this->_id = takeProvisionalID();
 	this->_playerName = "robot" + std::to_string(this->_id);
-	this->currentGameInstance = nullptr;
+	this->currentGame = nullptr;
 	this->_playerStrategy = inPS;
 	this->_hand = new Hand();
 	this->_orders = new OrdersList();
@@ -98,7 +108,7 @@ Player::Player(const Player& inPlayer) : Player()
 
 	this->_playerName = inPlayer._playerName;
 
-	this->currentGameInstance = inPlayer.currentGameInstance;
+	this->currentGame = inPlayer.currentGame;
 
 	this->_playerStrategy = inPlayer._playerStrategy;
 
@@ -121,7 +131,7 @@ Player::~Player()
 		this->_playerStrategy = nullptr;
 	}
 
-	this->currentGameInstance = nullptr;
+	this->currentGame = nullptr;
 
 	if (this->_playerStrategy != nullptr)
 	{
@@ -166,7 +176,7 @@ Player& Player::operator=(const Player& inPlayer)
 
 	this->_playerName = inPlayer._playerName;
 
-	this->currentGameInstance = inPlayer.currentGameInstance;
+	this->currentGame = inPlayer.currentGame;
 
 	this->commandProcess = inPlayer.commandProcess;
 
@@ -176,14 +186,24 @@ Player& Player::operator=(const Player& inPlayer)
 	return *this;
 }
 
-void Player::setCurrentGameInstance(GameEngine* inInstance)
+void Player::setGameContext(GameContext* inGame)
 {
-	this->currentGameInstance = inInstance;
+	this->currentGame = inGame;
 }
 
-GameEngine* Player::getCurrentGameInstance() const
+GameContext* Player::getGameContext() const
 {
-	return this->currentGameInstance;
+	return this->currentGame;
+}
+
+std::ostream& Player::getOutput() const
+{
+	return currentGame != nullptr ? currentGame->getOutput() : std::cout;
+}
+
+GameRandom& Player::getRandom() const
+{
+	return currentGame != nullptr ? currentGame->getRandom() : GameRandom::getFallback();
 }
 
 void Player::toAttack()
@@ -212,6 +232,11 @@ const std::string Player::getPlayerName() const
 	return this->_playerName;
 }
 
+std::string_view Player::getPlayerNameView() const
+{
+	return this->_playerName;
+}
+
 void Player::setPlayerStrategy(PlayerStrategies* inPlayerStrategy)
 {
 	this->_playerStrategy = inPlayerStrategy;
@@ -228,6 +253,11 @@ const std::size_t Player::getPlayerID() const
 	return this->_id;
 }
 
+void Player::setPlayerID(std::size_t inID)
+{
+	this->_id = inID;
+}
+
 OrdersList* Player::getOrders() const
 {
 	return this->_orders;
@@ -391,7 +421,7 @@ void Player::IssueBlockadeOrder(Territory* inDst)
 {
 	if (_orders != nullptr)
 	{
-		_orders->add(new Blockade(this->getCurrentGameInstance(), this, inDst));
+		_orders->add(new Blockade(this->getGameContext(), this, inDst));
 	}
 }
 
@@ -6,6 +6,7 @@
 #include <queue>
 #include <iostream>
 #include <string>
+#include <string_view>
 
 #include "Order/Orders.h"
 #include "Common/CommonTypes.h"
@@ -16,9 +17,10 @@ class Order;
 class OrdersList;
 class Territory;
 class PlayerStrategies;
-class GameEngine;
+class GameContext;
 class Command;
 class CommandProcessor;
+class GameRandom;
 
 enum class EOrderType;
 enum class EPlayerTurnPhase;
@@ -47,15 +49,24 @@ public:
 	/* public member functions */
 	void setPlayerName(std::string inPlayerName);
 	const std::string getPlayerName() const;
+	// no copy, valid until the player is renamed
+	std::string_view getPlayerNameView() const;
 
-	void setCurrentGameInstance(GameEngine* inInstance);
-	GameEngine* getCurrentGameInstance() const;
+	// the game the player is in, set when the game registers it
+	void setGameContext(GameContext* inGame);
+	GameContext* getGameContext() const;
+	// narration of the game the player is in, the console when it is in none
+	std::ostream& getOutput() const;
+	// random numbers of the game the player is in, the streams of its thread when it is in none
+	GameRandom& getRandom() const;
 
 	void setPlayerStrategy(PlayerStrategies* inPlayerStrategy);
 	PlayerStrategies* getPlayerStrategy() const;
 
 
 	const std::size_t getPlayerID() const;
+	// ids only have to differ between the players of one game, the game numbers the players it registers
+	void setPlayerID(std::size_t inID);
 	// returns list of owned territories adjacent to enemy territories in order of owned army strength
 	void toDefend();
 	// returns list of adjacent enemy territories in order of army strength
@@ -135,7 +146,7 @@ private:
 	std::vector<Player*> _playersNotToAttack;
 
 	/* Essential member attributes */
-	GameEngine* currentGameInstance;
+	GameContext* currentGame = nullptr;
 
 	PlayerStrategies* _playerStrategy;
 
@@ -143,8 +154,7 @@ private:
 
 	CommandProcessor* commandProcess;
 
-	// auto-incrementing ID
+	// numbered by the game, players outside any game get one from their thread
 	std::size_t _id = 0;
-	static std::size_t _globalID;
 	/* End Essential member attributes */
 };
\ No newline at end of file
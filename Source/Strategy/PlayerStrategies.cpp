@@ -1,20 +1,18 @@
 #include "Player/Player.h"
 #include "PlayerStrategies.h"
 #include "Map/map.h"
-#include "Engine/GameEngine.h"
+#include "Engine/GameContext.h"
 #include "Cards/Cards.h"
 #include "CommandProcessor/CommandProcessor.h"
 #include "Common/Utilities.h"
 #include "Common/CommonTypes.h"
+#include "Common/GameRandom.h"
 
 #include <vector>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
-#include <chrono>
-#include <ctime>
-#include <random>
 
 Player* PlayerStrategies::getPlayer() const
 {
@@ -26,6 +24,173 @@ void PlayerStrategies::setPlayer(Player* inPlayer)
 	this->_player = inPlayer;
 }
 
+void PlayerStrategies::GatherAdjacentEnemies(Player* inPlayer, std::vector<Territory*>& outEnemies) const
+{
+	const std::vector<Territory*>& ownedTerritories = inPlayer->getTerritoriesOwned();
+
+	Map* map = nullptr;
+	for (const auto& ownedTerritory : ownedTerritories)
+	{
+		if (ownedTerritory != nullptr)
+		{
+			map = ownedTerritory->getMap();
+			break;
+		}
+	}
+
+	// territories loaded from a map read the frontier index kept by the map state
+	if (map != nullptr && map->getState().getFrontierIndex().isBuilt())
+	{
+		const TerritoryState& state = map->getState();
+		for (int32 enemyIndex : state.getFrontierIndex().getAdjacentEnemies(state.findPlayerIndex(inPlayer)))
+		{
+			outEnemies.push_back(map->getTerritoryByIndex(enemyIndex));
+		}
+		return;
+	}
+
+	auto isEnemy = [this, inPlayer](Territory* inTerritory)
+	{
+		if (inTerritory->getPlayer() == nullptr)
+		{
+			GetOutput() << "Warning! Territory has no owner!\n";
+			return false;
+		}
+		return inTerritory->getPlayer()->getPlayerID() != inPlayer->getPlayerID();
+	};
+
+	// territories of a map have a dense index to mark, the others are only told apart by searching the list
+	const std::size_t territoryCount = map != nullptr ? static_cast<std::size_t>(map->getState().getTerritoryCount()) : 0;
+	if (_listedEnemies.size() != territoryCount)
+	{
+		_listedEnemies.resize(territoryCount);
+	}
+	auto isListed = [this, map, &outEnemies](Territory* inTerritory)
+	{
+		if (map != nullptr)
+		{
+			return _listedEnemies.test(inTerritory->getIndex());
+		}
+		return std::find(outEnemies.begin(), outEnemies.end(), inTerritory) != outEnemies.end();
+	};
+
+	const std::size_t firstEnemy = outEnemies.size();
+	for (const auto& ownedTerritory : ownedTerritories)
+	{
+		if (ownedTerritory == nullptr)
+		{
+			continue;
+		}
+
+		for (auto& adjacentTerritory : ownedTerritory->getBorderList())
+		{
+			// making sure no dupes
+			if (isEnemy(adjacentTerritory) && !isListed(adjacentTerritory))
+			{
+				if (map != nullptr)
+				{
+					_listedEnemies.set(adjacentTerritory->getIndex());
+				}
+				outEnemies.push_back(adjacentTerritory);
+			}
+		}
+	}
+
+	if (map != nullptr)
+	{
+		for (std::size_t i = firstEnemy; i < outEnemies.size(); i++)
+		{
+			_listedEnemies.reset(outEnemies[i]->getIndex());
+		}
+	}
+}
+
+void PlayerStrategies::GatherInteriorTerritories(Player* inPlayer, std::vector<Territory*>& outInterior) const
+{
+	const std::vector<Territory*>& ownedTerritories = inPlayer->getTerritoriesOwned();
+
+	Map* map = nullptr;
+	for (const auto& ownedTerritory : ownedTerritories)
+	{
+		if (ownedTerritory != nullptr)
+		{
+			map = ownedTerritory->getMap();
+			break;
+		}
+	}
+
+	if (map != nullptr && map->getState().getFrontierIndex().isBuilt())
+	{
+		const TerritoryState& state = map->getState();
+		for (int32 interiorIndex : state.getFrontierIndex().getInterior(state.findPlayerIndex(inPlayer)))
+		{
+			outInterior.push_back(map->getTerritoryByIndex(interiorIndex));
+		}
+		return;
+	}
+
+	for (const auto& tory : ownedTerritories)
+	{
+		bool isInner = true;
+		for (const auto& adjTory : tory->getBorderList())
+		{
+			if (adjTory->getPlayer() != inPlayer)
+			{
+				isInner = false;
+				break;
+			}
+		}
+
+		if (isInner)
+		{
+			outInterior.push_back(tory);
+		}
+	}
+}
+
+int32 PlayerStrategies::GetDefensePriority(const Territory* inTerritory) const
+{
+	if (inTerritory == nullptr || inTerritory->getMap() == nullptr || !inTerritory->getMap()->hasChokepointIndex())
+	{
+		return 0;
+	}
+	return inTerritory->getMap()->getChokepointIndex().getDefensePriority(inTerritory->getIndex());
+}
+
+std::ostream& PlayerStrategies::GetOutput() const
+{
+	return _player != nullptr ? _player->getOutput() : std::cout;
+}
+
+Territory* PlayerStrategies::FindClosestTo(const std::vector<Territory*>& inCandidates, Territory* inGoal) const
+{
+	if (inGoal == nullptr || inGoal->getMap() == nullptr)
+	{
+		return nullptr;
+	}
+
+	const Map* map = inGoal->getMap();
+	Territory* closest = nullptr;
+	int32 closestDistance = MapDistanceIndex::Unreachable;
+
+	for (const auto& candidate : inCandidates)
+	{
+		if (candidate == nullptr || candidate->getMap() != map)
+		{
+			continue;
+		}
+
+		const int32 hops = map->distance(candidate, inGoal);
+		if (hops != MapDistanceIndex::Unreachable && (closest == nullptr || hops < closestDistance))
+		{
+			closest = candidate;
+			closestDistance = hops;
+		}
+	}
+
+	return closest;
+}
+
 void PlayerStrategies::HandleSaveEffect(Command* inCommand, std::string inMsg)
 {
 	if (commandProcess == nullptr)
@@ -65,7 +230,7 @@ void HumanPlayerStrategy::issueOrder()
 	// Get territories to defend in order of priority
 	const std::vector<Territory*> plToriesToDefend = currentPlayer->getTerritoriesToDefend();
 
-	std::cout << "Issuing orders for " << currentPlayer->getPlayerName() << "\n";
+	std::cout << "Issuing orders for " << currentPlayer->getPlayerNameView() << "\n";
 	currentPlayer->setPlayerTurnPhase(EPlayerTurnPhase::DeployingArmies);
 	int availableReserves = currentPlayer->getReinforcementPoolSize();
 
@@ -83,7 +248,7 @@ void HumanPlayerStrategy::issueOrder()
 			PlayingCards();
 			break;
 		case EPlayerTurnPhase::EndOfTurn:
-			std::cout << "End of " << currentPlayer->getPlayerName() << "'s turn" << std::endl;
+			std::cout << "End of " << currentPlayer->getPlayerNameView() << "'s turn" << std::endl;
 			break;
 		default:
 			currentPlayer->setPlayerTurnPhase(EPlayerTurnPhase::EndOfTurn);
@@ -101,42 +266,12 @@ void HumanPlayerStrategy::toAttack()
 	}
 
 	// toAttack will turn a list of all adjacent enemy territories, in order of territories with the most troops
-	const std::vector<Territory*> allEnemyTerritories = currentPlayer->getCurrentGameInstance()->GetEnemyTerritoriesOfCurrentPlayer(currentPlayer);
+	const std::vector<Territory*> allEnemyTerritories = currentPlayer->getGameContext()->GetEnemyTerritoriesOfCurrentPlayer(currentPlayer);
 
 	std::vector<Territory*> enemyTerritoryByPriority;
 
-	const std::vector<Territory*> allCurrentPlayerTerritories = currentPlayer->getTerritoriesOwned();
-
 	// loop through all territories adjacent 
-	for (auto& ownedTerritory : allCurrentPlayerTerritories)
-	{
-		if (ownedTerritory != nullptr)
-		{
-			for (auto& adjacentTerritory : ownedTerritory->getBorderList())
-			{
-				if (adjacentTerritory->getPlayer() == nullptr)
-				{
-					std::cout << "Warning! Territory has no owner!" << std::endl;
-					continue;
-				}
-
-				if (adjacentTerritory->getPlayer()->getPlayerID() != currentPlayer->getPlayerID())
-				{
-					// making sure no dupes
-					if (enemyTerritoryByPriority.empty() ||
-						std::find
-						(
-							enemyTerritoryByPriority.begin(),
-							enemyTerritoryByPriority.end(),
-							adjacentTerritory
-						) == enemyTerritoryByPriority.end())
-					{
-						enemyTerritoryByPriority.push_back(adjacentTerritory);
-					}
-				}
-			}
-		}
-	}
+	GatherAdjacentEnemies(currentPlayer, enemyTerritoryByPriority);
 
 	std::sort(enemyTerritoryByPriority.begin(), enemyTerritoryByPriority.end(), Utilities::SortByArmySize);
 
@@ -238,7 +373,7 @@ void HumanPlayerStrategy::DeployArmies(int& availableReserves)
 
 		if (words.size() == 2)
 		{
-			if ((std::stringstream(words[0]) >> selectedTory) && (std::stringstream(words[1]) >> amount))
+			if (ReadTerritoryID(words[0], selectedTory) && (std::stringstream(words[1]) >> amount))
 			{
 				amount = std::max(0, amount);
 
@@ -335,8 +470,8 @@ void HumanPlayerStrategy::AdvanceArmies()
 
 	if (words.size() == 3)
 	{
-		if ((std::stringstream(words[0]) >> selectedTorySrc) &&
-			(std::stringstream(words[1]) >> selectedToryDst) &&
+		if (ReadTerritoryID(words[0], selectedTorySrc) &&
+			ReadTerritoryID(words[1], selectedToryDst) &&
 			(std::stringstream(words[2]) >> armiesToAdvance))
 		{
 			Territory* src = nullptr;
@@ -410,7 +545,7 @@ void HumanPlayerStrategy::PlayingCards()
 
 	if (currentHand->getHand().size() > 0)
 	{
-		std::cout << currentPlayer->getPlayerName() << " has " << currentHand->getHand().size()
+		std::cout << currentPlayer->getPlayerNameView() << " has " << currentHand->getHand().size()
 			<< " cards to play." << std::endl;
 		std::cout << "Displaying current hand:" << std::endl;
 
@@ -537,7 +672,7 @@ void HumanPlayerStrategy::PlayingBombCard()
 
 	if (words.size() == 1)
 	{
-		if ((std::stringstream(words[0]) >> selectedToryDst))
+		if (ReadTerritoryID(words[0], selectedToryDst))
 		{
 			Territory* dst = nullptr;
 
@@ -598,7 +733,7 @@ void HumanPlayerStrategy::PlayingBlockadeCard()
 
 	if (words.size() == 1)
 	{
-		if ((std::stringstream(words[0]) >> selectedToryDst))
+		if (ReadTerritoryID(words[0], selectedToryDst))
 		{
 			Territory* dst = nullptr;
 
@@ -662,8 +797,8 @@ void HumanPlayerStrategy::PlayingAirliftCard()
 
 	if (words.size() == 3)
 	{
-		if ((std::stringstream(words[0]) >> selectedTorySrc) &&
-			(std::stringstream(words[1]) >> selectedToryDst) &&
+		if (ReadTerritoryID(words[0], selectedTorySrc) &&
+			ReadTerritoryID(words[1], selectedToryDst) &&
 			(std::stringstream(words[2]) >> armiesToAirlift))
 		{
 			Territory* src = nullptr;
@@ -714,7 +849,7 @@ void HumanPlayerStrategy::PlayingDiplomacyCard()
 
 	Command* userCommand = nullptr;
 
-	GameEngine* gameInstance = currentPlayer->getCurrentGameInstance();
+	GameContext* gameInstance = currentPlayer->getGameContext();
 	if (gameInstance == nullptr)
 	{
 		return;
@@ -726,7 +861,7 @@ void HumanPlayerStrategy::PlayingDiplomacyCard()
 	{
 		if (currentPlayers[i] != nullptr)
 		{
-			std::cout << i << " : " << currentPlayers[i]->getPlayerName() << std::endl;
+			std::cout << i << " : " << currentPlayers[i]->getPlayerNameView() << std::endl;
 		}
 	}
 
@@ -744,7 +879,14 @@ void HumanPlayerStrategy::PlayingDiplomacyCard()
 
 	if (words.size() == 1)
 	{
-		if ((std::stringstream(words[0]) >> selectedPlayer))
+		// a player can also be picked by name
+		Player* namedPlayer = gameInstance->findPlayer(words[0]);
+		if (namedPlayer != nullptr)
+		{
+			selectedPlayer = static_cast<int>(std::find(currentPlayers.begin(), currentPlayers.end(), namedPlayer) - currentPlayers.begin());
+		}
+
+		if (namedPlayer != nullptr || (std::stringstream(words[0]) >> selectedPlayer))
 		{
 			if (selectedPlayer >= 0 && selectedPlayer < currentPlayers.size())
 			{
@@ -784,7 +926,7 @@ void HumanPlayerStrategy::DisplayPlayerToriesToDefendAndAttack()
 	toriesToDefendAndAttack.insert(toriesToDefendAndAttack.end(), plToriesToDefend.begin(), plToriesToDefend.end());
 	toriesToDefendAndAttack.insert(toriesToDefendAndAttack.end(), plToriesToAttack.begin(), plToriesToAttack.end());
 
-	std::cout << "Displaying " << currentPlayer->getPlayerName() << "'s Territories to Defend & Attack." << std::endl;
+	std::cout << "Displaying " << currentPlayer->getPlayerNameView() << "'s Territories to Defend & Attack." << std::endl;
 	std::cout << std::setfill('*') << std::setw(50) << "" << std::endl;
 	std::cout << std::setfill(' ') << "* Territory #:  " << std::setw(10) << " Territory Name " << std::setw(15) << "# of Armies" << std::endl;
 	std::cout << std::setfill('*') << std::setw(50) << "" << std::endl;
@@ -793,7 +935,7 @@ void HumanPlayerStrategy::DisplayPlayerToriesToDefendAndAttack()
 	{
 		if (toriesToDefendAndAttack[i] != nullptr)
 		{
-			std::cout << toriesToDefendAndAttack[i]->getID() << std::setw(5 - std::to_string(i).size()) << " : " << std::setw(40) << toriesToDefendAndAttack[i]->getName() << " : " << toriesToDefendAndAttack[i]->getNbArmy() << std::endl;
+			std::cout << toriesToDefendAndAttack[i]->getID() << std::setw(5 - std::to_string(i).size()) << " : " << std::setw(40) << toriesToDefendAndAttack[i]->getNameView() << " : " << toriesToDefendAndAttack[i]->getNbArmy() << std::endl;
 		}
 		else
 		{
@@ -803,7 +945,7 @@ void HumanPlayerStrategy::DisplayPlayerToriesToDefendAndAttack()
 
 	std::cout << std::endl;
 
-	std::cout << "Displaying " << currentPlayer->getPlayerName() << "'s Territories to Attack." << std::endl;
+	std::cout << "Displaying " << currentPlayer->getPlayerNameView() << "'s Territories to Attack." << std::endl;
 	std::cout << std::setfill('*') << std::setw(50) << "" << std::endl;
 	std::cout << std::setfill(' ') << "* Territory #:  " << std::setw(10) << " Territory Name " << std::setw(15) << "# of Armies" << std::endl;
 	std::cout << std::setfill('*') << std::setw(50) << "" << std::endl;
@@ -813,7 +955,7 @@ void HumanPlayerStrategy::DisplayPlayerToriesToDefendAndAttack()
 	{
 		if (toriesToDefendAndAttack[i] != nullptr)
 		{
-			std::cout << toriesToDefendAndAttack[i]->getID() << std::setw(5 - std::to_string(i).size()) << " : " << std::setw(40) << toriesToDefendAndAttack[i]->getName() << " : " << toriesToDefendAndAttack[i]->getNbArmy() << std::endl;
+			std::cout << toriesToDefendAndAttack[i]->getID() << std::setw(5 - std::to_string(i).size()) << " : " << std::setw(40) << toriesToDefendAndAttack[i]->getNameView() << " : " << toriesToDefendAndAttack[i]->getNbArmy() << std::endl;
 		}
 		else
 		{
@@ -840,7 +982,7 @@ void HumanPlayerStrategy::DisplayToriesToDefendAndAdjacents()
 	{
 		if (plToriesToDefend[i] != nullptr)
 		{
-			std::cout << "{ID:" << plToriesToDefend[i]->getID() << "}" << plToriesToDefend[i]->getName()
+			std::cout << "{ID:" << plToriesToDefend[i]->getID() << "}" << plToriesToDefend[i]->getNameView()
 				<< "(units:" << plToriesToDefend[i]->getNbArmy() << "): " << std::endl;
 
 			std::vector<Territory*> allies;
@@ -870,11 +1012,11 @@ void HumanPlayerStrategy::DisplayToriesToDefendAndAdjacents()
 			// display the result in a informative format
 			if (allies.size() > 0)
 			{
-				std::cout << "\t\t[" << currentPlayer->getPlayerName() << ":";
+				std::cout << "\t\t[" << currentPlayer->getPlayerNameView() << ":";
 				int count = 0;
 				for (auto& allyTory : allies)
 				{
-					std::cout << "{ID:" << allyTory->getID() << "}:" << allyTory->getName() << "(units:"
+					std::cout << "{ID:" << allyTory->getID() << "}:" << allyTory->getNameView() << "(units:"
 						<< allyTory->getNbArmy() << ")";
 					if (count < allies.size() - 1)
 					{
@@ -902,7 +1044,7 @@ void HumanPlayerStrategy::DisplayToriesToDefendAndAdjacents()
 					{
 						if (enemyTory != nullptr)
 						{
-							std::cout << "{ID:" << enemyTory->getID() << "}:" << enemyTory->getName()
+							std::cout << "{ID:" << enemyTory->getID() << "}:" << enemyTory->getNameView()
 								<< "(units:" << enemyTory->getNbArmy() << ")";
 							if (enemyToryCount < value.size() - 1)
 							{
@@ -933,7 +1075,7 @@ void HumanPlayerStrategy::DisplayPlayerToriesToAttack()
 
 	const std::vector<Territory*> plToriesToAttack = currentPlayer->getTerritoriesToAttack();
 
-	std::cout << "Displaying Territories " << currentPlayer->getPlayerName() << " can Attack." << std::endl;
+	std::cout << "Displaying Territories " << currentPlayer->getPlayerNameView() << " can Attack." << std::endl;
 	std::cout << std::setfill('*') << std::setw(50) << "" << std::endl;
 	std::cout << std::setfill(' ') << "* Territory #:  " << std::setw(10) << " Territory Name " << std::setw(15) << "# of Armies" << std::endl;
 	std::cout << std::setfill('*') << std::setw(50) << "" << std::endl;
@@ -943,7 +1085,7 @@ void HumanPlayerStrategy::DisplayPlayerToriesToAttack()
 	{
 		if (plToriesToAttack[i] != nullptr)
 		{
-			std::cout << plToriesToAttack[i]->getID() << std::setw(5 - std::to_string(i).size()) << " : " << std::setw(40) << plToriesToAttack[i]->getName() << " : " << plToriesToAttack[i]->getNbArmy() << std::endl;
+			std::cout << plToriesToAttack[i]->getID() << std::setw(5 - std::to_string(i).size()) << " : " << std::setw(40) << plToriesToAttack[i]->getNameView() << " : " << plToriesToAttack[i]->getNbArmy() << std::endl;
 		}
 		else
 		{
@@ -965,7 +1107,7 @@ void HumanPlayerStrategy::DisplayPlayerToriesToDefend()
 	const std::vector<Territory*> plToriesToDefend = currentPlayer->getTerritoriesToDefend();
 
 	//std::cout << std::endl;
-	std::cout << "Displaying " << currentPlayer->getPlayerName() << "'s Territories to Defend." << std::endl;
+	std::cout << "Displaying " << currentPlayer->getPlayerNameView() << "'s Territories to Defend." << std::endl;
 	std::cout << std::setfill('*') << std::setw(100) << "" << std::endl;
 	std::cout << std::setfill(' ') << "* Territory #:  " << std::setw(10) << " Territory Name "
 		<< std::setw(15) << "# of Armies" << std::setw(5) << "Adjacent Enemy Territories" << std::endl;
@@ -976,7 +1118,7 @@ void HumanPlayerStrategy::DisplayPlayerToriesToDefend()
 		if (plToriesToDefend[i] != nullptr)
 		{
 			std::cout << plToriesToDefend[i]->getID() << std::setw(5 - std::to_string(i).size()) << " : "
-				<< plToriesToDefend[i]->getName() << " : " << plToriesToDefend[i]->getNbArmy()
+				<< plToriesToDefend[i]->getNameView() << " : " << plToriesToDefend[i]->getNbArmy()
 				<< std::endl;
 
 			std::map<int, std::vector<Territory*>> neighbourPlTories;
@@ -1001,11 +1143,11 @@ void HumanPlayerStrategy::DisplayPlayerToriesToDefend()
 			for (const auto& [key, value] : neighbourPlTories)
 			{
 				std::cout << std::setw(35);
-				std::cout << value[0]->getPlayer()->getPlayerName() << ":" << std::endl;
+				std::cout << value[0]->getPlayer()->getPlayerNameView() << ":" << std::endl;
 				for (const auto& tory : value)
 				{
 					std::cout << std::setw(35 + tory->getName().size());
-					std::cout << tory->getName() << "(" << tory->getNbArmy() << ")" << std::endl;
+					std::cout << tory->getNameView() << "(" << tory->getNbArmy() << ")" << std::endl;
 				}
 			}
 		}
@@ -1037,6 +1179,30 @@ std::string HumanPlayerStrategy::GetUserInput(Command*& userCommand)
 	return userCommand->getCommand();
 }
 
+bool HumanPlayerStrategy::ReadTerritoryID(const std::string& inWord, int& outID) const
+{
+	if (std::stringstream(inWord) >> outID)
+	{
+		return true;
+	}
+
+	Player* currentPlayer = getPlayer();
+	if (currentPlayer == nullptr || currentPlayer->getTerritoriesOwned().empty())
+	{
+		return false;
+	}
+
+	Map* map = currentPlayer->getTerritoriesOwned()[0]->getMap();
+	Territory* named = map != nullptr ? map->findTerritory(inWord) : nullptr;
+	if (named == nullptr)
+	{
+		return false;
+	}
+
+	outID = named->getID();
+	return true;
+}
+
 /*
 	******************************************
 	***** AI Controlled Players Below!!! *****
@@ -1058,8 +1224,8 @@ void AggressivePlayerStrategy::issueOrder()
 	// Get territories to defend in order of priority
 	const std::vector<Territory*> plToriesToDefend = currentPlayer->getTerritoriesToDefend();
 
-	std::cout << "Issuing orders for " << currentPlayer->getPlayerName() << "\n";
-	std::cout << "They are a CPU! " << std::endl;
+	GetOutput() << "Issuing orders for " << currentPlayer->getPlayerNameView() << "\n";
+	GetOutput() << "They are a CPU! \n";
 
 	currentPlayer->setPlayerTurnPhase(EPlayerTurnPhase::DeployingArmies);
 	int availableReserves = currentPlayer->getReinforcementPoolSize();
@@ -1079,7 +1245,7 @@ void AggressivePlayerStrategy::issueOrder()
 			PlayingCards();
 			break;
 		case EPlayerTurnPhase::EndOfTurn:
-			std::cout << "End of " << currentPlayer->getPlayerName() << "'s turn" << std::endl;
+			GetOutput() << "End of " << currentPlayer->getPlayerNameView() << "'s turn\n";
 			break;
 		default:
 			currentPlayer->setPlayerTurnPhase(EPlayerTurnPhase::EndOfTurn);
@@ -1103,38 +1269,8 @@ void AggressivePlayerStrategy::toAttack()
 	// toAttack will turn a list of all adjacent enemy territories, in order of territories with the least troops
 	std::vector<Territory*> enemyTerritoryByPriority;
 
-	const std::vector<Territory*> allCurrentPlayerTerritories = currentPlayer->getTerritoriesOwned();
-
 	// loop through all territories adjacent 
-	for (auto& ownedTerritory : allCurrentPlayerTerritories)
-	{
-		if (ownedTerritory != nullptr)
-		{
-			for (auto& adjacentTerritory : ownedTerritory->getBorderList())
-			{
-				if (adjacentTerritory->getPlayer() == nullptr)
-				{
-					std::cout << "Warning! Territory has no owner!" << std::endl;
-					continue;
-				}
-
-				if (adjacentTerritory->getPlayer()->getPlayerID() != currentPlayer->getPlayerID())
-				{
-					// making sure no dupes
-					if (enemyTerritoryByPriority.empty() ||
-						std::find
-						(
-							enemyTerritoryByPriority.begin(),
-							enemyTerritoryByPriority.end(),
-							adjacentTerritory
-						) == enemyTerritoryByPriority.end())
-					{
-						enemyTerritoryByPriority.push_back(adjacentTerritory);
-					}
-				}
-			}
-		}
-	}
+	GatherAdjacentEnemies(currentPlayer, enemyTerritoryByPriority);
 
 	std::sort(enemyTerritoryByPriority.begin(), enemyTerritoryByPriority.end(), Utilities::SortByArmyAscendingSize);
 
@@ -1209,7 +1345,10 @@ void AggressivePlayerStrategy::DeployArmies(int& inAvailableReserves)
 
 		enemyThreat = std::max(0, enemyThreat - currentPlayer->getTerritoriesToDefend()[index]->getNbArmy());
 
-		int numToDeploy = std::max(0, std::min(totalAvailableReserves, std::max(5, 2 + enemyAdjTories + enemyThreat)));
+		// a threatened chokepoint holds a whole region, it gets more than its neighbourhood alone asks for
+		const int chokepointBonus = enemyAdjTories > 0 ? 2 * GetDefensePriority(currentPlayer->getTerritoriesToDefend()[index]) : 0;
+
+		int numToDeploy = std::max(0, std::min(totalAvailableReserves, std::max(5, 2 + enemyAdjTories + enemyThreat + chokepointBonus)));
 
 		currentPlayer->IssueDeployOrder(
 			currentPlayer->getTerritoriesToDefend()[index],
@@ -1253,11 +1392,15 @@ void AggressivePlayerStrategy::AdvanceArmies()
 				}
 			}
 
-			// if there's no enemy then just move troops to territory with the most armies
+			// if there's no enemy then march towards the main target, or to the territory with the most armies
 			if (!enemyfound)
 			{
 				Territory* dst = nullptr;
-				if (adjacents.size() > 0)
+				if (!currentPlayer->getTerritoriesToAttack().empty())
+				{
+					dst = FindClosestTo(adjacents, currentPlayer->getTerritoriesToAttack()[0]);
+				}
+				if (dst == nullptr && adjacents.size() > 0)
 				{
 					dst = adjacents[adjacents.size() - 1];
 				}
@@ -1288,10 +1431,7 @@ void AggressivePlayerStrategy::PlayingCards()
 	if (currentPlayer->getCurrentHand()->getHand().size() > 0)
 	{
 		Hand* hand = currentPlayer->getCurrentHand();
-		auto randomClock = std::chrono::high_resolution_clock::now();
-		auto seed = randomClock.time_since_epoch().count();
-		auto randomizer = std::default_random_engine(seed);
-		std::shuffle(hand->getHand().begin(), hand->getHand().end(), randomizer);
+		currentPlayer->getRandom().getStream(ERandomStream::Strategy).shuffle(hand->getHand().begin(), hand->getHand().end());
 
 		Card* card = hand->drawCard_Hand();
 
@@ -1310,7 +1450,7 @@ void AggressivePlayerStrategy::PlayingCards()
 			PlayingDiplomacyCard();
 			break;
 		default:
-			std::cout << "Invalid card" << std::endl;
+			GetOutput() << "Invalid card\n";
 			break;
 		}
 
@@ -1398,33 +1538,34 @@ void AggressivePlayerStrategy::PlayingAirliftCard()
 
 	// find all territories that aren't on the border
 	std::vector<Territory*> innerTories;
+	GatherInteriorTerritories(currentPlayer, innerTories);
 
-	const std::vector<Territory*> plTories = currentPlayer->getTerritoriesOwned();
 	const std::vector<Territory*> plToriesToDefend = currentPlayer->getTerritoriesToDefend();
 
-	for (const auto& tory : plTories)
+	std::sort(innerTories.begin(), innerTories.end(), Utilities::SortByArmySize);
+
+	if (innerTories.size() > 0 && plToriesToDefend.size() > 0)
 	{
-		bool isInner = true;
-		for (const auto& adjTory : tory->getBorderList())
+		// the airlift is worth the most where it saves the most army moves:
+		// armies times the borders they would otherwise have to cross
+		Territory* source = innerTories[0];
+		Map* map = plToriesToDefend[0]->getMap();
+		if (map != nullptr)
 		{
-			if (adjTory->getPlayer() != currentPlayer)
+			long long bestSaving = -1;
+			for (const auto& tory : innerTories)
 			{
-				isInner = false;
-				break;
+				const int32 hops = map->distance(tory, plToriesToDefend[0]);
+				const long long saving = static_cast<long long>(tory->getNbArmy()) * (hops == MapDistanceIndex::Unreachable ? 0 : hops);
+				if (saving > bestSaving)
+				{
+					bestSaving = saving;
+					source = tory;
+				}
 			}
 		}
 
-		if (isInner)
-		{
-			innerTories.push_back(tory);
-		}
-	}
-
-	std::sort(innerTories.begin(), innerTories.end(), Utilities::SortByArmySize);
-
-	if (innerTories.size() > 0 && plToriesToDefend.size() > 0)
-	{
-		currentPlayer->IssueAirliftOrder(innerTories[0], plToriesToDefend[0], innerTories[0]->getNbArmy());
+		currentPlayer->IssueAirliftOrder(source, plToriesToDefend[0], source->getNbArmy());
 	}
 }
 
@@ -1439,12 +1580,12 @@ void AggressivePlayerStrategy::PlayingDiplomacyCard()
 	// Wants to NAP the most threatening player
 	const std::vector<Territory*> plToriesToAttack = currentPlayer->getTerritoriesToAttack();
 
-	if (currentPlayer->getCurrentGameInstance() == nullptr)
+	if (currentPlayer->getGameContext() == nullptr)
 	{
 		return;
 	}
 
-	std::vector<Player*> allPlayers = currentPlayer->getCurrentGameInstance()->getPlayerList();
+	std::vector<Player*> allPlayers = currentPlayer->getGameContext()->getPlayerList();
 
 	std::map<Player*, int> otherPlayers;
 
@@ -1468,9 +1609,13 @@ void AggressivePlayerStrategy::PlayingDiplomacyCard()
 		sortedPlayers.push_back(std::pair<int, Player*>(value, key));
 	}
 
-	// descending order
+	// descending order, ties go to the player that joined first so the choice does not hang on where players were allocated
 	std::sort(sortedPlayers.begin(), sortedPlayers.end(), [=](std::pair<int, Player*>& a, std::pair<int, Player*>& b) {
-		return a.first > b.first;
+		if (a.first != b.first)
+		{
+			return a.first > b.first;
+		}
+		return a.second->getPlayerID() < b.second->getPlayerID();
 	});
 
 	if (sortedPlayers.size() > 0)
@@ -1495,8 +1640,8 @@ void BenevolentPlayerStrategy::issueOrder()
 	// Get territories to defend in order of priority
 	const std::vector<Territory*> plToriesToDefend = currentPlayer->getTerritoriesToDefend();
 
-	std::cout << "Issuing orders for " << currentPlayer->getPlayerName() << "\n";
-	std::cout << "They are a CPU! " << std::endl;
+	GetOutput() << "Issuing orders for " << currentPlayer->getPlayerNameView() << "\n";
+	GetOutput() << "They are a CPU! \n";
 
 	currentPlayer->setPlayerTurnPhase(EPlayerTurnPhase::DeployingArmies);
 	int availableReserves = currentPlayer->getReinforcementPoolSize();
@@ -1516,7 +1661,7 @@ void BenevolentPlayerStrategy::issueOrder()
 			PlayingCards();
 			break;
 		case EPlayerTurnPhase::EndOfTurn:
-			std::cout << "End of " << currentPlayer->getPlayerName() << "'s turn" << std::endl;
+			GetOutput() << "End of " << currentPlayer->getPlayerNameView() << "'s turn\n";
 			break;
 		default:
 			currentPlayer->setPlayerTurnPhase(EPlayerTurnPhase::EndOfTurn);
@@ -1539,7 +1684,7 @@ void BenevolentPlayerStrategy::toAttack()
 void BenevolentPlayerStrategy::toDefend()
 {
 	/*
-		Benevolent player will prioritize territories with the least troops to deploy troops
+		Benevolent player will prioritize the chokepoints of the map, then territories with the least troops to deploy troops
 	*/
 	Player* currentPlayer = getPlayer();
 	if (currentPlayer == nullptr)
@@ -1551,12 +1696,17 @@ void BenevolentPlayerStrategy::toDefend()
 
 	std::vector<Territory*> plToriesSorted;
 	plToriesSorted.insert(plToriesSorted.begin(), currentPlayerTories.begin(), currentPlayerTories.end());
-	// sorts player's territories in ascending order by troop numbers
-	std::sort(plToriesSorted.begin(), plToriesSorted.end(), Utilities::SortByArmyAscendingSize);
+	// sorts player's territories by chokepoint weight, then in ascending order by troop numbers
+	std::sort(plToriesSorted.begin(), plToriesSorted.end(), [this](const Territory* lhs, const Territory* rhs)
+	{
+		const int32 lhsPriority = GetDefensePriority(lhs);
+		const int32 rhsPriority = GetDefensePriority(rhs);
+		return lhsPriority != rhsPriority ? lhsPriority > rhsPriority : Utilities::SortByArmyAscendingSize(lhs, rhs);
+	});
 
 	currentPlayer->getTerritoriesToDefend().clear();
 	currentPlayer->getTerritoriesToDefend().insert(
-		currentPlayer->getTerritoriesToDefend().begin(), currentPlayerTories.begin(), currentPlayerTories.end()
+		currentPlayer->getTerritoriesToDefend().begin(), plToriesSorted.begin(), plToriesSorted.end()
 	);
 }
 
@@ -1696,10 +1846,7 @@ void BenevolentPlayerStrategy::PlayingCards()
 	if (currentPlayer->getCurrentHand()->getHand().size() > 0)
 	{
 		Hand* hand = currentPlayer->getCurrentHand();
-		auto randomClock = std::chrono::high_resolution_clock::now();
-		auto seed = randomClock.time_since_epoch().count();
-		auto randomizer = std::default_random_engine(seed);
-		std::shuffle(hand->getHand().begin(), hand->getHand().end(), randomizer);
+		currentPlayer->getRandom().getStream(ERandomStream::Strategy).shuffle(hand->getHand().begin(), hand->getHand().end());
 
 		Card* card = hand->drawCard_Hand();
 
@@ -1718,7 +1865,7 @@ void BenevolentPlayerStrategy::PlayingCards()
 			PlayingDiplomacyCard();
 			break;
 		default:
-			std::cout << "Invalid card" << std::endl;
+			GetOutput() << "Invalid card\n";
 			break;
 		}
 
@@ -1807,28 +1954,10 @@ void BenevolentPlayerStrategy::PlayingAirliftCard()
 	// defencive player will move troops to shore up the weakest part of the border
 	// find all territories that aren't on the border
 	std::vector<Territory*> innerTories;
+	GatherInteriorTerritories(currentPlayer, innerTories);
 
-	const std::vector<Territory*> plTories = currentPlayer->getTerritoriesOwned();
 	const std::vector<Territory*> plToriesToDefend = currentPlayer->getTerritoriesToDefend();
 
-	for (const auto& tory : plTories)
-	{
-		bool isInner = true;
-		for (const auto& adjTory : tory->getBorderList())
-		{
-			if (adjTory->getPlayer() != currentPlayer)
-			{
-				isInner = false;
-				break;
-			}
-		}
-
-		if (isInner)
-		{
-			innerTories.push_back(tory);
-		}
-	}
-
 	std::sort(innerTories.begin(), innerTories.end(), Utilities::SortByArmyAscendingSize);
 
 	if (innerTories.size() > 0 && plToriesToDefend.size() > 0)
@@ -1848,12 +1977,12 @@ void BenevolentPlayerStrategy::PlayingDiplomacyCard()
 	// Wants to NAP the most threatening player
 	const std::vector<Territory*> plToriesToAttack = currentPlayer->getTerritoriesToAttack();
 
-	if (currentPlayer->getCurrentGameInstance() == nullptr)
+	if (currentPlayer->getGameContext() == nullptr)
 	{
 		return;
 	}
 
-	std::vector<Player*> allPlayers = currentPlayer->getCurrentGameInstance()->getPlayerList();
+	std::vector<Player*> allPlayers = currentPlayer->getGameContext()->getPlayerList();
 
 	std::map<Player*, int> otherPlayers;
 
@@ -1877,9 +2006,13 @@ void BenevolentPlayerStrategy::PlayingDiplomacyCard()
 		sortedPlayers.push_back(std::pair<int, Player*>(value, key));
 	}
 
-	// descending order
+	// descending order, ties go to the player that joined first so the choice does not hang on where players were allocated
 	std::sort(sortedPlayers.begin(), sortedPlayers.end(), [=](std::pair<int, Player*>& a, std::pair<int, Player*>& b) {
-		return a.first > b.first;
+		if (a.first != b.first)
+		{
+			return a.first > b.first;
+		}
+		return a.second->getPlayerID() < b.second->getPlayerID();
 	});
 
 	if (sortedPlayers.size() > 0)
@@ -1904,8 +2037,8 @@ void NeutralPlayerStrategy::issueOrder()
 	// Get territories to defend in order of priority
 	const std::vector<Territory*> plToriesToDefend = currentPlayer->getTerritoriesToDefend();
 
-	std::cout << "Issuing orders for " << currentPlayer->getPlayerName() << "\n";
-	std::cout << "They are a Neutral CPU and will do nothing unless attacked!" << std::endl;
+	GetOutput() << "Issuing orders for " << currentPlayer->getPlayerNameView() << "\n";
+	GetOutput() << "They are a Neutral CPU and will do nothing unless attacked!\n";
 
 	currentPlayer->setPlayerTurnPhase(EPlayerTurnPhase::DeployingArmies);
 	int availableReserves = currentPlayer->getReinforcementPoolSize();
@@ -1924,7 +2057,7 @@ void NeutralPlayerStrategy::issueOrder()
 			PlayingCards();
 			break;
 		case EPlayerTurnPhase::EndOfTurn:
-			std::cout << "End of " << currentPlayer->getPlayerName() << "'s turn" << std::endl;
+			GetOutput() << "End of " << currentPlayer->getPlayerNameView() << "'s turn\n";
 			break;
 		default:
 			currentPlayer->setPlayerTurnPhase(EPlayerTurnPhase::EndOfTurn);
@@ -2060,12 +2193,12 @@ void CheaterPlayerStrategy::issueOrder()
 			tory->setPlayer(currentPlayer);
 			currentPlayer->getTerritoriesOwned().push_back(tory);
 
-			std::cout << currentPlayer->getPlayerName() << " is a cheater! They have stolen " << tory->getName()
-				<< "!" << std::endl;
+			GetOutput() << currentPlayer->getPlayerNameView() << " is a cheater! They have stolen " << tory->getNameView()
+				<< "!\n";
 		}
 		else
 		{
-			std::cout << "error, territory not found to remove" << std::endl;
+			GetOutput() << "error, territory not found to remove\n";
 		}
 	}
 
@@ -2078,8 +2211,8 @@ void CheaterPlayerStrategy::issueOrder()
 	// Get territories to defend in order of priority
 	const std::vector<Territory*> plToriesToDefend = currentPlayer->getTerritoriesToDefend();
 
-	std::cout << "Issuing orders for " << currentPlayer->getPlayerName() << "\n";
-	std::cout << "They are a CPU! " << std::endl;
+	GetOutput() << "Issuing orders for " << currentPlayer->getPlayerNameView() << "\n";
+	GetOutput() << "They are a CPU! \n";
 
 	currentPlayer->setPlayerTurnPhase(EPlayerTurnPhase::DeployingArmies);
 	int availableReserves = currentPlayer->getReinforcementPoolSize();
@@ -2098,7 +2231,7 @@ void CheaterPlayerStrategy::issueOrder()
 			PlayingCards();
 			break;
 		case EPlayerTurnPhase::EndOfTurn:
-			std::cout << "End of " << currentPlayer->getPlayerName() << "'s turn" << std::endl;
+			GetOutput() << "End of " << currentPlayer->getPlayerNameView() << "'s turn\n";
 			break;
 		default:
 			currentPlayer->setPlayerTurnPhase(EPlayerTurnPhase::EndOfTurn);
@@ -2122,38 +2255,8 @@ void CheaterPlayerStrategy::toAttack()
 	// toAttack will turn a list of all adjacent enemy territories, in order of territories with the least troops
 	std::vector<Territory*> enemyTerritoryByPriority;
 
-	const std::vector<Territory*> allCurrentPlayerTerritories = currentPlayer->getTerritoriesOwned();
-
 	// loop through all territories adjacent 
-	for (auto& ownedTerritory : allCurrentPlayerTerritories)
-	{
-		if (ownedTerritory != nullptr)
-		{
-			for (auto& adjacentTerritory : ownedTerritory->getBorderList())
-			{
-				if (adjacentTerritory->getPlayer() == nullptr)
-				{
-					std::cout << "Warning! Territory has no owner!" << std::endl;
-					continue;
-				}
-
-				if (adjacentTerritory->getPlayer()->getPlayerID() != currentPlayer->getPlayerID())
-				{
-					// making sure no dupes
-					if (enemyTerritoryByPriority.empty() ||
-						std::find
-						(
-							enemyTerritoryByPriority.begin(),
-							enemyTerritoryByPriority.end(),
-							adjacentTerritory
-						) == enemyTerritoryByPriority.end())
-					{
-						enemyTerritoryByPriority.push_back(adjacentTerritory);
-					}
-				}
-			}
-		}
-	}
+	GatherAdjacentEnemies(currentPlayer, enemyTerritoryByPriority);
 
 	std::sort(enemyTerritoryByPriority.begin(), enemyTerritoryByPriority.end(), Utilities::SortByArmyAscendingSize);
 
@@ -2240,11 +2343,15 @@ void CheaterPlayerStrategy::AdvanceArmies()
 				}
 			}
 
-			// if there's no enemy then just move troops to territory with the most armies
+			// if there's no enemy then march towards the main target, or to the territory with the most armies
 			if (!enemyfound)
 			{
 				Territory* dst = nullptr;
-				if (adjacents.size() > 0)
+				if (!currentPlayer->getTerritoriesToAttack().empty())
+				{
+					dst = FindClosestTo(adjacents, currentPlayer->getTerritoriesToAttack()[0]);
+				}
+				if (dst == nullptr && adjacents.size() > 0)
 				{
 					dst = adjacents[adjacents.size() - 1];
 				}
@@ -2277,10 +2384,7 @@ void CheaterPlayerStrategy::PlayingCards()
 	if (currentPlayer->getCurrentHand()->getHand().size() > 0)
 	{
 		Hand* hand = currentPlayer->getCurrentHand();
-		auto randomClock = std::chrono::high_resolution_clock::now();
-		auto seed = randomClock.time_since_epoch().count();
-		auto randomizer = std::default_random_engine(seed);
-		std::shuffle(hand->getHand().begin(), hand->getHand().end(), randomizer);
+		currentPlayer->getRandom().getStream(ERandomStream::Strategy).shuffle(hand->getHand().begin(), hand->getHand().end());
 
 		Card* card = hand->drawCard_Hand();
 
@@ -2299,7 +2403,7 @@ void CheaterPlayerStrategy::PlayingCards()
 			PlayingDiplomacyCard();
 			break;
 		default:
-			std::cout << "Invalid card" << std::endl;
+			GetOutput() << "Invalid card\n";
 			break;
 		}
 
@@ -2388,28 +2492,10 @@ void CheaterPlayerStrategy::PlayingAirliftCard()
 
 	// find all territories that aren't on the border
 	std::vector<Territory*> innerTories;
+	GatherInteriorTerritories(currentPlayer, innerTories);
 
-	const std::vector<Territory*> plTories = currentPlayer->getTerritoriesOwned();
 	const std::vector<Territory*> plToriesToDefend = currentPlayer->getTerritoriesToDefend();
 
-	for (const auto& tory : plTories)
-	{
-		bool isInner = true;
-		for (const auto& adjTory : tory->getBorderList())
-		{
-			if (adjTory->getPlayer() != currentPlayer)
-			{
-				isInner = false;
-				break;
-			}
-		}
-
-		if (isInner)
-		{
-			innerTories.push_back(tory);
-		}
-	}
-
 	std::sort(innerTories.begin(), innerTories.end(), Utilities::SortByArmySize);
 
 	if (innerTories.size() > 0 && plToriesToDefend.size() > 0)
@@ -2429,12 +2515,12 @@ void CheaterPlayerStrategy::PlayingDiplomacyCard()
 	// Wants to NAP the most threatening player
 	const std::vector<Territory*> plToriesToAttack = currentPlayer->getTerritoriesToAttack();
 
-	if (currentPlayer->getCurrentGameInstance() == nullptr)
+	if (currentPlayer->getGameContext() == nullptr)
 	{
 		return;
 	}
 
-	std::vector<Player*> allPlayers = currentPlayer->getCurrentGameInstance()->getPlayerList();
+	std::vector<Player*> allPlayers = currentPlayer->getGameContext()->getPlayerList();
 
 	std::map<Player*, int> otherPlayers;
 
@@ -2458,9 +2544,13 @@ void CheaterPlayerStrategy::PlayingDiplomacyCard()
 		sortedPlayers.push_back(std::pair<int, Player*>(value, key));
 	}
 
-	// descending order
+	// descending order, ties go to the player that joined first so the choice does not hang on where players were allocated
 	std::sort(sortedPlayers.begin(), sortedPlayers.end(), [=](std::pair<int, Player*>& a, std::pair<int, Player*>& b) {
-		return a.first > b.first;
+		if (a.first != b.first)
+		{
+			return a.first > b.first;
+		}
+		return a.second->getPlayerID() < b.second->getPlayerID();
 	});
 
 	if (sortedPlayers.size() > 0)
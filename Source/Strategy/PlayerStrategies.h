@@ -1,5 +1,10 @@
 #pragma once
+#include <iostream>
 #include <string>
+#include <vector>
+
+#include "Common/BitSet.h"
+#include "Common/CommonTypes.h"
 
 // PlayerStrategies class
 enum class EPlayerStrategy {
@@ -11,6 +16,7 @@ enum class EPlayerStrategy {
 };
 
 class Player;
+class Territory;
 class Command;
 class CommandProcessor;
 
@@ -33,9 +39,23 @@ protected:
 
 	virtual void HandleSaveEffect(Command* inCommand, std::string inMsg);
 
+	// collects every enemy territory bordering the territories of inPlayer, each listed once
+	void GatherAdjacentEnemies(Player* inPlayer, std::vector<Territory*>& outEnemies) const;
+	// collects the territories of inPlayer whose neighbours all belong to inPlayer
+	void GatherInteriorTerritories(Player* inPlayer, std::vector<Territory*>& outInterior) const;
+	// the territory of inCandidates the fewest borders away from inGoal, nullptr when none can reach it
+	Territory* FindClosestTo(const std::vector<Territory*>& inCandidates, Territory* inGoal) const;
+	// weight of inTerritory as a chokepoint of its map, see MapChokepointIndex::getDefensePriority. 0 without an index.
+	int32 GetDefensePriority(const Territory* inTerritory) const;
+	// narration of the game of the player, see GameContext::getOutput
+	std::ostream& GetOutput() const;
+
 	Player* _player = nullptr;
 	CommandProcessor* commandProcess = nullptr;
 private:
+	// territories GatherAdjacentEnemies already listed, by dense index. Kept between calls and
+	// cleared bit by bit so a call costs the borders it looks at, not the size of the map.
+	mutable BitSet _listedEnemies;
 };
 
 class HumanPlayerStrategy : public PlayerStrategies {
@@ -64,6 +84,8 @@ private:
 	void DisplayPlayerToriesToAttack();
 
 	std::string GetUserInput(Command*& userCommand);
+	// reads a territory id, or the name of a territory of the player's map
+	bool ReadTerritoryID(const std::string& inWord, int& outID) const;
 };
 
 /*